@@ -0,0 +1,74 @@
+#pragma once
+
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <type_traits>
+
+#include <ogf/types.hxx>
+
+namespace ogf {
+
+    // Ring of per-frame memory in one big buffer for data which changes with every draw, e.g. transforms or material
+    // constants. Each frame writes its data linearly into its own part of the buffer and binds it to uniform or shader
+    // storage block binding points as buffer ranges, so a draw costs a copy and a bind instead of many glUniform calls.
+    // The buffer is mapped persistently when the context supports buffer storage (OpenGL 4.4 or ARB_buffer_storage),
+    // otherwise the data is staged in memory and uploaded when it's bound. Fences keep frames from overwriting data the
+    // GPU may still be reading.
+    class BufferRing {
+    public:
+        // Part of the current frame's memory. Data is write-only and has to be written before it's bound.
+        struct Allocation {
+            Uint8*      data{nullptr};
+            std::size_t offset{};
+            std::size_t size{};
+        };
+
+        // Create a buffer with frame_size bytes for each of the frames in flight.
+        explicit BufferRing(const std::size_t frame_size = 4 * 1024 * 1024, const unsigned int frames = 3);
+
+        // Waits for the GPU to finish reading the buffer. Must be destroyed with the GL context still current.
+        ~BufferRing();
+
+        BufferRing(const BufferRing&) = delete;
+        BufferRing& operator=(const BufferRing&) = delete;
+
+        // Reserve memory in the current frame, aligned as both uniform and storage buffer ranges need. Throws
+        // std::runtime_error if the frame has no space left.
+        Allocation allocate(const std::size_t size);
+
+        // Reserve memory and copy a value into it.
+        template<typename T>
+        Allocation push(const T& value);
+
+        // Bind an allocation to a uniform or shader storage block binding point. Storage blocks need OpenGL 4.3 or
+        // ARB_shader_storage_buffer_object.
+        void bind_uniform(const unsigned int binding, const Allocation& allocation);
+        void bind_storage(const unsigned int binding, const Allocation& allocation);
+
+        // End the current frame after its last draw and start the next one. Waits if the GPU is still reading the
+        // memory the next frame reuses.
+        void next_frame();
+
+        // Bytes allocated in the current frame, including alignment padding.
+        std::size_t frame_usage() const noexcept;
+
+        // Get the underlying OpenGL handle of the buffer.
+        unsigned int native_handle() const noexcept;
+
+    private:
+        struct Impl;
+        std::unique_ptr<Impl> m_impl{};
+    };
+
+    // Implementation.
+
+    template<typename T>
+    BufferRing::Allocation BufferRing::push(const T& value) {
+        static_assert(std::is_trivially_copyable_v<T>, "Only trivially copyable values can be copied to a buffer.");
+        const auto allocation = allocate(sizeof(T));
+        std::memcpy(allocation.data, &value, sizeof(T));
+        return allocation;
+    }
+
+}
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <cstddef>
+
+#include <ogf/graphics/color.hxx>
+#include <ogf/types.hxx>
+
+namespace ogf {
+
+    // Color packed into four bytes, laid out as an RGBA8 pixel. Takes a quarter of the memory of Color, so it's the
+    // better choice for storing many colors, e.g. per vertex or per pixel.
+    class Color32 {
+    public:
+        // Create opaque black.
+        constexpr Color32() noexcept = default;
+
+        constexpr Color32(const Uint8 r, const Uint8 g, const Uint8 b, const Uint8 a = 255) noexcept;
+
+        // Quantize a color. Components are clamped to [0.0f .. 1.0f] and rounded to nearest.
+        explicit Color32(const Color& color) noexcept;
+
+        // Get the color with components in range [0.0f .. 1.0f].
+        Color to_color() const noexcept;
+
+        Uint8 r{0};
+        Uint8 g{0};
+        Uint8 b{0};
+        Uint8 a{255};
+
+        static const Color32 BLACK;
+        static const Color32 WHITE;
+    };
+
+    constexpr bool operator==(const Color32& left, const Color32& right) noexcept;
+    constexpr bool operator!=(const Color32& left, const Color32& right) noexcept;
+
+    // Convert many colors at once, with SIMD where the CPU has it. Packing rounds as the Color32 constructor does.
+    void pack_colors(const Color* colors, Color32* packed, const std::size_t count) noexcept;
+    void unpack_colors(const Color32* packed, Color* colors, const std::size_t count) noexcept;
+
+    // The sRGB transfer function and its inverse, for values in range [0.0f .. 1.0f].
+    float srgb_to_linear(const float value) noexcept;
+    float linear_to_srgb(const float value) noexcept;
+
+    // Decode sRGB colors to linear light and back through lookup tables. Alpha is linear in both. Encoding clamps
+    // components to [0.0f .. 1.0f] and rounds them to the nearest sRGB value.
+    void srgb_to_linear(const Color32* srgb, Color* linear, const std::size_t count) noexcept;
+    void linear_to_srgb(const Color* linear, Color32* srgb, const std::size_t count) noexcept;
+
+    // Implementation.
+
+    constexpr Color32::Color32(const Uint8 r, const Uint8 g, const Uint8 b, const Uint8 a) noexcept
+            : r{r}, g{g}, b{b}, a{a} {
+    }
+
+    constexpr bool operator==(const Color32& left, const Color32& right) noexcept {
+        return left.r == right.r && left.g == right.g && left.b == right.b && left.a == right.a;
+    }
+
+    constexpr bool operator!=(const Color32& left, const Color32& right) noexcept {
+        return !(left == right);
+    }
+
+}
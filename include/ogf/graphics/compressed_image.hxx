@@ -0,0 +1,68 @@
+#pragma once
+
+#include <cstddef>
+#include <tuple>
+#include <vector>
+
+#include <ogf/graphics/image_view.hxx>
+#include <ogf/types.hxx>
+
+namespace ogf {
+
+    class Image;
+
+    enum class CompressionFormat {
+        BC1,   // RGB with optional 1-bit alpha, 4 bits per pixel.
+        BC3,   // RGBA, 8 bits per pixel.
+        BC4,   // Single channel (red), 4 bits per pixel.
+        BC5,   // Two channels (red, green), 8 bits per pixel. Best suited for normal maps.
+        BC7    // High quality RGBA, 8 bits per pixel.
+    };
+
+    enum class CompressionQuality {
+        FAST,     // Bounding box endpoints.
+        NORMAL,   // Principal axis endpoints refined once.
+        HIGH      // Principal axis endpoints with exhaustive refinement.
+    };
+
+    // Image stored in a GPU block-compressed format, with optional mipmaps.
+    class CompressedImage {
+    public:
+        // Compress the image on the library thread pool. Pixels are converted to RGBA8 first, so BC4 and BC5 take the
+        // red and green channels of any format. BC5 takes both channels of two channel images as they are.
+        void compress(const ImageView& image, const CompressionFormat format,
+                const CompressionQuality quality = CompressionQuality::NORMAL);
+
+        // Compress the image together with its mipmaps, e.g. from generate_mipmaps().
+        void compress(const ImageView& image, const std::vector<Image>& mipmaps, const CompressionFormat format,
+                const CompressionQuality quality = CompressionQuality::NORMAL);
+
+        void free();
+
+        CompressionFormat format() const noexcept;
+
+        std::tuple<unsigned int, unsigned int> size() const;
+
+        // Number of levels, including the base one.
+        std::size_t level_count() const noexcept;
+
+        // Get the compressed blocks of given level, row by row from the top.
+        const std::vector<Uint8>& level_data(const std::size_t level) const;
+
+    private:
+        friend class Texture;
+
+        struct Level {
+            std::vector<Uint8> data{};
+            unsigned int       width{};
+            unsigned int       height{};
+        };
+
+        static Level compress_level(const ImageView& image, const CompressionFormat format,
+                const CompressionQuality quality);
+
+        std::vector<Level> m_levels{};
+        CompressionFormat  m_format{CompressionFormat::BC1};
+    };
+
+}
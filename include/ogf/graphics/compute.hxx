@@ -0,0 +1,46 @@
+#pragma once
+
+#include <cstddef>
+
+#include <ogf/types.hxx>
+
+namespace ogf {
+
+    // Kinds of reads which have to see the writes compute shaders made to storage buffers and images before them.
+    // Values match the OpenGL barrier bits, so they can be combined with |.
+    enum class Barrier : Uint32 {
+        VERTEX_ATTRIB_ARRAY = 0x00000001,   // Vertex data, e.g. particles updated on the GPU.
+        ELEMENT_ARRAY       = 0x00000002,   // Indices, e.g. ones written by a culling pass.
+        UNIFORM             = 0x00000004,
+        TEXTURE_FETCH       = 0x00000008,   // Textures sampled after being written as images.
+        SHADER_IMAGE_ACCESS = 0x00000020,
+        COMMAND             = 0x00000040,   // Indirect draw and dispatch arguments.
+        PIXEL_BUFFER        = 0x00000080,
+        TEXTURE_UPDATE      = 0x00000100,   // Texture reads and writes of the CPU side, e.g. glGetTexImage.
+        BUFFER_UPDATE       = 0x00000200,   // Buffer reads and writes of the CPU side, e.g. glGetBufferSubData.
+        FRAMEBUFFER         = 0x00000400,
+        TRANSFORM_FEEDBACK  = 0x00000800,
+        ATOMIC_COUNTER      = 0x00001000,
+        SHADER_STORAGE      = 0x00002000,   // Storage buffers read by later shaders.
+        ALL                 = 0xFFFFFFFF
+    };
+
+    constexpr Barrier operator|(const Barrier left, const Barrier right) noexcept;
+
+    // Order the writes of shaders run before against the reads of given kinds made after. Does nothing in contexts
+    // without OpenGL 4.2 or ARB_shader_image_load_store, which can't write memory from shaders.
+    void memory_barrier(const Barrier barriers);
+
+    // Bind a buffer, or size bytes of it at given offset, to a shader storage block binding point. The whole buffer is
+    // bound if size is 0. Offsets must be multiples of GL_SHADER_STORAGE_BUFFER_OFFSET_ALIGNMENT. Needs OpenGL 4.3 or
+    // ARB_shader_storage_buffer_object.
+    void bind_storage_buffer(const unsigned int binding, const unsigned int buffer, const std::size_t offset = 0,
+            const std::size_t size = 0);
+
+    // Implementation.
+
+    constexpr Barrier operator|(const Barrier left, const Barrier right) noexcept {
+        return static_cast<Barrier>(static_cast<Uint32>(left) | static_cast<Uint32>(right));
+    }
+
+}
@@ -1,31 +1,128 @@
 #pragma once
 
+#include <array>
+#include <future>
 #include <string>
 #include <tuple>
 #include <vector>
 
 #include <ogf/graphics/color.hxx>
+#include <ogf/graphics/image_view.hxx>
+#include <ogf/graphics/pixel_format.hxx>
+#include <ogf/math/rect.hxx>
+#include <ogf/utils/aligned_allocator.hxx>
 
 namespace ogf {
 
+    enum class ResizeFilter {
+        BOX,       // Average of the covered pixels. Good for integer downscaling, blocky when upscaling.
+        BILINEAR,  // Tent filter. Cheap, soft.
+        MITCHELL,  // Mitchell-Netravali cubic. Balances sharpness, ringing and aliasing.
+        LANCZOS3   // Three-lobed windowed sinc. Sharpest, with slight ringing around hard edges.
+    };
+
     class Image {
     public:
+        // Every row starts at an address aligned to this many bytes.
+        static constexpr std::size_t ROW_ALIGNMENT = 64;
+
+        // Create an image of given size and format filled with the color.
+        void create(const unsigned int width, const unsigned int height, const Color& color = Color::BLACK,
+                const PixelFormat format = PixelFormat::RGBA8);
+
+        // Create an image with a copy of the pixels in the view, e.g. to crop another image.
+        void create(const ImageView& source);
+
+        // The image keeps the channel count stored in the file, e.g. grayscale images are loaded as R8 and grayscale
+        // with alpha as RG8. 16-bit files are loaded as R16 to RGBA16 and HDR files as R32F to RGB32F.
         void load_from_file(const std::string_view filename);
-        //void save_to_file(const std::string_view filename);
+
+        // Save image to a file. Format is chosen by the extension, supported ones are: PNG, TGA, BMP, JPG, HDR. PNG
+        // keeps 16-bit channels and HDR keeps floats, otherwise pixels are converted to 8 bits per channel.
+        void save_to_file(const std::string_view filename) const;
+
+        // Same as above, but encoding is done on the library thread pool. The image is copied, so it may be modified
+        // or destroyed right after this call. Errors are reported through the returned future.
+        std::future<void> save_to_file_async(const std::string_view filename) const;
 
         void free();
 
+        // Convert pixels to another format. Normalized values are clamped when converting from floats.
+        void convert(const PixelFormat format);
+
+        // Resample the image to given size with a separable filter, keeping its format. If srgb is true, colors of RGB8
+        // and RGBA8 images are filtered in linear light. Colors are weighted by alpha, so fully transparent pixels
+        // don't bleed into their neighbours. Both passes run on the library thread pool.
+        void resize(const unsigned int width, const unsigned int height,
+                const ResizeFilter filter = ResizeFilter::MITCHELL, const bool srgb = true);
+
+        // Bulk operations below run on the library thread pool over bands of rows and use SIMD where available. They're
+        // much faster than the same work done with set_pixel().
+
+        void fill(const Color& color);
+
+        // Fill the area clipped to the image.
+        void fill(const RectU& area, const Color& color);
+
+        // Copy the source pixels with their top-left corner at given position, clipped to the image. Pixels are
+        // converted to the image format. The source may be a view of the image itself.
+        void blit(const ImageView& source, const int x, const int y);
+
+        // Same as blit(), but the source is blended over the image. Both must have premultiplied alpha.
+        void blend_over(const ImageView& source, const int x, const int y);
+
+        // Reorder channels: channel i becomes the channel order[i], e.g. {2, 1, 0, 3} swaps red and blue. Only the
+        // first channel_count() entries are used and each must be less than it.
+        void swizzle(const std::array<unsigned int, 4>& order);
+
+        // Multiply colors by alpha. Does nothing for formats without alpha.
+        void premultiply_alpha();
+
+        void flip_horizontally();
+        void flip_vertically();
+
+        // Colors are converted from and to the image format. Throws std::out_of_range for pixels outside the image.
         void set_pixel(const unsigned int x, const unsigned int y, const Color& color);
         Color pixel(const unsigned int x, const unsigned int y) const;
 
-        std::tuple<unsigned int, unsigned int> size();
+        std::tuple<unsigned int, unsigned int> size() const;
+
+        PixelFormat format() const noexcept;
+
+        // Get the pixels in the image format, row by row from the top, with rows stride() bytes apart. Null if the
+        // image is empty.
+        Uint8* pixels() noexcept;
+        const Uint8* pixels() const noexcept;
+
+        // Distance between starts of neighbouring rows in bytes. It's a multiple of both ROW_ALIGNMENT and the pixel
+        // size, the bytes past the last pixel of a row are unused.
+        std::size_t stride() const noexcept;
+
+        // Get a view of the whole image or of its part, without copying pixels. Throws std::out_of_range if the area
+        // isn't inside the image. Views are invalidated when the image is reallocated.
+        ImageView view() const noexcept;
+        MutableImageView view() noexcept;
+        ImageView view(const RectU& area) const;
+        MutableImageView view(const RectU& area);
+
+        // Images are accepted wherever views are.
+        operator ImageView() const noexcept;
 
     private:
-        friend class Texture;
+        // Fills the levels straight from the file, without clearing them first.
+        friend std::vector<Image> load_mipmaps_from_file(const std::string_view filename);
+
+        // Check if the view points into the pixels of the image.
+        bool overlaps(const ImageView& view) const noexcept;
+
+        // Allocate uninitialized pixels.
+        void allocate(const unsigned int width, const unsigned int height, const PixelFormat format);
 
-        std::vector<Uint8> m_pixels{};
-        unsigned int       m_width{};
-        unsigned int       m_height{};
+        std::vector<Uint8, AlignedAllocator<Uint8, ROW_ALIGNMENT>> m_pixels{};
+        std::size_t                                               m_stride{};
+        unsigned int                                              m_width{};
+        unsigned int                                              m_height{};
+        PixelFormat                                               m_format{PixelFormat::RGBA8};
     };
 
 }
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <string>
+
+namespace ogf {
+
+    class Image;
+    class Texture;
+
+    // Decodes many image files concurrently on the library thread pool. Finished images are handed out in completion
+    // order. Decoded images which haven't been collected yet, together with the ones being decoded, never take more
+    // than the memory budget, unless a single image is bigger than the whole budget.
+    class ImageBatchLoader {
+    public:
+        explicit ImageBatchLoader(const std::size_t memory_budget = 256 * 1024 * 1024);
+
+        // Waits for all running decodes to finish. Queued files which haven't started yet are dropped.
+        ~ImageBatchLoader();
+
+        ImageBatchLoader(const ImageBatchLoader&) = delete;
+        ImageBatchLoader& operator=(const ImageBatchLoader&) = delete;
+
+        // Queue a file for decoding.
+        void add(const std::string_view filename);
+
+        // Wait for the next finished image. Returns false if there are no more queued files. If decoding failed, the
+        // exception is rethrown here.
+        bool wait_next(std::string& filename, Image& image);
+
+        // Same as above, but the image is uploaded to the texture. Must be called from a thread with a GL context.
+        bool wait_next(std::string& filename, Texture& texture);
+
+        // Get the next finished image if there is one. Never blocks.
+        bool poll_next(std::string& filename, Image& image);
+
+        // Number of files which were added, but not collected yet.
+        std::size_t pending() const;
+
+    private:
+        struct Impl;
+        std::unique_ptr<Impl> m_impl{};
+    };
+
+}
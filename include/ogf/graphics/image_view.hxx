@@ -0,0 +1,94 @@
+#pragma once
+
+#include <cstddef>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+
+#include <ogf/graphics/pixel_format.hxx>
+#include <ogf/math/rect.hxx>
+#include <ogf/types.hxx>
+
+namespace ogf {
+
+    // Non-owning reference to a rectangle of pixels in memory, row by row from the top, with rows stride bytes apart.
+    // The stride must be a multiple of the pixel size. Views are cheap to copy and their parts cost nothing to make,
+    // but they're invalidated by anything reallocating the pixels they point to, e.g. Image::create() or convert().
+    // T is Uint8 for writable views and const Uint8 for read-only ones.
+    template<typename T>
+    class BasicImageView {
+    public:
+        // Create an empty view.
+        constexpr BasicImageView() noexcept = default;
+
+        constexpr BasicImageView(T* pixels, const unsigned int width, const unsigned int height,
+                const std::size_t stride, const PixelFormat format) noexcept;
+
+        // Writable views convert to read-only ones.
+        template<typename U, typename = std::enable_if_t<std::is_convertible_v<U*, T*>>>
+        constexpr BasicImageView(const BasicImageView<U>& other) noexcept;
+
+        // Get a part of the view. Throws std::out_of_range if the area doesn't fit into the view.
+        BasicImageView subview(const RectU& area) const;
+
+        // Get the first pixel of a row.
+        constexpr T* row(const unsigned int y) const noexcept;
+
+        constexpr std::tuple<unsigned int, unsigned int> size() const noexcept;
+
+        constexpr bool empty() const noexcept;
+
+        T*           pixels{nullptr};
+        unsigned int width{};
+        unsigned int height{};
+        std::size_t  stride{};
+        PixelFormat  format{PixelFormat::RGBA8};
+    };
+
+    using ImageView        = BasicImageView<const Uint8>;
+    using MutableImageView = BasicImageView<Uint8>;
+
+    // Implementation.
+
+    template<typename T>
+    constexpr BasicImageView<T>::BasicImageView(T* pixels, const unsigned int width, const unsigned int height,
+            const std::size_t stride, const PixelFormat format) noexcept
+            : pixels{pixels}, width{width}, height{height}, stride{stride}, format{format} {
+    }
+
+    template<typename T>
+    template<typename U, typename>
+    constexpr BasicImageView<T>::BasicImageView(const BasicImageView<U>& other) noexcept
+            : pixels{other.pixels}, width{other.width}, height{other.height}, stride{other.stride},
+            format{other.format} {
+    }
+
+    template<typename T>
+    BasicImageView<T> BasicImageView<T>::subview(const RectU& area) const {
+        if(area.left > width || area.width > width - area.left || area.top > height
+                || area.height > height - area.top) {
+            throw std::out_of_range{"Image view area is outside of the view."};
+        }
+        if(area.width == 0 || area.height == 0) {
+            return BasicImageView{nullptr, 0, 0, stride, format};
+        }
+        return BasicImageView{row(area.top) + static_cast<std::size_t>(area.left) * pixel_size(format), area.width,
+                area.height, stride, format};
+    }
+
+    template<typename T>
+    constexpr T* BasicImageView<T>::row(const unsigned int y) const noexcept {
+        return pixels + y * stride;
+    }
+
+    template<typename T>
+    constexpr std::tuple<unsigned int, unsigned int> BasicImageView<T>::size() const noexcept {
+        return std::make_tuple(width, height);
+    }
+
+    template<typename T>
+    constexpr bool BasicImageView<T>::empty() const noexcept {
+        return pixels == nullptr || width == 0 || height == 0;
+    }
+
+}
@@ -0,0 +1,30 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include <ogf/graphics/image_view.hxx>
+
+namespace ogf {
+
+    class Image;
+
+    enum class MipmapFilter {
+        BOX,     // Average of the covered pixels. Fast, slightly blurry.
+        KAISER   // Kaiser-windowed sinc. Keeps more detail at a small cost of ringing.
+    };
+
+    // Generate all mipmap levels below the image, from half of its size down to 1x1, in the format of the image. If
+    // srgb is true, colors of RGB8 and RGBA8 images are filtered in linear light, which keeps the brightness of
+    // downsampled levels right. Alpha and all other formats are always taken as linear. Colors of formats with alpha
+    // are weighted by it while filtering.
+    std::vector<Image> generate_mipmaps(const ImageView& image, const MipmapFilter filter = MipmapFilter::BOX,
+            const bool srgb = true);
+
+    // Store generated mipmaps, so they don't need to be generated at runtime.
+    void save_mipmaps_to_file(const std::string_view filename, const std::vector<Image>& mipmaps);
+
+    // Load mipmaps stored by save_mipmaps_to_file().
+    std::vector<Image> load_mipmaps_from_file(const std::string_view filename);
+
+}
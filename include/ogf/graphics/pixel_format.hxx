@@ -0,0 +1,25 @@
+#pragma once
+
+namespace ogf {
+
+    // Layout of image pixels. Channels are stored in RGBA order. 8-bit and 16-bit channels are unsigned normalized,
+    // 16F channels are half precision floats and 32F channels are single precision floats, all in native byte order.
+    // One and two channel formats hold grey and grey with alpha, they're sampled as such by textures too.
+    enum class PixelFormat {
+        R8, RG8, RGB8, RGBA8,
+        R16, RG16, RGB16, RGBA16,
+        R16F, RG16F, RGB16F, RGBA16F,
+        R32F, RG32F, RGB32F, RGBA32F
+    };
+
+    unsigned int channel_count(const PixelFormat format) noexcept;
+
+    // Size of a single channel in bytes.
+    unsigned int channel_size(const PixelFormat format) noexcept;
+
+    // Size of a whole pixel in bytes.
+    unsigned int pixel_size(const PixelFormat format) noexcept;
+
+    bool is_float_format(const PixelFormat format) noexcept;
+
+}
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <cstddef>
+#include <future>
+#include <memory>
+#include <string>
+
+namespace ogf {
+
+    class Image;
+    class Texture;
+
+    // Shares images and textures loaded from files. Files are looked up by canonical path, so different spellings of a
+    // path give the same resource, and resources by content hash, so copies of a file under different names are decoded
+    // and uploaded once. A path is checked again when its file's size or modification time changes.
+    //
+    // Resources are handed out as shared pointers. Once only the cache holds a resource, it may be evicted, least
+    // recently used first, whenever the cache takes more memory than its budget. Resources still in use are never
+    // evicted, so the budget can be exceeded.
+    class ResourceCache {
+    public:
+        explicit ResourceCache(const std::size_t memory_budget = 512 * 1024 * 1024);
+
+        // Waits for all running loads to finish. Must be destroyed with the GL context still current if any texture
+        // was loaded.
+        ~ResourceCache();
+
+        ResourceCache(const ResourceCache&) = delete;
+        ResourceCache& operator=(const ResourceCache&) = delete;
+
+        // Decode the image on the library thread pool. Concurrent requests for the same file wait for the same decode.
+        // Errors are reported through the returned future. Thread-safe.
+        std::shared_future<std::shared_ptr<const Image>> load_image_async(const std::string_view filename);
+
+        // Same as above, but waits for the image. A new decode runs on the calling thread. Thread-safe.
+        std::shared_ptr<const Image> load_image(const std::string_view filename);
+
+        // Load the texture the same way as Texture::load_from_file(). Must be called from the thread with the GL
+        // context, and texture handles must be released on that thread too.
+        std::shared_ptr<const Texture> load_texture(const std::string_view filename);
+
+        // Evict unused images and textures until the cache fits into its budget. Must be called from the thread with
+        // the GL context. Textures are only evicted here and in load_texture().
+        void trim();
+
+        // Bytes taken by the cached resources. Textures are estimated from their size and format.
+        std::size_t memory_usage() const;
+
+    private:
+        struct Impl;
+        std::unique_ptr<Impl> m_impl{};
+    };
+
+}
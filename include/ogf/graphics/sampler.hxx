@@ -0,0 +1,71 @@
+#pragma once
+
+#include <ogf/types.hxx>
+
+namespace ogf {
+
+    enum class SamplerFilter {
+        NEAREST, LINEAR
+    };
+
+    enum class SamplerMipmapMode {
+        NONE,      // Only the base level is sampled.
+        NEAREST,   // The closest level is sampled.
+        LINEAR     // Two closest levels are sampled and blended.
+    };
+
+    enum class SamplerWrap {
+        REPEAT, MIRRORED_REPEAT, CLAMP_TO_EDGE, CLAMP_TO_BORDER
+    };
+
+    // Complete state of a sampler. It packs into 32 bits, which is the key of the shared sampler cache.
+    struct SamplerDescriptor {
+        SamplerFilter     min_filter{SamplerFilter::LINEAR};
+        SamplerFilter     mag_filter{SamplerFilter::LINEAR};
+        SamplerMipmapMode mipmap_mode{SamplerMipmapMode::LINEAR};
+        SamplerWrap       wrap_s{SamplerWrap::REPEAT};
+        SamplerWrap       wrap_t{SamplerWrap::REPEAT};
+        unsigned int      max_anisotropy{1};   // Clamped to 1 to 16, and to what the context supports.
+
+        Uint32 pack() const noexcept;
+    };
+
+    bool operator==(const SamplerDescriptor& left, const SamplerDescriptor& right) noexcept;
+    bool operator!=(const SamplerDescriptor& left, const SamplerDescriptor& right) noexcept;
+
+    // OpenGL sampler object. Its state overrides the sampling state of whatever texture is bound to the same unit, so
+    // one texture can be sampled in different ways without being duplicated. Samplers are shared: every descriptor maps
+    // to a single object, created on first use.
+    class Sampler {
+    public:
+        ~Sampler();
+
+        Sampler(const Sampler&) = delete;
+        Sampler& operator=(const Sampler&) = delete;
+
+        // Get the shared sampler with given state. The reference stays valid until clear_cache(). Must be called from
+        // a thread with a GL context.
+        static const Sampler& get(const SamplerDescriptor& descriptor);
+
+        // Delete all shared samplers. Call before the GL context is destroyed.
+        static void clear_cache();
+
+        // Bind the sampler to a texture unit. Does nothing if it's bound there already, samplers bound by other code
+        // than this class aren't tracked.
+        void bind(const unsigned int unit) const;
+
+        // Let the texture bound to the unit use its own sampling state again.
+        static void unbind(const unsigned int unit);
+
+        const SamplerDescriptor& descriptor() const noexcept;
+
+        unsigned int native_handle() const noexcept;
+
+    private:
+        explicit Sampler(const SamplerDescriptor& descriptor);
+
+        SamplerDescriptor m_descriptor{};
+        unsigned int      m_sampler{0};
+    };
+
+}
@@ -1,20 +1,41 @@
 #pragma once
 
+#include <array>
+#include <cstddef>
+#include <memory>
 #include <mutex>
 #include <string>
+#include <vector>
+
+#include <ogf/graphics/color.hxx>
+#include <ogf/math/vector2.hxx>
+#include <ogf/math/vector3.hxx>
+#include <ogf/types.hxx>
 
 namespace ogf {
 
     enum class ShaderType {
-        VERTEX, GEOMETRY, FRAGMENT
+        VERTEX, GEOMETRY, FRAGMENT, COMPUTE
+    };
+
+    // Name of a uniform or a block, hashed when it's created. Names kept in constexpr variables are hashed at compile
+    // time. Array uniforms are named without the index, which refers to their first element.
+    class UniformName {
+    public:
+        constexpr UniformName(const char* name) noexcept;
+        constexpr UniformName(const std::string_view name) noexcept;
+
+        Uint64 hash{};
     };
 
     class Shader {
     public:
-        Shader() noexcept = default;
+        Shader() noexcept;
         ~Shader();
 
-        // Load shader of given type from a file.
+        // Load shader of given type from a file. A compute shader makes a program of its own, which is run with
+        // dispatch() instead of drawing. Compute shaders need OpenGL 4.3 or ARB_compute_shader, std::runtime_error is
+        // thrown without it.
         void load_from_file(const std::string_view filename, const ShaderType type);
 
         // Load vertex and fragment shaders from files.
@@ -34,14 +55,138 @@ namespace ogf {
         void load_from_memory(const std::string_view vertex_source, const std::string_view geometry_source,
                 const std::string_view fragment_source);
 
+        // Start compiling shaders without waiting for the driver. All stages and the link are submitted at once, so
+        // drivers with GL_KHR_parallel_shader_compile can build many programs on their own threads. Errors are
+        // reported by is_ready() or wait(). Using the program before it's ready stalls until it's finished.
+        void load_from_memory_async(const std::string_view source, const ShaderType type);
+        void load_from_memory_async(const std::string_view vertex_source, const std::string_view fragment_source);
+        void load_from_memory_async(const std::string_view vertex_source, const std::string_view geometry_source,
+                const std::string_view fragment_source);
+
+        // Check without blocking if the program has finished compiling. Without GL_KHR_parallel_shader_compile
+        // this waits for the driver. Throws if the compilation failed.
+        bool is_ready();
+
+        // Wait until the program has finished compiling. Throws if the compilation failed.
+        void wait();
+
+        // Store linked programs in given directory and load them from there instead of compiling the same sources
+        // again. Binaries are keyed by the sources and the OpenGL vendor, renderer and version strings. A program is
+        // compiled from its sources when its binary is missing or rejected by the driver. An empty directory, the
+        // default, turns the cache off. Needs OpenGL 4.1 or ARB_get_program_binary, otherwise nothing is cached.
+        static void set_binary_cache_directory(const std::string_view directory);
+
+        // Get the location of an active uniform, or -1 if the program doesn't have it or hasn't finished compiling.
+        // Looked up in a table filled once after linking, without asking the driver.
+        int uniform_location(const UniformName name) const noexcept;
+
+        // Set a uniform of the program, which must be in use. Values equal to the last ones set through these
+        // functions aren't uploaded again. Uniforms the program doesn't have, e.g. ones optimized out, are ignored.
+        // Waits for a program which is still compiling.
+        void set_uniform(const UniformName name, const int value);
+        void set_uniform(const UniformName name, const unsigned int value);
+        void set_uniform(const UniformName name, const float value);
+        void set_uniform(const UniformName name, const Vector2F& value);
+        void set_uniform(const UniformName name, const Vector3F& value);
+        void set_uniform(const UniformName name, const Color& value);
+
+        // Set a mat4 uniform from 16 values in column-major order.
+        void set_uniform_matrix4(const UniformName name, const float* values);
+
+        // Assign a uniform or shader storage block of the program to a binding point, e.g. the one a BufferRing
+        // allocation is bound to. Returns false if the program doesn't have the block. Storage blocks need OpenGL 4.3
+        // or ARB_shader_storage_buffer_object. Waits for a program which is still compiling.
+        bool bind_uniform_block(const UniformName name, const unsigned int binding);
+        bool bind_storage_block(const UniformName name, const unsigned int binding);
+
+        // Get the size of a uniform block's data in bytes, or 0 if the program doesn't have it.
+        std::size_t uniform_block_size(const UniformName name) const noexcept;
+
+        // Run a compute program, which must be in use, with given number of work groups in each dimension. Waits for
+        // a program which is still compiling. Throws std::runtime_error if the program has no compute shader. Writes
+        // to storage buffers and images must be made visible with memory_barrier() before they're read.
+        void dispatch(const unsigned int groups_x, const unsigned int groups_y = 1, const unsigned int groups_z = 1);
+
+        // Run a compute program with enough work groups for at least given number of invocations in each dimension,
+        // e.g. one per pixel of an image. Shaders have to skip invocations beyond the end.
+        void dispatch_invocations(const unsigned int size_x, const unsigned int size_y = 1,
+                const unsigned int size_z = 1);
+
+        // Run a compute program with work group counts read by the GPU from three unsigned ints at given offset in a
+        // buffer, e.g. ones written by an earlier culling pass. Leaves the buffer bound as the dispatch indirect one.
+        void dispatch_indirect(const unsigned int buffer, const std::size_t offset = 0);
+
+        // Get the local work group size declared by the compute shader, or zeros if the program has none.
+        std::array<unsigned int, 3> work_group_size() const noexcept;
+
         // Get the underlying OpenGL handle of the shader.
         unsigned int native_handle() const noexcept;
 
     private:
-        void compile(const char* vertex_source, const char* geometry_source, const char* fragment_source);
+        struct PendingCompile;
+
+        // Sources of the vertex, geometry, fragment and compute stages, null for the ones not present.
+        using StageSources = std::array<const char*, 4>;
+
+        // Active uniform with a copy of the last value uploaded to it.
+        struct Uniform {
+            Uint64                 hash{};
+            int                    location{-1};
+            bool                   known{false};
+            std::array<Uint32, 16> shadow{};
+
+            // Remember a value and check if it differs from the last one.
+            bool update(const void* value, const std::size_t size) noexcept;
+        };
+
+        // Active uniform or shader storage block.
+        struct Block {
+            Uint64       hash{};
+            unsigned int index{};
+            bool         storage{false};
+            int          binding{-1};
+            std::size_t  size{};
+        };
+
+        void compile(const StageSources& sources, const bool async);
+
+        // Check the results of a pending compilation. Needs m_mutex locked.
+        void finish();
 
-        unsigned int m_program{0};
-        std::mutex   m_mutex{};
+        void release() noexcept;
+
+        // Fill the uniform and block tables of a linked program, and the work group size of a compute one.
+        void reflect(const bool compute);
+
+        Uniform* find_uniform(const UniformName name);
+
+        bool bind_block(const UniformName name, const bool storage, const unsigned int binding);
+
+        // Make sure the program is a linked compute program before a dispatch.
+        void prepare_dispatch();
+
+        unsigned int                    m_program{0};
+        std::unique_ptr<PendingCompile> m_pending{};
+        // Sorted by name hash.
+        std::vector<Uniform>            m_uniforms{};
+        std::vector<Block>              m_blocks{};
+        // Zeros unless it's a compute program.
+        std::array<unsigned int, 3>     m_work_group_size{};
+        std::mutex                      m_mutex{};
     };
 
+    // Implementation.
+
+    constexpr UniformName::UniformName(const char* name) noexcept
+            : UniformName{std::string_view{name}} {
+    }
+
+    constexpr UniformName::UniformName(const std::string_view name) noexcept
+            : hash{14695981039346656037u} {
+        // 64-bit FNV-1a, simple enough to run at compile time.
+        for(const auto character : name) {
+            hash = (hash ^ static_cast<unsigned char>(character)) * 1099511628211u;
+        }
+    }
+
 }
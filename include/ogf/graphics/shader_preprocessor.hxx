@@ -0,0 +1,39 @@
+#pragma once
+
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace ogf {
+
+    // Macros defined for a shader variant, as names and values, e.g. {{"SHADOWS", "1"}, {"LIGHT_COUNT", "4"}}.
+    using ShaderDefines = std::vector<std::pair<std::string, std::string>>;
+
+    // Prepares GLSL sources before compilation: resolves #include "name" directives and inserts #define lines for a
+    // variant right after the #version line. Every file is included at most once per source, as if it had an include
+    // guard. Includes inside #if, #ifdef and #ifndef blocks are left to the GLSL preprocessor to resolve: their files
+    // are wrapped in generated guards and included again where they're needed outside such a block, and a missing one
+    // becomes an #error line. Lines are renumbered with #line, each included file getting its own source number in
+    // the order it was first included, so compiler errors point into the original files.
+    class ShaderPreprocessor {
+    public:
+        // Add a directory searched for included files after the directory of the including file.
+        void add_include_directory(const std::string_view directory);
+
+        // Make a source in memory available to #include under given name. Such sources are found before files.
+        void add_source(const std::string_view name, const std::string_view source);
+
+        // Preprocess a source. Files it includes are searched relative to filename's directory first. Throws
+        // std::runtime_error if an included file can't be found.
+        std::string process(const std::string_view source, const ShaderDefines& defines = {},
+                const std::string_view filename = {}) const;
+
+        // Preprocess a file. Throws std::runtime_error if it or a file it includes can't be read.
+        std::string process_file(const std::string_view filename, const ShaderDefines& defines = {}) const;
+
+    private:
+        std::vector<std::string>                         m_include_directories{};
+        std::vector<std::pair<std::string, std::string>> m_sources{};
+    };
+
+}
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <ogf/graphics/shader_preprocessor.hxx>
+
+namespace ogf {
+
+    class Shader;
+
+    // Programs built from the same stage sources with different sets of defines, e.g. the feature permutations of an
+    // uber-shader. Each variant is preprocessed and compiled once, either when it's first needed or ahead of time with
+    // prepare(). Compiled variants also go to the binary cache of Shader when it's enabled.
+    class ShaderVariants {
+    public:
+        // Read a compute shader file.
+        ShaderVariants(ShaderPreprocessor preprocessor, const std::string_view compute_filename);
+
+        // Read vertex and fragment shader files. Includes are resolved by the preprocessor for every variant.
+        ShaderVariants(ShaderPreprocessor preprocessor, const std::string_view vertex_filename,
+                const std::string_view fragment_filename);
+
+        // Read vertex, geometry and fragment shader files.
+        ShaderVariants(ShaderPreprocessor preprocessor, const std::string_view vertex_filename,
+                const std::string_view geometry_filename, const std::string_view fragment_filename);
+
+        // Must be destroyed with the GL context still current.
+        ~ShaderVariants();
+
+        ShaderVariants(const ShaderVariants&) = delete;
+        ShaderVariants& operator=(const ShaderVariants&) = delete;
+
+        // Get the program for given defines, compiling it if needed. The order of the defines doesn't matter. Waits
+        // for a variant which is still compiling. Throws std::runtime_error if the variant fails to compile.
+        Shader& get(const ShaderDefines& defines);
+
+        // Preprocess variants on the library thread pool and submit them for compilation without waiting for the
+        // driver, which builds them on its own threads if it supports GL_KHR_parallel_shader_compile. Call from the
+        // thread with the GL context. Compilation errors are reported by get().
+        void prepare(const std::vector<ShaderDefines>& variants);
+
+        // Number of variants compiled or being compiled.
+        std::size_t size() const noexcept;
+
+    private:
+        struct Impl;
+        std::unique_ptr<Impl> m_impl{};
+    };
+
+}
@@ -1,17 +1,49 @@
 #pragma once
 
 #include <string>
+#include <vector>
+
+#include <ogf/graphics/image_view.hxx>
+#include <ogf/graphics/pixel_format.hxx>
 
 namespace ogf {
 
+    class CompressedImage;
     class Image;
+    class Sampler;
 
     class Texture {
     public:
         ~Texture();
 
+        // Create an uninitialized texture with given number of mipmap levels.
+        void create(const unsigned int width, const unsigned int height, const unsigned int levels = 1,
+                const PixelFormat format = PixelFormat::RGBA8);
+
+        // DDS and KTX2 files are uploaded as stored, with all their mipmaps and without decoding. Other formats are
+        // loaded through Image.
         void load_from_file(const std::string_view filename);
-        void load_from_image(const Image& image);   // TODO: Allow making textures from just a part of an image.
+
+        // The texture gets the internal format matching the image format, e.g. GL_R8 or GL_RGBA16F. Mipmaps are
+        // generated on the CPU with a gamma-correct box filter. Pass a view of a part of an image, e.g.
+        // image.view(area), to make the texture from just that part without copying it.
+        void load_from_image(const ImageView& image);
+
+        // Load texture with pregenerated mipmaps, e.g. from generate_mipmaps() or a mipmap cache.
+        void load_from_image(const ImageView& image, const std::vector<Image>& mipmaps);
+
+        // Upload block-compressed data as is, together with its mipmaps. Throws if the format isn't supported by the
+        // current context.
+        void load_from_image(const CompressedImage& image);
+
+        // Overwrite a region of given mipmap level with the image. Only the region is uploaded, pixels are converted
+        // by OpenGL if the image format differs from the texture format.
+        void update(const ImageView& image, const unsigned int x, const unsigned int y, const unsigned int level = 0);
+
+        // Bind the texture to a texture unit. The texture keeps its own nearest-neighbour, repeating sampling state,
+        // the overload binds a shared sampler to the unit as well.
+        void bind(const unsigned int unit) const;
+        void bind(const unsigned int unit, const Sampler& sampler) const;
 
         // Remove texture from memory. Does nothing if texture doesn't exist.
         void free() noexcept;
@@ -21,6 +53,8 @@ namespace ogf {
     private:
         friend class Model;
 
+        void load_container(const std::string_view filename);
+
         unsigned int m_texture{};   // Internal OpenGL texture handle.
         unsigned int m_width{};
         unsigned int m_height{};
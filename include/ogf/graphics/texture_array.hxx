@@ -0,0 +1,53 @@
+#pragma once
+
+#include <vector>
+
+#include <ogf/graphics/image_view.hxx>
+#include <ogf/graphics/pixel_format.hxx>
+
+namespace ogf {
+
+    class Image;
+    class Sampler;
+
+    // Stack of same-sized 2D layers in one GL_TEXTURE_2D_ARRAY. Shaders pick the layer by index, so objects with
+    // different textures can be drawn without rebinding.
+    class TextureArray {
+    public:
+        TextureArray() noexcept = default;
+        ~TextureArray();
+
+        TextureArray(const TextureArray&) = delete;
+        TextureArray& operator=(const TextureArray&) = delete;
+
+        // Create uninitialized layers with given number of mipmap levels.
+        void create(const unsigned int width, const unsigned int height, const unsigned int layers,
+                const unsigned int levels = 1, const PixelFormat format = PixelFormat::RGBA8);
+
+        // Make a layer from every image. All images must have the same size and format. Mipmaps are generated on the
+        // CPU with a gamma-correct box filter.
+        void load_from_images(const std::vector<Image>& images);
+
+        // Overwrite a region of given layer and mipmap level with the image.
+        void update(const ImageView& image, const unsigned int layer, const unsigned int x = 0,
+                const unsigned int y = 0, const unsigned int level = 0);
+
+        void bind(const unsigned int unit) const;
+        void bind(const unsigned int unit, const Sampler& sampler) const;
+
+        // Remove texture from memory. Does nothing if texture doesn't exist.
+        void free() noexcept;
+
+        unsigned int layer_count() const noexcept;
+
+        unsigned int native_handle() const noexcept;
+
+    private:
+        unsigned int m_texture{};
+        unsigned int m_width{};
+        unsigned int m_height{};
+        unsigned int m_layers{};
+        unsigned int m_levels{};
+    };
+
+}
@@ -0,0 +1,76 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+#include <ogf/graphics/image.hxx>
+#include <ogf/math/rect.hxx>
+
+namespace ogf {
+
+    class SkylinePacker;
+    class Texture;
+
+    // Packs many small images into few big textures, so they can be drawn without switching textures. Every image is
+    // surrounded by a gutter repeating its edge pixels, and placed on a multiple of the alignment, so neither filtering
+    // nor the first log2(alignment) mipmap levels bleed neighbouring images into each other.
+    class TextureAtlas {
+    public:
+        // Alignment must be a power of two.
+        explicit TextureAtlas(const unsigned int page_size = 2048, const unsigned int padding = 2,
+                const unsigned int alignment = 4);
+        ~TextureAtlas();
+
+        TextureAtlas(const TextureAtlas&) = delete;
+        TextureAtlas& operator=(const TextureAtlas&) = delete;
+
+        // Place the image in the atlas and return its id. A new page is started when the image doesn't fit into any
+        // existing one. Nothing is uploaded until update() is called. Throws if the image is bigger than a page. Pages
+        // are RGBA8, images of other formats are converted. Pass a view to add a part of an image, e.g. a sprite sheet
+        // cell, without copying it first.
+        std::size_t add(const ImageView& image);
+
+        // Upload images added since the last call. Only their regions are uploaded. Must be called from a thread with
+        // a GL context.
+        void update();
+
+        // Index of the page the image was placed on.
+        std::size_t page(const std::size_t id) const;
+
+        // Texture coordinates of the image on its page.
+        RectF uv_rect(const std::size_t id) const;
+
+        // Pixel rectangle of the image on its page, without the gutter.
+        RectU pixel_rect(const std::size_t id) const;
+
+        std::size_t page_count() const noexcept;
+
+        // Texture of given page. Only valid after update().
+        const Texture& texture(const std::size_t page) const;
+
+    private:
+        struct Entry {
+            std::size_t page{};
+            RectU       rect{};
+        };
+
+        struct Upload {
+            std::size_t        page{};
+            unsigned int       x{};
+            unsigned int       y{};
+            Image              slot{};
+            std::vector<Image> mipmaps{};
+        };
+
+        std::vector<std::unique_ptr<SkylinePacker>> m_packers{};
+        std::vector<std::unique_ptr<Texture>>       m_textures{};
+        std::vector<Entry>                          m_entries{};
+        std::vector<Upload>                         m_uploads{};
+        unsigned int                                m_page_size{};
+        unsigned int                                m_padding{};
+        unsigned int                                m_alignment{};
+        unsigned int                                m_mipmap_levels{};
+    };
+
+}
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <string>
+
+namespace ogf {
+
+    // Keeps only the mipmap levels of DDS/KTX2 textures which are actually needed in video memory. Every texture starts
+    // with its small levels only. The levels wanted for each texture are derived from how big it appears on screen;
+    // missing ones are read from disk on the library thread pool and uploaded by update(). When the textures take more
+    // memory than the budget, the biggest levels of the least recently used textures are dropped.
+    class TextureStreamer {
+    public:
+        using Handle = std::size_t;
+
+        // Textures are first loaded with levels up to initial_size pixels on their longer side.
+        explicit TextureStreamer(const std::size_t memory_budget = 512 * 1024 * 1024,
+                const unsigned int initial_size = 64);
+
+        // Waits for running reads. Must be destroyed with the GL context still current.
+        ~TextureStreamer();
+
+        TextureStreamer(const TextureStreamer&) = delete;
+        TextureStreamer& operator=(const TextureStreamer&) = delete;
+
+        // Map the file and upload its small levels. Must be called from a thread with a GL context.
+        Handle add(const std::string_view filename);
+
+        // Report that the texture covers roughly screen_size pixels on its longer side in the current frame.
+        void report_usage(const Handle handle, const float screen_size);
+
+        // Upload finished reads, evict levels to fit into the budget and start reading wanted levels. Call once per
+        // frame from a thread with a GL context.
+        void update();
+
+        // Index of the most detailed level in video memory. Zero means the whole texture is resident.
+        unsigned int resident_level(const Handle handle) const;
+
+        // Video memory taken by all resident levels.
+        std::size_t memory_usage() const noexcept;
+
+        unsigned int native_handle(const Handle handle) const;
+
+    private:
+        struct Impl;
+        std::unique_ptr<Impl> m_impl{};
+    };
+
+}
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <memory>
+
+#include <ogf/graphics/image_view.hxx>
+#include <ogf/graphics/pixel_format.hxx>
+#include <ogf/graphics/sampler.hxx>
+
+namespace ogf {
+
+    class Shader;
+
+    // Same-sized textures which shaders pick by index, e.g. from per-instance data, so a whole batch of objects with
+    // different textures goes in one draw call. With ARB_bindless_texture every texture is separate and shaders read
+    // its resident handle from a uniform buffer. Otherwise the textures are layers of one texture array.
+    class TextureTable {
+    public:
+        // The handle buffer holds this many textures.
+        static constexpr unsigned int MAX_SIZE = 1024;
+
+        // Every texture is width x height pixels of given format. All of them are sampled with the sampler, which is
+        // taken from the shared ones when needed, so the table survives Sampler::clear_cache().
+        TextureTable(const unsigned int width, const unsigned int height, const unsigned int capacity,
+                const PixelFormat format = PixelFormat::RGBA8, const SamplerDescriptor& sampler = {});
+
+        // Must be destroyed with the GL context still current.
+        ~TextureTable();
+
+        TextureTable(const TextureTable&) = delete;
+        TextureTable& operator=(const TextureTable&) = delete;
+
+        // Add a texture made from the image, with mipmaps generated on the CPU. Returns its index. Throws if the table
+        // is full or the image differs in size or format.
+        unsigned int add(const ImageView& image);
+
+        // GLSL code declaring uniforms used by bind() and this function:
+        //   vec4 ogf_texture_table_sample(uint index, vec2 uv) - sample the texture of given index.
+        // The code depends on the path taken, paste it into shaders right after the #version line. On the bindless path
+        // the index has to be dynamically uniform, e.g. gl_DrawID of a multi-draw, unless the GPU has NV_gpu_shader5.
+        const char* glsl_source() const noexcept;
+
+        // Bind the handle buffer to the uniform block binding, or the texture array to the texture unit, and set the
+        // uniforms declared by glsl_source(). The shader must be in use.
+        void bind(Shader& shader, const unsigned int binding) const;
+
+        bool is_bindless() const noexcept;
+
+        unsigned int size() const noexcept;
+
+    private:
+        struct Impl;
+        std::unique_ptr<Impl> m_impl{};
+    };
+
+}
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace ogf {
+
+    class Image;
+    class Texture;
+
+    // Uploads images to textures through a ring of pixel buffer memory, so the driver copies them asynchronously and
+    // the render loop doesn't stall on big uploads. Every frame at most the byte budget is handed to OpenGL; big
+    // textures are spread over several frames, a band of rows at a time. The staging memory is mapped persistently when
+    // the context supports buffer storage (OpenGL 4.4 or ARB_buffer_storage), otherwise each band is mapped
+    // unsynchronized. Fences keep the ring from overwriting bands the GPU is still reading.
+    class TextureUploader {
+    public:
+        explicit TextureUploader(const std::size_t staging_size = 32 * 1024 * 1024,
+                const std::size_t frame_budget = 8 * 1024 * 1024);
+
+        // Waits for the GPU to finish reading the staging memory. Must be destroyed with the GL context still current.
+        ~TextureUploader();
+
+        TextureUploader(const TextureUploader&) = delete;
+        TextureUploader& operator=(const TextureUploader&) = delete;
+
+        // Create the texture storage right away and queue the image with its mipmaps, e.g. from generate_mipmaps(). The
+        // pixels are uploaded by the following update() calls, the texture must not be freed or recreated until
+        // pending_bytes() drops to zero. Images are moved in to avoid a copy.
+        void upload(Texture& texture, Image image, std::vector<Image> mipmaps = {});
+
+        // Recycle staging memory the GPU is done with and upload the next bands of queued images. Call once per frame
+        // from a thread with a GL context.
+        void update();
+
+        // Pixel bytes queued but not yet handed to OpenGL.
+        std::size_t pending_bytes() const noexcept;
+
+    private:
+        struct Impl;
+        std::unique_ptr<Impl> m_impl{};
+    };
+
+}
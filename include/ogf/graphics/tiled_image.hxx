@@ -0,0 +1,62 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <tuple>
+
+#include <ogf/graphics/color.hxx>
+#include <ogf/graphics/image.hxx>
+#include <ogf/graphics/pixel_format.hxx>
+#include <ogf/math/rect.hxx>
+
+namespace ogf {
+
+    // Image too big to be kept in memory, e.g. a gigapixel scan, stored in a tile cache file as square tiles. Tiles are
+    // read in when they're accessed and the least recently used ones are dropped when the tiles in memory take more
+    // than the memory budget. Tiles can be processed or uploaded one by one, e.g. with Texture::update().
+    class TiledImage {
+    public:
+        // Decode a PNG or baseline JPEG file row by row into a tile cache file. Only one row of tiles is kept in
+        // memory. Pixels keep the format Image::load_from_file() would give them. Interlaced PNG and progressive JPEG
+        // files can't be decoded this way.
+        static void build_tile_cache(const std::string_view image_filename, const std::string_view cache_filename,
+                const unsigned int tile_size = 256);
+
+        explicit TiledImage(const std::size_t memory_budget = 256 * 1024 * 1024);
+        ~TiledImage();
+
+        TiledImage(const TiledImage&) = delete;
+        TiledImage& operator=(const TiledImage&) = delete;
+
+        // Map a tile cache file. Throws if it can't be opened or is corrupted.
+        void open(const std::string_view cache_filename);
+
+        // Get a tile, reading it from the file unless it's in memory. Tiles on the right and bottom edge are cut to the
+        // image size. Throws std::out_of_range for tiles outside the image. Thread-safe.
+        std::shared_ptr<const Image> tile(const unsigned int tile_x, const unsigned int tile_y);
+
+        // Copy an area of the image into a new image, reading the tiles it covers. Throws std::out_of_range if the
+        // area isn't inside the image. Thread-safe.
+        Image read(const RectU& area);
+
+        // Throws std::out_of_range for pixels outside the image. Thread-safe.
+        Color pixel(const unsigned int x, const unsigned int y);
+
+        std::tuple<unsigned int, unsigned int> size() const noexcept;
+
+        std::tuple<unsigned int, unsigned int> tile_count() const noexcept;
+
+        unsigned int tile_size() const noexcept;
+
+        PixelFormat format() const noexcept;
+
+        // Memory taken by the tiles kept by the cache.
+        std::size_t memory_usage() const;
+
+    private:
+        struct Impl;
+        std::unique_ptr<Impl> m_impl{};
+    };
+
+}
@@ -0,0 +1,91 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <string>
+
+#include <ogf/graphics/image_view.hxx>
+#include <ogf/types.hxx>
+
+namespace ogf {
+
+    class Shader;
+    class TiledImage;
+
+    // Low resolution render target the scene is drawn into with the feedback shader. Its contents tell which tiles of a
+    // virtual texture are visible. The pixels are read back asynchronously, a few frames later.
+    class VirtualTextureFeedback {
+    public:
+        VirtualTextureFeedback(const unsigned int width, const unsigned int height);
+        ~VirtualTextureFeedback();
+
+        VirtualTextureFeedback(const VirtualTextureFeedback&) = delete;
+        VirtualTextureFeedback& operator=(const VirtualTextureFeedback&) = delete;
+
+        // Bind the render target and clear it. Draw the scene with ogf_vt_feedback() as the fragment output and
+        // blending disabled between begin() and end().
+        void begin();
+
+        // Restore the previous render target and start reading the pixels back.
+        void end();
+
+    private:
+        friend class VirtualTexture;
+
+        // Get the newest finished readback as RGBA pixels. Returns false if none is ready yet. Never blocks.
+        bool read(const Uint8*& pixels, std::size_t& count);
+
+        struct Impl;
+        std::unique_ptr<Impl> m_impl{};
+    };
+
+    // Texture too big to keep in memory, split into square tiles stored on disk. Only the tiles visible on screen are
+    // kept in a cache texture on the GPU, and an indirection texture tells the shader where each tile is. Coarser
+    // levels of the same area are used until the visible ones are loaded. Works with plain OpenGL 3.3.
+    class VirtualTexture {
+    public:
+        // GLSL code declaring uniforms used by bind() and these functions:
+        //   vec4 ogf_vt_sample(vec2 uv)   - sample the virtual texture,
+        //   vec4 ogf_vt_feedback(vec2 uv) - value to write into VirtualTextureFeedback.
+        // Paste it into fragment shaders after the #version line.
+        static const char* const GLSL_SOURCE;
+
+        // Split the image into a tile store file with all mipmap levels, converted to RGBA8. Each tile is tile_size
+        // pixels wide and is surrounded by a border of neighbouring pixels, so it can be filtered without seams. The
+        // image is processed one band of tile rows at a time and every level is averaged from the rows of the one
+        // above as they pass, so besides the image itself the builder needs only about tile_size + 2 * border rows of
+        // RGBA8 pixels per level, i.e. 8 * (tile_size + 2 * border) bytes per pixel of width in total.
+        static void build_tile_store(const ImageView& image, const std::string_view filename,
+                const unsigned int tile_size = 128, const unsigned int border = 4);
+
+        // Build a tile store from an image which doesn't fit in memory, reading it one row of its tiles at a time.
+        static void build_tile_store(TiledImage& image, const std::string_view filename,
+                const unsigned int tile_size = 128, const unsigned int border = 4);
+
+        VirtualTexture() noexcept;
+        ~VirtualTexture();
+
+        VirtualTexture(const VirtualTexture&) = delete;
+        VirtualTexture& operator=(const VirtualTexture&) = delete;
+
+        // Open a tile store and create the GPU textures. The cache holds cache_size x cache_size tiles, at most 255.
+        // Must be called from a thread with a GL context.
+        void open(const std::string_view filename, const unsigned int cache_size = 16);
+
+        void close();
+
+        // Process finished feedback readbacks and tile reads, upload up to max_uploads tiles and request missing ones.
+        // Call once per frame from a thread with a GL context.
+        void update(VirtualTextureFeedback& feedback, const unsigned int max_uploads = 16);
+
+        // Bind the textures to given units and set the uniforms declared by GLSL_SOURCE. The shader must be in use.
+        // feedback_scale is the ratio of the feedback buffer size to the screen size, e.g. 0.125.
+        void bind(Shader& shader, const unsigned int indirection_unit, const unsigned int cache_unit,
+                const float feedback_scale = 1.0f) const;
+
+    private:
+        struct Impl;
+        std::unique_ptr<Impl> m_impl{};
+    };
+
+}
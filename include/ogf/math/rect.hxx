@@ -0,0 +1,68 @@
+#pragma once
+
+namespace ogf {
+
+    template<typename T>
+    class Rect {
+    public:
+        // Create an empty rectangle at {0, 0}.
+        constexpr Rect() noexcept = default;
+
+        // Construct the rectangle from its top-left corner and size.
+        constexpr Rect(const T left, const T top, const T width, const T height) noexcept;
+
+        // Construct the rectangle from another type of rectangle. This constructor doesn't replace copy constructor,
+        // because it's only called when U != T.
+        template<typename U>
+        constexpr Rect(const Rect<U>& other) noexcept;
+
+        // Check if two rectangles overlap. Touching edges don't count as overlap.
+        constexpr bool intersects(const Rect& other) const noexcept;
+
+        T left{};
+        T top{};
+        T width{};
+        T height{};
+    };
+
+    using RectI = Rect<int>;
+    using RectU = Rect<unsigned int>;
+    using RectF = Rect<float>;
+
+    template<typename T>
+    constexpr bool operator==(const Rect<T>& left, const Rect<T>& right) noexcept;
+    template<typename T>
+    constexpr bool operator!=(const Rect<T>& left, const Rect<T>& right) noexcept;
+
+    // Implementation.
+
+    template<typename T>
+    constexpr Rect<T>::Rect(const T left, const T top, const T width, const T height) noexcept
+            : left{left}, top{top}, width{width}, height{height} {
+    }
+
+    template<typename T>
+    template<typename U>
+    constexpr Rect<T>::Rect(const Rect<U>& other) noexcept
+            : left{static_cast<T>(other.left)}, top{static_cast<T>(other.top)}, width{static_cast<T>(other.width)},
+            height{static_cast<T>(other.height)} {
+    }
+
+    template<typename T>
+    constexpr bool Rect<T>::intersects(const Rect& other) const noexcept {
+        return left < other.left + other.width && other.left < left + width
+                && top < other.top + other.height && other.top < top + height;
+    }
+
+    template<typename T>
+    constexpr bool operator==(const Rect<T>& left, const Rect<T>& right) noexcept {
+        return left.left == right.left && left.top == right.top && left.width == right.width
+                && left.height == right.height;
+    }
+
+    template<typename T>
+    constexpr bool operator!=(const Rect<T>& left, const Rect<T>& right) noexcept {
+        return !(left == right);
+    }
+
+}
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <cstddef>
+#include <new>
+
+namespace ogf {
+
+    // Allocator returning memory aligned to given number of bytes, e.g. to a cache line for SIMD code.
+    template<typename T, std::size_t Alignment>
+    class AlignedAllocator {
+    public:
+        using value_type = T;
+
+        template<typename U>
+        struct rebind {
+            using other = AlignedAllocator<U, Alignment>;
+        };
+
+        constexpr AlignedAllocator() noexcept = default;
+
+        template<typename U>
+        constexpr AlignedAllocator(const AlignedAllocator<U, Alignment>&) noexcept {
+        }
+
+        T* allocate(const std::size_t count) {
+            return static_cast<T*>(::operator new(count * sizeof(T), std::align_val_t{Alignment}));
+        }
+
+        void deallocate(T* pointer, const std::size_t) noexcept {
+            ::operator delete(pointer, std::align_val_t{Alignment});
+        }
+
+        template<typename U>
+        constexpr bool operator==(const AlignedAllocator<U, Alignment>&) const noexcept {
+            return true;
+        }
+
+        template<typename U>
+        constexpr bool operator!=(const AlignedAllocator<U, Alignment>&) const noexcept {
+            return false;
+        }
+    };
+
+}
@@ -0,0 +1,593 @@
+#include <ogf/graphics/block_compression.hxx>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+
+#if defined(__SSE__) || defined(_M_X64)
+#define OGF_BLOCK_COMPRESSION_SSE
+#include <xmmintrin.h>
+#endif
+
+namespace ogf {
+
+    namespace {
+
+        using Float4 = std::array<float, 4>;
+
+        constexpr std::size_t BLOCK_PIXELS = 16;
+
+        // Interpolation weights of 4-bit BC7 indices, out of 64.
+        constexpr std::array<int, 16> BC7_WEIGHTS{0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64};
+
+        float squared_distance(const Float4& left, const Float4& right) {
+            float sum{0.0f};
+            for(std::size_t c = 0; c < 4; ++c) {
+                sum += (left[c] - right[c]) * (left[c] - right[c]);
+            }
+            return sum;
+        }
+
+        // Pick the nearest palette entry for every point and return the total squared error. The palette size must be
+        // a multiple of four. This is the hot loop of all encoders: with SSE four palette entries are measured at once.
+        float select_indices(const Float4* points, const Float4* palette, const std::size_t palette_size,
+                Uint8* indices) {
+            float total_error{0.0f};
+            for(std::size_t i = 0; i < BLOCK_PIXELS; ++i) {
+                float best_error{std::numeric_limits<float>::max()};
+                Uint8 best_index{0};
+#if defined(OGF_BLOCK_COMPRESSION_SSE)
+                const auto point = _mm_loadu_ps(points[i].data());
+                for(std::size_t base = 0; base < palette_size; base += 4) {
+                    auto d0 = _mm_sub_ps(point, _mm_loadu_ps(palette[base].data()));
+                    auto d1 = _mm_sub_ps(point, _mm_loadu_ps(palette[base + 1].data()));
+                    auto d2 = _mm_sub_ps(point, _mm_loadu_ps(palette[base + 2].data()));
+                    auto d3 = _mm_sub_ps(point, _mm_loadu_ps(palette[base + 3].data()));
+                    d0 = _mm_mul_ps(d0, d0);
+                    d1 = _mm_mul_ps(d1, d1);
+                    d2 = _mm_mul_ps(d2, d2);
+                    d3 = _mm_mul_ps(d3, d3);
+                    // After the transpose every register holds one channel of the four distances.
+                    _MM_TRANSPOSE4_PS(d0, d1, d2, d3);
+                    const auto distances = _mm_add_ps(_mm_add_ps(d0, d1), _mm_add_ps(d2, d3));
+                    alignas(16) float values[4];
+                    _mm_store_ps(values, distances);
+                    for(std::size_t k = 0; k < 4; ++k) {
+                        if(values[k] < best_error) {
+                            best_error = values[k];
+                            best_index = static_cast<Uint8>(base + k);
+                        }
+                    }
+                }
+#else
+                for(std::size_t k = 0; k < palette_size; ++k) {
+                    const auto error = squared_distance(points[i], palette[k]);
+                    if(error < best_error) {
+                        best_error = error;
+                        best_index = static_cast<Uint8>(k);
+                    }
+                }
+#endif
+                indices[i] = best_index;
+                total_error += best_error;
+            }
+            return total_error;
+        }
+
+        // Find the line which fits the points best: it goes through the mean along the principal axis. Only the first
+        // `channels` components are taken into account.
+        void fit_line(const Float4* points, const std::size_t count, const std::size_t channels, Float4& start,
+                Float4& end, const CompressionQuality quality) {
+            Float4 minimum{}, maximum{};
+            minimum.fill(std::numeric_limits<float>::max());
+            maximum.fill(std::numeric_limits<float>::lowest());
+            Float4 mean{};
+            for(std::size_t i = 0; i < count; ++i) {
+                for(std::size_t c = 0; c < channels; ++c) {
+                    minimum[c] = std::min(minimum[c], points[i][c]);
+                    maximum[c] = std::max(maximum[c], points[i][c]);
+                    mean[c] += points[i][c] / count;
+                }
+            }
+            if(quality == CompressionQuality::FAST) {
+                // Use the diagonal of the bounding box. Channels which fall while the widest one rises go the other
+                // way along it.
+                std::size_t widest{0};
+                for(std::size_t c = 1; c < channels; ++c) {
+                    if(maximum[c] - minimum[c] > maximum[widest] - minimum[widest]) {
+                        widest = c;
+                    }
+                }
+                for(std::size_t c = 0; c < channels; ++c) {
+                    float covariance{0.0f};
+                    for(std::size_t i = 0; i < count; ++i) {
+                        covariance += (points[i][c] - mean[c]) * (points[i][widest] - mean[widest]);
+                    }
+                    // Inset the box a little, the extremes are rarely hit exactly after quantization.
+                    const auto inset = (maximum[c] - minimum[c]) / 16.0f;
+                    start[c] = maximum[c] - inset;
+                    end[c] = minimum[c] + inset;
+                    if(covariance < 0.0f) {
+                        std::swap(start[c], end[c]);
+                    }
+                }
+                return;
+            }
+            std::array<float, 16> covariance{};
+            for(std::size_t i = 0; i < count; ++i) {
+                for(std::size_t a = 0; a < channels; ++a) {
+                    for(std::size_t b = 0; b < channels; ++b) {
+                        covariance[a * 4 + b] += (points[i][a] - mean[a]) * (points[i][b] - mean[b]);
+                    }
+                }
+            }
+            // Power iteration, started from the diagonal of the bounding box.
+            Float4 axis{};
+            for(std::size_t c = 0; c < channels; ++c) {
+                axis[c] = maximum[c] - minimum[c];
+            }
+            for(int iteration = 0; iteration < 8; ++iteration) {
+                Float4 next{};
+                float length{0.0f};
+                for(std::size_t a = 0; a < channels; ++a) {
+                    for(std::size_t b = 0; b < channels; ++b) {
+                        next[a] += covariance[a * 4 + b] * axis[b];
+                    }
+                    length += next[a] * next[a];
+                }
+                if(length < 1e-12f) {
+                    break;
+                }
+                length = std::sqrt(length);
+                for(std::size_t c = 0; c < channels; ++c) {
+                    axis[c] = next[c] / length;
+                }
+            }
+            float low{std::numeric_limits<float>::max()}, high{std::numeric_limits<float>::lowest()};
+            for(std::size_t i = 0; i < count; ++i) {
+                float t{0.0f};
+                for(std::size_t c = 0; c < channels; ++c) {
+                    t += (points[i][c] - mean[c]) * axis[c];
+                }
+                low = std::min(low, t);
+                high = std::max(high, t);
+            }
+            for(std::size_t c = 0; c < channels; ++c) {
+                start[c] = std::clamp(mean[c] + axis[c] * high, 0.0f, 255.0f);
+                end[c] = std::clamp(mean[c] + axis[c] * low, 0.0f, 255.0f);
+            }
+        }
+
+        // Least squares endpoints for fixed indices. weights[i] is the weight of the start endpoint for index i.
+        bool refine_endpoints(const Float4* points, const Uint8* indices, const float* weights,
+                const std::size_t channels, Float4& start, Float4& end) {
+            float aa{0.0f}, ab{0.0f}, bb{0.0f};
+            Float4 ax{}, bx{};
+            for(std::size_t i = 0; i < BLOCK_PIXELS; ++i) {
+                const auto alpha = weights[indices[i]];
+                const auto beta = 1.0f - alpha;
+                aa += alpha * alpha;
+                ab += alpha * beta;
+                bb += beta * beta;
+                for(std::size_t c = 0; c < channels; ++c) {
+                    ax[c] += alpha * points[i][c];
+                    bx[c] += beta * points[i][c];
+                }
+            }
+            const auto determinant = aa * bb - ab * ab;
+            if(std::abs(determinant) < 1e-6f) {
+                return false;
+            }
+            for(std::size_t c = 0; c < channels; ++c) {
+                start[c] = std::clamp((bb * ax[c] - ab * bx[c]) / determinant, 0.0f, 255.0f);
+                end[c] = std::clamp((aa * bx[c] - ab * ax[c]) / determinant, 0.0f, 255.0f);
+            }
+            return true;
+        }
+
+        int refinement_iterations(const CompressionQuality quality) {
+            switch(quality) {
+                case CompressionQuality::FAST: return 0;
+                case CompressionQuality::NORMAL: return 1;
+                case CompressionQuality::HIGH: return 4;
+            }
+            return 0;
+        }
+
+        void load_points(const Uint8* pixels, Float4* points) {
+            for(std::size_t i = 0; i < BLOCK_PIXELS; ++i) {
+                for(std::size_t c = 0; c < 4; ++c) {
+                    points[i][c] = pixels[i * 4 + c];
+                }
+            }
+        }
+
+        // BC1.
+
+        Uint16 pack_565(const Float4& color) {
+            const auto r = static_cast<Uint16>(std::lround(std::clamp(color[0], 0.0f, 255.0f) * 31.0f / 255.0f));
+            const auto g = static_cast<Uint16>(std::lround(std::clamp(color[1], 0.0f, 255.0f) * 63.0f / 255.0f));
+            const auto b = static_cast<Uint16>(std::lround(std::clamp(color[2], 0.0f, 255.0f) * 31.0f / 255.0f));
+            return static_cast<Uint16>(r << 11 | g << 5 | b);
+        }
+
+        Float4 unpack_565(const Uint16 color) {
+            const auto r = (color >> 11) & 31;
+            const auto g = (color >> 5) & 63;
+            const auto b = color & 31;
+            return {static_cast<float>(r << 3 | r >> 2), static_cast<float>(g << 2 | g >> 4),
+                    static_cast<float>(b << 3 | b >> 2), 0.0f};
+        }
+
+        // Palette of the four color mode, in index order. With three colors the last entry is transparent black.
+        std::array<Float4, 4> bc1_palette(const Uint16 color0, const Uint16 color1) {
+            const auto c0 = unpack_565(color0);
+            const auto c1 = unpack_565(color1);
+            std::array<Float4, 4> palette{c0, c1, {}, {}};
+            for(std::size_t c = 0; c < 3; ++c) {
+                if(color0 > color1) {
+                    palette[2][c] = std::floor((2.0f * c0[c] + c1[c]) / 3.0f);
+                    palette[3][c] = std::floor((c0[c] + 2.0f * c1[c]) / 3.0f);
+                } else {
+                    palette[2][c] = std::floor((c0[c] + c1[c]) / 2.0f);
+                    // Keeps the transparent entry away from any opaque color.
+                    palette[3][c] = std::numeric_limits<float>::max() / 8.0f;
+                }
+            }
+            return palette;
+        }
+
+        void write_bc1(Uint8* output, const Uint16 color0, const Uint16 color1, const Uint8* indices) {
+            Uint32 bits{0};
+            for(std::size_t i = 0; i < BLOCK_PIXELS; ++i) {
+                bits |= static_cast<Uint32>(indices[i]) << (i * 2);
+            }
+            output[0] = static_cast<Uint8>(color0);
+            output[1] = static_cast<Uint8>(color0 >> 8);
+            output[2] = static_cast<Uint8>(color1);
+            output[3] = static_cast<Uint8>(color1 >> 8);
+            for(std::size_t i = 0; i < 4; ++i) {
+                output[4 + i] = static_cast<Uint8>(bits >> (i * 8));
+            }
+        }
+
+        // Encode colors of the block. If punch_through is true, pixels with alpha below 128 become transparent, which
+        // needs the three color mode.
+        void encode_bc1_colors(const Uint8* pixels, Uint8* output, const CompressionQuality quality,
+                const bool punch_through) {
+            std::array<Float4, BLOCK_PIXELS> points{};
+            load_points(pixels, points.data());
+            std::array<bool, BLOCK_PIXELS> transparent{};
+            std::array<Float4, BLOCK_PIXELS> opaque_points{};
+            std::size_t opaque_count{0};
+            for(std::size_t i = 0; i < BLOCK_PIXELS; ++i) {
+                transparent[i] = punch_through && pixels[i * 4 + 3] < 128;
+                // Alpha doesn't take part in the color search.
+                points[i][3] = 0.0f;
+                if(!transparent[i]) {
+                    opaque_points[opaque_count++] = points[i];
+                }
+            }
+            std::array<Uint8, BLOCK_PIXELS> indices{};
+            if(opaque_count == 0) {
+                indices.fill(3);
+                write_bc1(output, 0, 0, indices.data());
+                return;
+            }
+            Float4 start{}, end{};
+            fit_line(opaque_points.data(), opaque_count, 3, start, end, quality);
+
+            if(opaque_count < BLOCK_PIXELS) {
+                // Three color mode requires color0 <= color1.
+                auto color0 = pack_565(start);
+                auto color1 = pack_565(end);
+                if(color0 > color1) {
+                    std::swap(color0, color1);
+                }
+                auto palette = bc1_palette(color0, color1);
+                select_indices(points.data(), palette.data(), palette.size(), indices.data());
+                for(std::size_t i = 0; i < BLOCK_PIXELS; ++i) {
+                    if(transparent[i]) {
+                        indices[i] = 3;
+                    }
+                }
+                write_bc1(output, color0, color1, indices.data());
+                return;
+            }
+
+            constexpr std::array<float, 4> weights{1.0f, 0.0f, 2.0f / 3.0f, 1.0f / 3.0f};
+            std::array<Uint8, BLOCK_PIXELS> best_indices{};
+            Uint16 best_color0{0}, best_color1{0};
+            float best_error{std::numeric_limits<float>::max()};
+            for(int iteration = 0; iteration <= refinement_iterations(quality); ++iteration) {
+                auto color0 = pack_565(start);
+                auto color1 = pack_565(end);
+                if(color0 < color1) {
+                    std::swap(color0, color1);
+                }
+                float error{};
+                if(color0 == color1) {
+                    // Equal endpoints switch to the three color mode, where only the first entry is safe to use.
+                    indices.fill(0);
+                    const auto color = unpack_565(color0);
+                    error = 0.0f;
+                    for(const auto& point : points) {
+                        error += squared_distance(point, color);
+                    }
+                } else {
+                    const auto palette = bc1_palette(color0, color1);
+                    error = select_indices(points.data(), palette.data(), palette.size(), indices.data());
+                }
+                if(error < best_error) {
+                    best_error = error;
+                    best_indices = indices;
+                    best_color0 = color0;
+                    best_color1 = color1;
+                }
+                if(error == 0.0f || !refine_endpoints(points.data(), indices.data(), weights.data(), 3, start, end)) {
+                    break;
+                }
+            }
+            write_bc1(output, best_color0, best_color1, best_indices.data());
+        }
+
+        // BC4.
+
+        std::array<float, 8> bc4_palette(const int value0, const int value1) {
+            std::array<float, 8> palette{static_cast<float>(value0), static_cast<float>(value1)};
+            if(value0 > value1) {
+                for(int i = 1; i < 7; ++i) {
+                    palette[i + 1] = static_cast<float>(((7 - i) * value0 + i * value1) / 7);
+                }
+            } else {
+                for(int i = 1; i < 5; ++i) {
+                    palette[i + 1] = static_cast<float>(((5 - i) * value0 + i * value1) / 5);
+                }
+                palette[6] = 0.0f;
+                palette[7] = 255.0f;
+            }
+            return palette;
+        }
+
+        float bc4_indices(const std::array<float, BLOCK_PIXELS>& values, const int value0, const int value1,
+                std::array<Uint8, BLOCK_PIXELS>& indices) {
+            const auto palette = bc4_palette(value0, value1);
+            float total_error{0.0f};
+            for(std::size_t i = 0; i < BLOCK_PIXELS; ++i) {
+                float best_error{std::numeric_limits<float>::max()};
+                for(std::size_t k = 0; k < palette.size(); ++k) {
+                    const auto error = (values[i] - palette[k]) * (values[i] - palette[k]);
+                    if(error < best_error) {
+                        best_error = error;
+                        indices[i] = static_cast<Uint8>(k);
+                    }
+                }
+                total_error += best_error;
+            }
+            return total_error;
+        }
+
+        void encode_bc4_channel(const Uint8* pixels, const std::size_t channel, Uint8* output,
+                const CompressionQuality quality) {
+            std::array<float, BLOCK_PIXELS> values{};
+            int minimum{255}, maximum{0};
+            // Extremes without 0 and 255, which the six value mode gets for free.
+            int inner_minimum{255}, inner_maximum{0};
+            for(std::size_t i = 0; i < BLOCK_PIXELS; ++i) {
+                const int value = pixels[i * 4 + channel];
+                values[i] = static_cast<float>(value);
+                minimum = std::min(minimum, value);
+                maximum = std::max(maximum, value);
+                if(value != 0 && value != 255) {
+                    inner_minimum = std::min(inner_minimum, value);
+                    inner_maximum = std::max(inner_maximum, value);
+                }
+            }
+            std::array<Uint8, BLOCK_PIXELS> indices{}, best_indices{};
+            int best_value0{maximum}, best_value1{minimum};
+            float best_error{std::numeric_limits<float>::max()};
+            const auto try_endpoints = [&](const int value0, const int value1) {
+                const auto error = bc4_indices(values, value0, value1, indices);
+                if(error < best_error) {
+                    best_error = error;
+                    best_indices = indices;
+                    best_value0 = value0;
+                    best_value1 = value1;
+                }
+            };
+            if(maximum == minimum) {
+                try_endpoints(maximum, minimum);
+            } else {
+                const auto range = quality == CompressionQuality::FAST ? 0
+                        : quality == CompressionQuality::NORMAL ? 2 : 4;
+                for(int high = maximum; high >= std::max(maximum - range, minimum + 1); --high) {
+                    for(int low = minimum; low <= std::min(minimum + range, high - 1); ++low) {
+                        try_endpoints(high, low);
+                    }
+                }
+                if(quality == CompressionQuality::HIGH && inner_minimum <= inner_maximum) {
+                    try_endpoints(inner_minimum, inner_maximum);
+                }
+            }
+            output[0] = static_cast<Uint8>(best_value0);
+            output[1] = static_cast<Uint8>(best_value1);
+            Uint64 bits{0};
+            for(std::size_t i = 0; i < BLOCK_PIXELS; ++i) {
+                bits |= static_cast<Uint64>(best_indices[i]) << (i * 3);
+            }
+            for(std::size_t i = 0; i < 6; ++i) {
+                output[2 + i] = static_cast<Uint8>(bits >> (i * 8));
+            }
+        }
+
+        // BC7, mode 6: one subset, RGBA endpoints with 7 bits and a shared p-bit each, 4-bit indices.
+
+        struct Bc7Endpoints {
+            std::array<int, 4> start{};
+            std::array<int, 4> end{};
+            int                start_pbit{};
+            int                end_pbit{};
+        };
+
+        std::array<int, 4> quantize_bc7(const Float4& color, const int pbit) {
+            std::array<int, 4> result{};
+            for(std::size_t c = 0; c < 4; ++c) {
+                result[c] = std::clamp(static_cast<int>(std::lround((color[c] - pbit) / 2.0f)), 0, 127);
+            }
+            return result;
+        }
+
+        float quantization_error(const Float4& color, const std::array<int, 4>& quantized, const int pbit) {
+            float error{0.0f};
+            for(std::size_t c = 0; c < 4; ++c) {
+                const auto value = static_cast<float>(quantized[c] * 2 + pbit);
+                error += (value - color[c]) * (value - color[c]);
+            }
+            return error;
+        }
+
+        std::array<Float4, 16> bc7_palette(const Bc7Endpoints& endpoints) {
+            std::array<Float4, 16> palette{};
+            for(std::size_t i = 0; i < palette.size(); ++i) {
+                for(std::size_t c = 0; c < 4; ++c) {
+                    const auto start = endpoints.start[c] * 2 + endpoints.start_pbit;
+                    const auto end = endpoints.end[c] * 2 + endpoints.end_pbit;
+                    palette[i][c] = static_cast<float>(((64 - BC7_WEIGHTS[i]) * start + BC7_WEIGHTS[i] * end + 32)
+                            >> 6);
+                }
+            }
+            return palette;
+        }
+
+        class BitWriter {
+        public:
+            explicit BitWriter(Uint8* output) noexcept
+                    : m_output{output} {
+                std::fill(m_output, m_output + 16, Uint8{0});
+            }
+
+            void write(const unsigned int value, const unsigned int bits) noexcept {
+                for(unsigned int i = 0; i < bits; ++i) {
+                    if(value >> i & 1) {
+                        m_output[m_position / 8] |= static_cast<Uint8>(1 << (m_position % 8));
+                    }
+                    ++m_position;
+                }
+            }
+
+        private:
+            Uint8*       m_output{nullptr};
+            unsigned int m_position{0};
+        };
+
+    }
+
+    void encode_bc1_block(const Uint8* pixels, Uint8* output, const CompressionQuality quality) {
+        encode_bc1_colors(pixels, output, quality, true);
+    }
+
+    void encode_bc3_block(const Uint8* pixels, Uint8* output, const CompressionQuality quality) {
+        encode_bc4_channel(pixels, 3, output, quality);
+        // The color part of BC3 is always decoded in the four color mode.
+        encode_bc1_colors(pixels, output + 8, quality, false);
+    }
+
+    void encode_bc4_block(const Uint8* pixels, Uint8* output, const CompressionQuality quality) {
+        encode_bc4_channel(pixels, 0, output, quality);
+    }
+
+    void encode_bc5_block(const Uint8* pixels, Uint8* output, const CompressionQuality quality) {
+        encode_bc4_channel(pixels, 0, output, quality);
+        encode_bc4_channel(pixels, 1, output + 8, quality);
+    }
+
+    void encode_bc7_block(const Uint8* pixels, Uint8* output, const CompressionQuality quality) {
+        std::array<Float4, BLOCK_PIXELS> points{};
+        load_points(pixels, points.data());
+        Float4 start{}, end{};
+        fit_line(points.data(), points.size(), 4, start, end, quality);
+
+        std::array<float, 16> weights{};
+        for(std::size_t i = 0; i < weights.size(); ++i) {
+            weights[i] = 1.0f - BC7_WEIGHTS[i] / 64.0f;
+        }
+        std::array<Uint8, BLOCK_PIXELS> indices{}, best_indices{};
+        Bc7Endpoints best_endpoints{};
+        float best_error{std::numeric_limits<float>::max()};
+        for(int iteration = 0; iteration <= refinement_iterations(quality); ++iteration) {
+            std::array<Bc7Endpoints, 4> candidates{};
+            std::size_t candidate_count{0};
+            if(quality == CompressionQuality::HIGH) {
+                for(int pbits = 0; pbits < 4; ++pbits) {
+                    auto& candidate = candidates[candidate_count++];
+                    candidate.start_pbit = pbits & 1;
+                    candidate.end_pbit = pbits >> 1;
+                    candidate.start = quantize_bc7(start, candidate.start_pbit);
+                    candidate.end = quantize_bc7(end, candidate.end_pbit);
+                }
+            } else {
+                // Choose each p-bit by its own quantization error only.
+                auto& candidate = candidates[candidate_count++];
+                const auto pick = [](const Float4& color, std::array<int, 4>& quantized, int& pbit) {
+                    const auto zero = quantize_bc7(color, 0);
+                    const auto one = quantize_bc7(color, 1);
+                    pbit = quantization_error(color, one, 1) < quantization_error(color, zero, 0) ? 1 : 0;
+                    quantized = pbit == 1 ? one : zero;
+                };
+                pick(start, candidate.start, candidate.start_pbit);
+                pick(end, candidate.end, candidate.end_pbit);
+            }
+            for(std::size_t i = 0; i < candidate_count; ++i) {
+                const auto palette = bc7_palette(candidates[i]);
+                const auto error = select_indices(points.data(), palette.data(), palette.size(), indices.data());
+                if(error < best_error) {
+                    best_error = error;
+                    best_indices = indices;
+                    best_endpoints = candidates[i];
+                }
+            }
+            if(best_error == 0.0f
+                    || !refine_endpoints(points.data(), best_indices.data(), weights.data(), 4, start, end)) {
+                break;
+            }
+        }
+
+        // The highest bit of the first index isn't stored, so it must be zero.
+        if(best_indices[0] >= 8) {
+            std::swap(best_endpoints.start, best_endpoints.end);
+            std::swap(best_endpoints.start_pbit, best_endpoints.end_pbit);
+            for(auto& index : best_indices) {
+                index = static_cast<Uint8>(15 - index);
+            }
+        }
+        BitWriter writer{output};
+        writer.write(1 << 6, 7);
+        for(std::size_t c = 0; c < 4; ++c) {
+            writer.write(static_cast<unsigned int>(best_endpoints.start[c]), 7);
+            writer.write(static_cast<unsigned int>(best_endpoints.end[c]), 7);
+        }
+        writer.write(static_cast<unsigned int>(best_endpoints.start_pbit), 1);
+        writer.write(static_cast<unsigned int>(best_endpoints.end_pbit), 1);
+        writer.write(best_indices[0], 3);
+        for(std::size_t i = 1; i < BLOCK_PIXELS; ++i) {
+            writer.write(best_indices[i], 4);
+        }
+    }
+
+    unsigned int block_size(const CompressionFormat format) noexcept {
+        switch(format) {
+            case CompressionFormat::BC1:
+            case CompressionFormat::BC4: {
+                return 8;
+            }
+            case CompressionFormat::BC3:
+            case CompressionFormat::BC5:
+            case CompressionFormat::BC7: {
+                return 16;
+            }
+        }
+        return 16;
+    }
+
+}
@@ -0,0 +1,19 @@
+#pragma once
+
+#include <ogf/graphics/compressed_image.hxx>
+#include <ogf/types.hxx>
+
+namespace ogf {
+
+    // Encoders of single 4x4 blocks. Input is always 16 RGBA pixels, row by row. BC4 encodes the red channel and BC5
+    // the red and green channels.
+    void encode_bc1_block(const Uint8* pixels, Uint8* output, const CompressionQuality quality);
+    void encode_bc3_block(const Uint8* pixels, Uint8* output, const CompressionQuality quality);
+    void encode_bc4_block(const Uint8* pixels, Uint8* output, const CompressionQuality quality);
+    void encode_bc5_block(const Uint8* pixels, Uint8* output, const CompressionQuality quality);
+    void encode_bc7_block(const Uint8* pixels, Uint8* output, const CompressionQuality quality);
+
+    // Bytes taken by one 4x4 block.
+    unsigned int block_size(const CompressionFormat format) noexcept;
+
+}
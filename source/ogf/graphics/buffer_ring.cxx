@@ -0,0 +1,130 @@
+#include <ogf/graphics/buffer_ring.hxx>
+
+#include <algorithm>
+#include <numeric>
+#include <stdexcept>
+#include <vector>
+
+#include <glad/glad.h>
+
+#include <ogf/graphics/gl_extensions.hxx>
+
+namespace ogf {
+
+    struct BufferRing::Impl {
+        void bind(const GLenum target, const unsigned int binding, const Allocation& allocation);
+
+        GLuint              buffer{0};
+        Uint8*              mapping{nullptr};   // Persistent mapping, null when the data is staged.
+        std::vector<Uint8>  staging{};
+        std::size_t         alignment{};
+        std::size_t         frame_size{};
+        unsigned int        frame{0};
+        std::size_t         head{0};            // Where the next allocation goes, relative to the frame start.
+        std::vector<GLsync> fences{};           // Fence of each frame's last draw, null if there's none.
+    };
+
+    void BufferRing::Impl::bind(const GLenum target, const unsigned int binding, const Allocation& allocation) {
+        // Staged data is uploaded allocation by allocation, as others may not be written yet.
+        if(mapping == nullptr) {
+            glBindBuffer(target, buffer);
+            glBufferSubData(target, static_cast<GLintptr>(allocation.offset), static_cast<GLsizeiptr>(allocation.size),
+                    staging.data() + allocation.offset);
+        }
+        glBindBufferRange(target, binding, buffer, static_cast<GLintptr>(allocation.offset),
+                static_cast<GLsizeiptr>(allocation.size));
+    }
+
+    BufferRing::BufferRing(const std::size_t frame_size, const unsigned int frames) {
+        if(frame_size == 0 || frames == 0) {
+            throw std::runtime_error{"Failed to create buffer ring: the frame size and count must not be zero."};
+        }
+        GLint uniform_alignment{1}, storage_alignment{1};
+        glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &uniform_alignment);
+        if(has_shader_storage_buffers()) {
+            glGetIntegerv(GL_SHADER_STORAGE_BUFFER_OFFSET_ALIGNMENT, &storage_alignment);
+        }
+        m_impl = std::make_unique<Impl>();
+        auto& impl = *m_impl;
+        impl.alignment = std::lcm(static_cast<std::size_t>(std::max(uniform_alignment, 1)),
+                static_cast<std::size_t>(std::max(storage_alignment, 1)));
+        impl.frame_size = (frame_size + impl.alignment - 1) / impl.alignment * impl.alignment;
+        impl.fences.resize(frames, nullptr);
+        const auto size = static_cast<GLsizeiptr>(impl.frame_size * frames);
+        glGenBuffers(1, &impl.buffer);
+        glBindBuffer(GL_UNIFORM_BUFFER, impl.buffer);
+        const auto buffer_storage = gl_extension_functions().buffer_storage;
+        if(buffer_storage != nullptr) {
+            constexpr GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+            buffer_storage(GL_UNIFORM_BUFFER, size, nullptr, flags);
+            impl.mapping = static_cast<Uint8*>(glMapBufferRange(GL_UNIFORM_BUFFER, 0, size, flags));
+        } else {
+            glBufferData(GL_UNIFORM_BUFFER, size, nullptr, GL_STREAM_DRAW);
+            impl.staging.resize(static_cast<std::size_t>(size));
+        }
+        glBindBuffer(GL_UNIFORM_BUFFER, 0);
+        if(buffer_storage != nullptr && impl.mapping == nullptr) {
+            glDeleteBuffers(1, &impl.buffer);
+            throw std::runtime_error{"Failed to map buffer ring."};
+        }
+    }
+
+    BufferRing::~BufferRing() {
+        for(const auto fence : m_impl->fences) {
+            if(fence != nullptr) {
+                glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, GL_TIMEOUT_IGNORED);
+                glDeleteSync(fence);
+            }
+        }
+        if(m_impl->mapping != nullptr) {
+            glBindBuffer(GL_UNIFORM_BUFFER, m_impl->buffer);
+            glUnmapBuffer(GL_UNIFORM_BUFFER);
+            glBindBuffer(GL_UNIFORM_BUFFER, 0);
+        }
+        glDeleteBuffers(1, &m_impl->buffer);
+    }
+
+    BufferRing::Allocation BufferRing::allocate(const std::size_t size) {
+        auto& impl = *m_impl;
+        const auto aligned = (std::max<std::size_t>(size, 1) + impl.alignment - 1) / impl.alignment * impl.alignment;
+        if(aligned > impl.frame_size - impl.head) {
+            throw std::runtime_error{"Failed to allocate buffer ring memory: the frame has no space left."};
+        }
+        Allocation allocation{};
+        allocation.offset = impl.frame * impl.frame_size + impl.head;
+        allocation.size = size;
+        allocation.data = (impl.mapping != nullptr ? impl.mapping : impl.staging.data()) + allocation.offset;
+        impl.head += aligned;
+        return allocation;
+    }
+
+    void BufferRing::bind_uniform(const unsigned int binding, const Allocation& allocation) {
+        m_impl->bind(GL_UNIFORM_BUFFER, binding, allocation);
+    }
+
+    void BufferRing::bind_storage(const unsigned int binding, const Allocation& allocation) {
+        m_impl->bind(GL_SHADER_STORAGE_BUFFER, binding, allocation);
+    }
+
+    void BufferRing::next_frame() {
+        auto& impl = *m_impl;
+        impl.fences[impl.frame] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+        impl.frame = (impl.frame + 1) % static_cast<unsigned int>(impl.fences.size());
+        impl.head = 0;
+        auto& fence = impl.fences[impl.frame];
+        if(fence != nullptr) {
+            glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, GL_TIMEOUT_IGNORED);
+            glDeleteSync(fence);
+            fence = nullptr;
+        }
+    }
+
+    std::size_t BufferRing::frame_usage() const noexcept {
+        return m_impl->head;
+    }
+
+    unsigned int BufferRing::native_handle() const noexcept {
+        return m_impl->buffer;
+    }
+
+}
@@ -0,0 +1,61 @@
+#include <ogf/graphics/color32.hxx>
+
+#include <algorithm>
+#include <cmath>
+
+#include <ogf/graphics/pixel_conversion.hxx>
+
+namespace ogf {
+
+    // Bulk conversions treat colors as pixels.
+    static_assert(sizeof(Color) == 4 * sizeof(float), "Color must be laid out as an RGBA32F pixel.");
+    static_assert(sizeof(Color32) == 4, "Color32 must be laid out as an RGBA8 pixel.");
+
+    namespace {
+
+        Uint8 quantize(const float value) noexcept {
+            return static_cast<Uint8>(std::clamp(value, 0.0f, 1.0f) * 255.0f + 0.5f);
+        }
+
+    }
+
+    const Color32 Color32::BLACK{0, 0, 0, 255};
+    const Color32 Color32::WHITE{255, 255, 255, 255};
+
+    Color32::Color32(const Color& color) noexcept
+            : r{quantize(color.r)}, g{quantize(color.g)}, b{quantize(color.b)}, a{quantize(color.a)} {
+    }
+
+    Color Color32::to_color() const noexcept {
+        return Color{r / 255.0f, g / 255.0f, b / 255.0f, a / 255.0f};
+    }
+
+    void pack_colors(const Color* colors, Color32* packed, const std::size_t count) noexcept {
+        convert_pixels(reinterpret_cast<const Uint8*>(colors), PixelFormat::RGBA32F, reinterpret_cast<Uint8*>(packed),
+                PixelFormat::RGBA8, count);
+    }
+
+    void unpack_colors(const Color32* packed, Color* colors, const std::size_t count) noexcept {
+        convert_pixels(reinterpret_cast<const Uint8*>(packed), PixelFormat::RGBA8, reinterpret_cast<Uint8*>(colors),
+                PixelFormat::RGBA32F, count);
+    }
+
+    float srgb_to_linear(const float value) noexcept {
+        return value <= 0.04045f ? value / 12.92f : std::pow((value + 0.055f) / 1.055f, 2.4f);
+    }
+
+    float linear_to_srgb(const float value) noexcept {
+        return value <= 0.0031308f ? value * 12.92f : 1.055f * std::pow(value, 1.0f / 2.4f) - 0.055f;
+    }
+
+    void srgb_to_linear(const Color32* srgb, Color* linear, const std::size_t count) noexcept {
+        decode_srgb_pixels(reinterpret_cast<const Uint8*>(srgb), PixelFormat::RGBA8, reinterpret_cast<float*>(linear),
+                count);
+    }
+
+    void linear_to_srgb(const Color* linear, Color32* srgb, const std::size_t count) noexcept {
+        encode_srgb_pixels(reinterpret_cast<const float*>(linear), reinterpret_cast<Uint8*>(srgb), PixelFormat::RGBA8,
+                count);
+    }
+
+}
@@ -0,0 +1,103 @@
+#include <ogf/graphics/compressed_image.hxx>
+
+#include <algorithm>
+#include <stdexcept>
+
+#include <ogf/graphics/block_compression.hxx>
+#include <ogf/graphics/image.hxx>
+#include <ogf/graphics/pixel_conversion.hxx>
+#include <ogf/utils/thread_pool.hxx>
+
+namespace ogf {
+
+    void CompressedImage::compress(const ImageView& image, const CompressionFormat format,
+            const CompressionQuality quality) {
+        compress(image, {}, format, quality);
+    }
+
+    void CompressedImage::compress(const ImageView& image, const std::vector<Image>& mipmaps,
+            const CompressionFormat format, const CompressionQuality quality) {
+        free();
+        m_format = format;
+        m_levels.reserve(mipmaps.size() + 1);
+        m_levels.push_back(compress_level(image, format, quality));
+        for(const auto& mipmap : mipmaps) {
+            m_levels.push_back(compress_level(mipmap, format, quality));
+        }
+    }
+
+    void CompressedImage::free() {
+        m_levels.clear();
+    }
+
+    CompressionFormat CompressedImage::format() const noexcept {
+        return m_format;
+    }
+
+    std::tuple<unsigned int, unsigned int> CompressedImage::size() const {
+        if(m_levels.empty()) {
+            return std::make_tuple(0u, 0u);
+        }
+        return std::make_tuple(m_levels.front().width, m_levels.front().height);
+    }
+
+    std::size_t CompressedImage::level_count() const noexcept {
+        return m_levels.size();
+    }
+
+    const std::vector<Uint8>& CompressedImage::level_data(const std::size_t level) const {
+        return m_levels.at(level).data;
+    }
+
+    CompressedImage::Level CompressedImage::compress_level(const ImageView& image, const CompressionFormat format,
+            const CompressionQuality quality) {
+        using Encoder = void (*)(const Uint8*, Uint8*, const CompressionQuality);
+        Encoder encoder{nullptr};
+        switch(format) {
+            case CompressionFormat::BC1: encoder = encode_bc1_block; break;
+            case CompressionFormat::BC3: encoder = encode_bc3_block; break;
+            case CompressionFormat::BC4: encoder = encode_bc4_block; break;
+            case CompressionFormat::BC5: encoder = encode_bc5_block; break;
+            case CompressionFormat::BC7: encoder = encode_bc7_block; break;
+        }
+        const auto [width, height] = image.size();
+        if(width == 0 || height == 0) {
+            throw std::runtime_error{"Failed to compress image: the image is empty."};
+        }
+        const auto blocks_x = (width + 3) / 4;
+        const auto blocks_y = (height + 3) / 4;
+        const auto bytes_per_block = block_size(format);
+        Level level{};
+        level.width = width;
+        level.height = height;
+        level.data.resize(static_cast<std::size_t>(blocks_x) * blocks_y * bytes_per_block);
+        const auto pixels = image.pixels;
+        const auto pixel_format = image.format;
+        const auto bytes_per_pixel = pixel_size(pixel_format);
+        const auto stride = image.stride;
+        // Two channel images are grey with alpha when converted, BC5 takes their channels as they are instead.
+        const auto raw_channels = format == CompressionFormat::BC5 && channel_count(pixel_format) == 2;
+        parallel_for(blocks_y, [&](const std::size_t block_y) {
+            Uint8 block[16 * 4];
+            for(unsigned int block_x = 0; block_x < blocks_x; ++block_x) {
+                // Blocks sticking out of the image repeat its last row and column.
+                for(unsigned int y = 0; y < 4; ++y) {
+                    const auto source_y = std::min<std::size_t>(block_y * 4 + y, height - 1);
+                    for(unsigned int x = 0; x < 4; ++x) {
+                        const auto source_x = std::min(block_x * 4 + x, width - 1);
+                        // Encoders take RGBA8, so BC4 and BC5 read R8 and RG8 images from the red and green channel.
+                        const auto source = pixels + source_y * stride + source_x * bytes_per_pixel;
+                        const auto target = block + (y * 4 + x) * 4;
+                        convert_pixels(source, pixel_format, target, PixelFormat::RGBA8, 1);
+                        if(raw_channels) {
+                            target[1] = target[3];
+                        }
+                    }
+                }
+                encoder(block, level.data.data() + (block_y * blocks_x + block_x) * bytes_per_block, quality);
+            }
+        });
+        return level;
+    }
+
+}
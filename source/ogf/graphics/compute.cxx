@@ -0,0 +1,30 @@
+#include <ogf/graphics/compute.hxx>
+
+#include <glad/glad.h>
+
+#include <ogf/graphics/gl_extensions.hxx>
+
+namespace ogf {
+
+    static_assert(static_cast<GLbitfield>(Barrier::COMMAND) == GL_COMMAND_BARRIER_BIT);
+    static_assert(static_cast<GLbitfield>(Barrier::SHADER_STORAGE) == GL_SHADER_STORAGE_BARRIER_BIT);
+    static_assert(static_cast<GLbitfield>(Barrier::ALL) == GL_ALL_BARRIER_BITS);
+
+    void memory_barrier(const Barrier barriers) {
+        const auto barrier = gl_extension_functions().memory_barrier;
+        if(barrier != nullptr) {
+            barrier(static_cast<GLbitfield>(barriers));
+        }
+    }
+
+    void bind_storage_buffer(const unsigned int binding, const unsigned int buffer, const std::size_t offset,
+            const std::size_t size) {
+        if(size == 0) {
+            glBindBufferBase(GL_SHADER_STORAGE_BUFFER, binding, buffer);
+        } else {
+            glBindBufferRange(GL_SHADER_STORAGE_BUFFER, binding, buffer, static_cast<GLintptr>(offset),
+                    static_cast<GLsizeiptr>(size));
+        }
+    }
+
+}
@@ -0,0 +1,169 @@
+#include <ogf/graphics/gl_extensions.hxx>
+
+#include <glad/glad.h>
+
+namespace ogf {
+
+    namespace {
+
+        GlExtensionFunctions functions{};
+
+        template<typename T>
+        void load(T& function, const GLADloadproc loader, const char* name) {
+            function = reinterpret_cast<T>(loader(name));
+        }
+
+    }
+
+    void load_gl_extensions(const GLADloadproc loader) {
+        functions = GlExtensionFunctions{};
+        if(has_gl_version(4, 4) || has_gl_extension("GL_ARB_buffer_storage")) {
+            load(functions.buffer_storage, loader, "glBufferStorage");
+        }
+        if(has_gl_version(4, 5) || has_gl_extension("GL_ARB_direct_state_access")) {
+            load(functions.create_textures, loader, "glCreateTextures");
+            load(functions.texture_storage_2d, loader, "glTextureStorage2D");
+            load(functions.texture_sub_image_2d, loader, "glTextureSubImage2D");
+            load(functions.compressed_texture_sub_image_2d, loader, "glCompressedTextureSubImage2D");
+            load(functions.texture_parameteri, loader, "glTextureParameteri");
+            load(functions.texture_storage_3d, loader, "glTextureStorage3D");
+            load(functions.texture_sub_image_3d, loader, "glTextureSubImage3D");
+            if(!functions.create_textures || !functions.texture_storage_2d || !functions.texture_sub_image_2d
+                    || !functions.compressed_texture_sub_image_2d || !functions.texture_parameteri
+                    || !functions.texture_storage_3d || !functions.texture_sub_image_3d) {
+                functions.create_textures = nullptr;
+            }
+        }
+        GLint binary_formats{0};
+        if(has_gl_version(4, 1) || has_gl_extension("GL_ARB_get_program_binary")) {
+            glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &binary_formats);
+        }
+        if(binary_formats > 0) {
+            load(functions.get_program_binary, loader, "glGetProgramBinary");
+            load(functions.program_binary, loader, "glProgramBinary");
+            load(functions.program_parameteri, loader, "glProgramParameteri");
+            if(!functions.get_program_binary || !functions.program_binary || !functions.program_parameteri) {
+                functions.get_program_binary = nullptr;
+            }
+        }
+        if(has_gl_version(4, 3) || (has_gl_extension("GL_ARB_shader_storage_buffer_object")
+                && has_gl_extension("GL_ARB_program_interface_query"))) {
+            load(functions.shader_storage_block_binding, loader, "glShaderStorageBlockBinding");
+            load(functions.get_program_interfaceiv, loader, "glGetProgramInterfaceiv");
+            load(functions.get_program_resource_name, loader, "glGetProgramResourceName");
+            if(!functions.shader_storage_block_binding || !functions.get_program_interfaceiv
+                    || !functions.get_program_resource_name) {
+                functions.shader_storage_block_binding = nullptr;
+            }
+        }
+        if(has_gl_version(4, 3) || has_gl_extension("GL_ARB_compute_shader")) {
+            load(functions.dispatch_compute, loader, "glDispatchCompute");
+            load(functions.dispatch_compute_indirect, loader, "glDispatchComputeIndirect");
+            if(!functions.dispatch_compute || !functions.dispatch_compute_indirect) {
+                functions.dispatch_compute = nullptr;
+            }
+        }
+        if(has_gl_version(4, 2) || has_gl_extension("GL_ARB_shader_image_load_store")) {
+            load(functions.memory_barrier, loader, "glMemoryBarrier");
+        }
+        if(has_gl_extension("GL_KHR_parallel_shader_compile")) {
+            load(functions.max_shader_compiler_threads, loader, "glMaxShaderCompilerThreadsKHR");
+        } else if(has_gl_extension("GL_ARB_parallel_shader_compile")) {
+            load(functions.max_shader_compiler_threads, loader, "glMaxShaderCompilerThreadsARB");
+        }
+        if(functions.max_shader_compiler_threads) {
+            // Let the driver pick the number of threads.
+            functions.max_shader_compiler_threads(0xFFFFFFFFu);
+        }
+        if(has_gl_extension("GL_ARB_bindless_texture")) {
+            load(functions.get_texture_sampler_handle, loader, "glGetTextureSamplerHandleARB");
+            load(functions.make_texture_handle_resident, loader, "glMakeTextureHandleResidentARB");
+            load(functions.make_texture_handle_non_resident, loader, "glMakeTextureHandleNonResidentARB");
+            if(!functions.get_texture_sampler_handle || !functions.make_texture_handle_resident
+                    || !functions.make_texture_handle_non_resident) {
+                functions.get_texture_sampler_handle = nullptr;
+            }
+        }
+    }
+
+    const GlExtensionFunctions& gl_extension_functions() noexcept {
+        return functions;
+    }
+
+    bool has_direct_state_access() noexcept {
+        return functions.create_textures != nullptr;
+    }
+
+    bool has_program_binary() noexcept {
+        return functions.get_program_binary != nullptr;
+    }
+
+    bool has_parallel_shader_compile() noexcept {
+        return functions.max_shader_compiler_threads != nullptr;
+    }
+
+    bool has_shader_storage_buffers() noexcept {
+        return functions.shader_storage_block_binding != nullptr;
+    }
+
+    bool has_compute_shaders() noexcept {
+        return functions.dispatch_compute != nullptr;
+    }
+
+    bool has_bindless_textures() noexcept {
+        return functions.get_texture_sampler_handle != nullptr;
+    }
+
+    bool has_gl_extension(const std::string_view name) {
+        GLint count{0};
+        glGetIntegerv(GL_NUM_EXTENSIONS, &count);
+        for(GLint i = 0; i < count; ++i) {
+            const auto extension = reinterpret_cast<const char*>(glGetStringi(GL_EXTENSIONS, static_cast<GLuint>(i)));
+            if(extension != nullptr && name == extension) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool has_gl_version(const int major, const int minor) {
+        GLint context_major{0}, context_minor{0};
+        glGetIntegerv(GL_MAJOR_VERSION, &context_major);
+        glGetIntegerv(GL_MINOR_VERSION, &context_minor);
+        return context_major > major || (context_major == major && context_minor >= minor);
+    }
+
+    bool is_compressed_format_supported(const unsigned int internal_format) {
+        switch(internal_format) {
+            case GL_COMPRESSED_RGB_S3TC_DXT1_EXT:
+            case GL_COMPRESSED_RGBA_S3TC_DXT1_EXT:
+            case GL_COMPRESSED_RGBA_S3TC_DXT3_EXT:
+            case GL_COMPRESSED_RGBA_S3TC_DXT5_EXT: {
+                return has_gl_extension("GL_EXT_texture_compression_s3tc");
+            }
+            case GL_COMPRESSED_SRGB_S3TC_DXT1_EXT:
+            case GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT1_EXT:
+            case GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT3_EXT:
+            case GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT: {
+                return has_gl_extension("GL_EXT_texture_compression_s3tc")
+                        && (has_gl_extension("GL_EXT_texture_sRGB") || has_gl_extension("GL_EXT_texture_sRGB_s3tc"));
+            }
+            case GL_COMPRESSED_RED_RGTC1:
+            case GL_COMPRESSED_SIGNED_RED_RGTC1:
+            case GL_COMPRESSED_RG_RGTC2:
+            case GL_COMPRESSED_SIGNED_RG_RGTC2: {
+                return true;
+            }
+            case GL_COMPRESSED_RGBA_BPTC_UNORM_ARB:
+            case GL_COMPRESSED_SRGB_ALPHA_BPTC_UNORM_ARB:
+            case GL_COMPRESSED_RGB_BPTC_SIGNED_FLOAT_ARB:
+            case GL_COMPRESSED_RGB_BPTC_UNSIGNED_FLOAT_ARB: {
+                return has_gl_version(4, 2) || has_gl_extension("GL_ARB_texture_compression_bptc");
+            }
+            default: {
+                return false;
+            }
+        }
+    }
+
+}
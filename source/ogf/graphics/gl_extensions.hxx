@@ -0,0 +1,172 @@
+#pragma once
+
+#include <string>
+
+#include <glad/glad.h>
+
+// Tokens which aren't part of the OpenGL 3.3 core profile glad was generated for. Values are taken from the official
+// registry.
+
+#ifndef GL_EXT_texture_compression_s3tc
+#define GL_COMPRESSED_RGB_S3TC_DXT1_EXT   0x83F0
+#define GL_COMPRESSED_RGBA_S3TC_DXT1_EXT  0x83F1
+#define GL_COMPRESSED_RGBA_S3TC_DXT3_EXT  0x83F2
+#define GL_COMPRESSED_RGBA_S3TC_DXT5_EXT  0x83F3
+#endif
+
+#ifndef GL_EXT_texture_sRGB
+#define GL_COMPRESSED_SRGB_S3TC_DXT1_EXT       0x8C4C
+#define GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT1_EXT 0x8C4D
+#define GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT3_EXT 0x8C4E
+#define GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT 0x8C4F
+#endif
+
+#ifndef GL_ARB_texture_compression_bptc
+#define GL_COMPRESSED_RGBA_BPTC_UNORM_ARB         0x8E8C
+#define GL_COMPRESSED_SRGB_ALPHA_BPTC_UNORM_ARB   0x8E8D
+#define GL_COMPRESSED_RGB_BPTC_SIGNED_FLOAT_ARB   0x8E8E
+#define GL_COMPRESSED_RGB_BPTC_UNSIGNED_FLOAT_ARB 0x8E8F
+#endif
+
+#ifndef GL_EXT_texture_filter_anisotropic
+#define GL_TEXTURE_MAX_ANISOTROPY_EXT     0x84FE
+#define GL_MAX_TEXTURE_MAX_ANISOTROPY_EXT 0x84FF
+#endif
+
+#ifndef GL_ARB_buffer_storage
+#define GL_MAP_PERSISTENT_BIT  0x0040
+#define GL_MAP_COHERENT_BIT    0x0080
+#define GL_DYNAMIC_STORAGE_BIT 0x0100
+#define GL_CLIENT_STORAGE_BIT  0x0200
+#endif
+
+#ifndef GL_ARB_get_program_binary
+#define GL_PROGRAM_BINARY_RETRIEVABLE_HINT 0x8257
+#define GL_PROGRAM_BINARY_LENGTH           0x8741
+#define GL_NUM_PROGRAM_BINARY_FORMATS      0x87FE
+#endif
+
+#ifndef GL_KHR_parallel_shader_compile
+#define GL_MAX_SHADER_COMPILER_THREADS_KHR 0x91B0
+#define GL_COMPLETION_STATUS_KHR           0x91B1
+#endif
+
+#ifndef GL_ARB_shader_storage_buffer_object
+#define GL_SHADER_STORAGE_BUFFER                  0x90D2
+#define GL_SHADER_STORAGE_BUFFER_OFFSET_ALIGNMENT 0x90DF
+#define GL_SHADER_STORAGE_BARRIER_BIT             0x00002000
+#endif
+
+#ifndef GL_ARB_program_interface_query
+#define GL_SHADER_STORAGE_BLOCK 0x92E6
+#define GL_ACTIVE_RESOURCES     0x92F5
+#define GL_MAX_NAME_LENGTH      0x92F6
+#endif
+
+#ifndef GL_ARB_shader_image_load_store
+#define GL_VERTEX_ATTRIB_ARRAY_BARRIER_BIT 0x00000001
+#define GL_ELEMENT_ARRAY_BARRIER_BIT       0x00000002
+#define GL_UNIFORM_BARRIER_BIT             0x00000004
+#define GL_TEXTURE_FETCH_BARRIER_BIT       0x00000008
+#define GL_SHADER_IMAGE_ACCESS_BARRIER_BIT 0x00000020
+#define GL_COMMAND_BARRIER_BIT             0x00000040
+#define GL_PIXEL_BUFFER_BARRIER_BIT        0x00000080
+#define GL_TEXTURE_UPDATE_BARRIER_BIT      0x00000100
+#define GL_BUFFER_UPDATE_BARRIER_BIT       0x00000200
+#define GL_FRAMEBUFFER_BARRIER_BIT         0x00000400
+#define GL_TRANSFORM_FEEDBACK_BARRIER_BIT  0x00000800
+#define GL_ATOMIC_COUNTER_BARRIER_BIT      0x00001000
+#define GL_ALL_BARRIER_BITS                0xFFFFFFFF
+#endif
+
+#ifndef GL_ARB_compute_shader
+#define GL_COMPUTE_SHADER               0x91B9
+#define GL_COMPUTE_WORK_GROUP_SIZE      0x8267
+#define GL_DISPATCH_INDIRECT_BUFFER     0x90EE
+#endif
+
+namespace ogf {
+
+    // Entry points newer than the OpenGL 3.3 core profile. Each stays null if the context doesn't provide it.
+    struct GlExtensionFunctions {
+        void (APIENTRYP buffer_storage)(GLenum target, GLsizeiptr size, const void* data, GLbitfield flags){nullptr};
+
+        // Direct state access with immutable texture storage, OpenGL 4.5 or ARB_direct_state_access. Either all of
+        // these are loaded or none.
+        void (APIENTRYP create_textures)(GLenum target, GLsizei count, GLuint* textures){nullptr};
+        void (APIENTRYP texture_storage_2d)(GLuint texture, GLsizei levels, GLenum internal_format, GLsizei width,
+                GLsizei height){nullptr};
+        void (APIENTRYP texture_sub_image_2d)(GLuint texture, GLint level, GLint x, GLint y, GLsizei width,
+                GLsizei height, GLenum format, GLenum type, const void* pixels){nullptr};
+        void (APIENTRYP compressed_texture_sub_image_2d)(GLuint texture, GLint level, GLint x, GLint y, GLsizei width,
+                GLsizei height, GLenum format, GLsizei size, const void* data){nullptr};
+        void (APIENTRYP texture_parameteri)(GLuint texture, GLenum name, GLint value){nullptr};
+        void (APIENTRYP texture_storage_3d)(GLuint texture, GLsizei levels, GLenum internal_format, GLsizei width,
+                GLsizei height, GLsizei depth){nullptr};
+        void (APIENTRYP texture_sub_image_3d)(GLuint texture, GLint level, GLint x, GLint y, GLint z, GLsizei width,
+                GLsizei height, GLsizei depth, GLenum format, GLenum type, const void* pixels){nullptr};
+
+        // Program binaries, OpenGL 4.1 or ARB_get_program_binary, all or none. Also left null if the driver has no
+        // binary formats.
+        void (APIENTRYP get_program_binary)(GLuint program, GLsizei size, GLsizei* length, GLenum* format,
+                void* binary){nullptr};
+        void (APIENTRYP program_binary)(GLuint program, GLenum format, const void* binary, GLsizei length){nullptr};
+        void (APIENTRYP program_parameteri)(GLuint program, GLenum name, GLint value){nullptr};
+
+        // KHR_parallel_shader_compile or its ARB twin.
+        void (APIENTRYP max_shader_compiler_threads)(GLuint count){nullptr};
+
+        // Shader storage blocks, OpenGL 4.3 or ARB_shader_storage_buffer_object with ARB_program_interface_query, all
+        // or none.
+        void (APIENTRYP shader_storage_block_binding)(GLuint program, GLuint block, GLuint binding){nullptr};
+        void (APIENTRYP get_program_interfaceiv)(GLuint program, GLenum program_interface, GLenum name,
+                GLint* value){nullptr};
+        void (APIENTRYP get_program_resource_name)(GLuint program, GLenum program_interface, GLuint index,
+                GLsizei size, GLsizei* length, GLchar* name){nullptr};
+
+        // Compute shaders, OpenGL 4.3 or ARB_compute_shader, all or none.
+        void (APIENTRYP dispatch_compute)(GLuint groups_x, GLuint groups_y, GLuint groups_z){nullptr};
+        void (APIENTRYP dispatch_compute_indirect)(GLintptr offset){nullptr};
+
+        // OpenGL 4.2 or ARB_shader_image_load_store. Contexts without it have no incoherent memory writes to order.
+        void (APIENTRYP memory_barrier)(GLbitfield barriers){nullptr};
+
+        // ARB_bindless_texture, all or none.
+        GLuint64 (APIENTRYP get_texture_sampler_handle)(GLuint texture, GLuint sampler){nullptr};
+        void (APIENTRYP make_texture_handle_resident)(GLuint64 handle){nullptr};
+        void (APIENTRYP make_texture_handle_non_resident)(GLuint64 handle){nullptr};
+    };
+
+    // Load the entry points above for the current context. Window calls it right after loading glad.
+    void load_gl_extensions(GLADloadproc loader);
+
+    const GlExtensionFunctions& gl_extension_functions() noexcept;
+
+    // Check if the direct state access functions were loaded.
+    bool has_direct_state_access() noexcept;
+
+    // Check if the program binary functions were loaded.
+    bool has_program_binary() noexcept;
+
+    // Check if shaders compile on driver threads and can be polled with GL_COMPLETION_STATUS_KHR.
+    bool has_parallel_shader_compile() noexcept;
+
+    // Check if the shader storage block functions were loaded.
+    bool has_shader_storage_buffers() noexcept;
+
+    // Check if the compute shader functions were loaded.
+    bool has_compute_shaders() noexcept;
+
+    // Check if the bindless texture functions were loaded.
+    bool has_bindless_textures() noexcept;
+
+    // Check if the current OpenGL context supports given extension, e.g. "GL_ARB_texture_compression_bptc".
+    bool has_gl_extension(const std::string_view name);
+
+    // Check if the current OpenGL context is at least of given version.
+    bool has_gl_version(const int major, const int minor);
+
+    // Check if the current OpenGL context can sample textures of given compressed internal format.
+    bool is_compressed_format_supported(const unsigned int internal_format);
+
+}
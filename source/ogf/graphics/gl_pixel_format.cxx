@@ -0,0 +1,40 @@
+#include <ogf/graphics/gl_pixel_format.hxx>
+
+#include <utility>
+
+#include <ogf/graphics/gl_extensions.hxx>
+
+namespace ogf {
+
+    GlPixelFormat gl_pixel_format(const PixelFormat format) {
+        constexpr GLint internal_formats[]{
+            GL_R8, GL_RG8, GL_RGB8, GL_RGBA8,
+            GL_R16, GL_RG16, GL_RGB16, GL_RGBA16,
+            GL_R16F, GL_RG16F, GL_RGB16F, GL_RGBA16F,
+            GL_R32F, GL_RG32F, GL_RGB32F, GL_RGBA32F
+        };
+        constexpr GLenum formats[]{GL_RED, GL_RG, GL_RGB, GL_RGBA};
+        constexpr GLenum types[]{GL_UNSIGNED_BYTE, GL_UNSIGNED_SHORT, GL_HALF_FLOAT, GL_FLOAT};
+        const auto index = static_cast<unsigned int>(format);
+        return GlPixelFormat{internal_formats[index], formats[index % 4], types[index / 4]};
+    }
+
+    void set_texture_swizzle(const GLenum target, const GLuint texture, const PixelFormat format) {
+        const auto channels = channel_count(format);
+        if(channels > 2) {
+            return;
+        }
+        const std::pair<GLenum, GLint> parameters[]{
+            {GL_TEXTURE_SWIZZLE_R, GL_RED}, {GL_TEXTURE_SWIZZLE_G, GL_RED}, {GL_TEXTURE_SWIZZLE_B, GL_RED},
+            {GL_TEXTURE_SWIZZLE_A, channels == 2 ? GL_GREEN : GL_ONE}
+        };
+        for(const auto& [name, value] : parameters) {
+            if(has_direct_state_access()) {
+                gl_extension_functions().texture_parameteri(texture, name, value);
+            } else {
+                glTexParameteri(target, name, value);
+            }
+        }
+    }
+
+}
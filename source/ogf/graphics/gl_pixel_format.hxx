@@ -0,0 +1,22 @@
+#pragma once
+
+#include <glad/glad.h>
+
+#include <ogf/graphics/pixel_format.hxx>
+
+namespace ogf {
+
+    struct GlPixelFormat {
+        GLint  internal_format{};
+        GLenum format{};
+        GLenum type{};
+    };
+
+    // Every image format has a texture format of the same size, so nothing is expanded on upload.
+    GlPixelFormat gl_pixel_format(const PixelFormat format);
+
+    // Make a texture of a one or two channel format sample as grey or grey with alpha, the way images treat these
+    // formats. Does nothing for other formats. Without direct state access the texture has to be bound to target.
+    void set_texture_swizzle(const GLenum target, const GLuint texture, const PixelFormat format);
+
+}
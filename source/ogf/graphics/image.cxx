@@ -1,5 +1,9 @@
 #include <ogf/graphics/image.hxx>
 
+#include <algorithm>
+#include <cctype>
+#include <functional>
+#include <numeric>
 #include <stdexcept>
 
 #define STB_IMAGE_IMPLEMENTATION
@@ -7,46 +11,326 @@
 #define STB_IMAGE_WRITE_IMPLEMENTATION
 #include <stb_image_write.h>
 
+#include <ogf/graphics/image_info.hxx>
+#include <ogf/graphics/image_kernels.hxx>
+#include <ogf/graphics/pixel_conversion.hxx>
+#include <ogf/graphics/png_writer.hxx>
+#include <ogf/graphics/resampler.hxx>
+#include <ogf/utils/io_utils.hxx>
+#include <ogf/utils/thread_pool.hxx>
+
 namespace ogf {
 
+    namespace {
+
+        // Clip a rectangle placed at (x, y) to an image of given size. Returns false if nothing is left.
+        bool clip(int& x, int& y, unsigned int& width, unsigned int& height, unsigned int& skip_x,
+                unsigned int& skip_y, const unsigned int target_width, const unsigned int target_height) {
+            skip_x = x < 0 ? static_cast<unsigned int>(-static_cast<long long>(x)) : 0;
+            skip_y = y < 0 ? static_cast<unsigned int>(-static_cast<long long>(y)) : 0;
+            if(skip_x >= width || skip_y >= height) {
+                return false;
+            }
+            x = std::max(x, 0);
+            y = std::max(y, 0);
+            if(static_cast<unsigned int>(x) >= target_width || static_cast<unsigned int>(y) >= target_height) {
+                return false;
+            }
+            width = std::min(width - skip_x, target_width - static_cast<unsigned int>(x));
+            height = std::min(height - skip_y, target_height - static_cast<unsigned int>(y));
+            return true;
+        }
+
+    }
+
+    void Image::create(const unsigned int width, const unsigned int height, const Color& color,
+            const PixelFormat format) {
+        allocate(width, height, format);
+        fill(color);
+    }
+
+    void Image::create(const ImageView& source) {
+        if(overlaps(source)) {
+            Image copy{};
+            copy.create(source);
+            *this = std::move(copy);
+            return;
+        }
+        allocate(source.width, source.height, source.format);
+        if(!source.empty()) {
+            copy_pixels(source, view());
+        }
+    }
+
     void Image::load_from_file(const std::string_view filename) {
         free();
-        int width{}, height{}, channels{};
-	    auto data = stbi_load(filename.data(), &width, &height, &channels, 4);
+        const std::string name{filename};
+        ImageInfo info{};
+        if(!read_image_info(filename, info)) {
+            throw std::runtime_error{"Failed to open image \"" + name + "\"."};
+        }
+        // The channel count is asked for explicitly, so the pixels always match the probed format.
+        const auto channels = static_cast<int>(channel_count(info.format));
+        int width{}, height{}, file_channels{};
+        void* data{nullptr};
+        switch(channel_size(info.format)) {
+            case 4: data = stbi_loadf(name.c_str(), &width, &height, &file_channels, channels); break;
+            case 2: data = stbi_load_16(name.c_str(), &width, &height, &file_channels, channels); break;
+            default: data = stbi_load(name.c_str(), &width, &height, &file_channels, channels); break;
+        }
         if(data == nullptr) {
-            throw std::runtime_error{"Failed to open image \"" + std::string{filename} + "\"."};
+            throw std::runtime_error{"Failed to open image \"" + name + "\"."};
         }
-        m_pixels.resize(width * height * 4);
-        std::copy(data, data + width * height * 4, m_pixels.begin());
-        m_width = width;
-        m_height = height;
+        allocate(static_cast<unsigned int>(width), static_cast<unsigned int>(height), info.format);
+        const auto packed_stride = static_cast<std::size_t>(width) * pixel_size(m_format);
+        copy_pixels(ImageView{static_cast<const Uint8*>(data), m_width, m_height, packed_stride, m_format}, view());
         stbi_image_free(data);
     }
 
+    void Image::save_to_file(const std::string_view filename) const {
+        auto ext = get_file_extension(filename);
+        std::transform(ext.begin(), ext.end(), ext.begin(), [](const unsigned char c) { return std::tolower(c); });
+        const auto channels = channel_count(m_format);
+        // Every file format takes just some channel types, other pixels are converted to the closest one.
+        const auto base_format = static_cast<unsigned int>(m_format) - (channels - 1);
+        auto target_format = static_cast<PixelFormat>(static_cast<unsigned int>(PixelFormat::R8) + channels - 1);
+        if(ext == "hdr") {
+            target_format = static_cast<PixelFormat>(static_cast<unsigned int>(PixelFormat::R32F) + channels - 1);
+        } else if(ext == "png" && base_format == static_cast<unsigned int>(PixelFormat::R16)) {
+            target_format = m_format;
+        }
+        const Image* image = this;
+        Image converted{};
+        if(target_format != m_format) {
+            converted = *this;
+            converted.convert(target_format);
+            image = &converted;
+        }
+
+        if(ext == "png") {
+            write_png(filename, image->pixels(), m_width, m_height, channels, image->m_stride,
+                    channel_size(target_format) * 8);
+            return;
+        }
+        // The other writers take tightly packed rows only.
+        const auto packed_stride = static_cast<std::size_t>(m_width) * pixel_size(target_format);
+        std::vector<Uint8> packed(packed_stride * m_height);
+        copy_pixels(image->view(), MutableImageView{packed.data(), m_width, m_height, packed_stride, target_format});
+        const auto data = packed.data();
+        const auto width = static_cast<int>(m_width);
+        const auto height = static_cast<int>(m_height);
+        const auto components = static_cast<int>(channels);
+        int success{0};
+        if(ext == "tga") {
+            success = stbi_write_tga(filename.data(), width, height, components, data);
+        } else if(ext == "bmp") {
+            success = stbi_write_bmp(filename.data(), width, height, components, data);
+        } else if(ext == "jpg" || ext == "jpeg") {
+            success = stbi_write_jpg(filename.data(), width, height, components, data, 90);
+        } else if(ext == "hdr") {
+            success = stbi_write_hdr(filename.data(), width, height, components, reinterpret_cast<const float*>(data));
+        } else {
+            throw std::runtime_error{"Unknown image format: \"" + std::string{filename} + "\"."};
+        }
+        if(!success) {
+            throw std::runtime_error{"Failed to save image \"" + std::string{filename} + "\"."};
+        }
+    }
+
+    std::future<void> Image::save_to_file_async(const std::string_view filename) const {
+        return default_thread_pool().submit([image = *this, filename = std::string{filename}]() {
+            image.save_to_file(filename);
+        });
+    }
+
     void Image::free() {
         m_pixels.clear();
+        m_stride = 0;
         m_width = 0;
         m_height = 0;
     }
 
+    void Image::convert(const PixelFormat format) {
+        if(format == m_format) {
+            return;
+        }
+        Image converted{};
+        converted.allocate(m_width, m_height, format);
+        copy_pixels(view(), converted.view());
+        *this = std::move(converted);
+    }
+
+    void Image::resize(const unsigned int width, const unsigned int height, const ResizeFilter filter,
+            const bool srgb) {
+        if(width == 0 || height == 0 || m_width == 0 || m_height == 0) {
+            throw std::runtime_error{"Failed to resize image: the image or the new size is empty."};
+        }
+        if(width == m_width && height == m_height) {
+            return;
+        }
+        ResampleKernel kernel{};
+        switch(filter) {
+            case ResizeFilter::BOX: kernel = ResampleKernel::BOX; break;
+            case ResizeFilter::BILINEAR: kernel = ResampleKernel::BILINEAR; break;
+            case ResizeFilter::MITCHELL: kernel = ResampleKernel::MITCHELL; break;
+            case ResizeFilter::LANCZOS3: kernel = ResampleKernel::LANCZOS3; break;
+        }
+        auto linear = to_linear(m_pixels.data(), m_format, m_width, m_height, m_stride, srgb);
+        const auto has_alpha = channel_count(m_format) % 2 == 0;
+        if(has_alpha) {
+            premultiply(linear);
+        }
+        linear = resample(linear, width, height, kernel);
+        if(has_alpha) {
+            unpremultiply(linear);
+        }
+        allocate(width, height, m_format);
+        from_linear(linear, m_pixels.data(), m_format, m_stride, srgb);
+    }
+
+    void Image::fill(const Color& color) {
+        fill(RectU{0, 0, m_width, m_height}, color);
+    }
+
+    void Image::fill(const RectU& area, const Color& color) {
+        if(area.left >= m_width || area.top >= m_height) {
+            return;
+        }
+        const auto width = std::min(area.width, m_width - area.left);
+        const auto height = std::min(area.height, m_height - area.top);
+        const float components[4]{color.r, color.g, color.b, color.a};
+        Uint8 pixel[16]{};
+        encode_pixels(components, pixel, m_format, 1);
+        const auto first = m_pixels.data() + area.top * m_stride + area.left * pixel_size(m_format);
+        fill_pixels(MutableImageView{first, width, height, m_stride, m_format}, pixel);
+    }
+
+    void Image::blit(const ImageView& source, int x, int y) {
+        if(overlaps(source)) {
+            Image copy{};
+            copy.create(source);
+            blit(copy, x, y);
+            return;
+        }
+        auto [width, height] = source.size();
+        unsigned int skip_x{}, skip_y{};
+        if(!clip(x, y, width, height, skip_x, skip_y, m_width, m_height)) {
+            return;
+        }
+        copy_pixels(source.subview(RectU{skip_x, skip_y, width, height}),
+                view(RectU{static_cast<unsigned int>(x), static_cast<unsigned int>(y), width, height}));
+    }
+
+    void Image::blend_over(const ImageView& source, int x, int y) {
+        if(overlaps(source)) {
+            Image copy{};
+            copy.create(source);
+            blend_over(copy, x, y);
+            return;
+        }
+        auto [width, height] = source.size();
+        unsigned int skip_x{}, skip_y{};
+        if(!clip(x, y, width, height, skip_x, skip_y, m_width, m_height)) {
+            return;
+        }
+        blend_pixels_over(source.subview(RectU{skip_x, skip_y, width, height}),
+                view(RectU{static_cast<unsigned int>(x), static_cast<unsigned int>(y), width, height}));
+    }
+
+    void Image::swizzle(const std::array<unsigned int, 4>& order) {
+        const auto channels = channel_count(m_format);
+        if(std::any_of(order.begin(), order.begin() + channels, [&](const unsigned int c) { return c >= channels; })) {
+            throw std::runtime_error{"Failed to swizzle image: the image doesn't have such channel."};
+        }
+        swizzle_pixels(view(), order);
+    }
+
+    void Image::premultiply_alpha() {
+        premultiply_pixels(view());
+    }
+
+    void Image::flip_horizontally() {
+        flip_pixels_horizontally(view());
+    }
+
+    void Image::flip_vertically() {
+        flip_pixels_vertically(view());
+    }
+
     void Image::set_pixel(const unsigned int x, const unsigned int y, const Color& color) {
-        m_pixels.at(x + y * m_width) = color.r;
-        m_pixels[x + y * m_width + 1] = color.g;
-        m_pixels[x + y * m_width + 2] = color.b;
-        m_pixels[x + y * m_width + 3] = color.a;
+        if(x >= m_width || y >= m_height) {
+            throw std::out_of_range{"Pixel is outside of the image."};
+        }
+        const float components[4]{color.r, color.g, color.b, color.a};
+        const auto pixel = m_pixels.data() + y * m_stride + static_cast<std::size_t>(x) * pixel_size(m_format);
+        encode_pixels(components, pixel, m_format, 1);
     }
 
     Color Image::pixel(const unsigned int x, const unsigned int y) const {
-        Color color{};
-        color.r = m_pixels.at(x + y * m_width);
-        color.g = m_pixels[x + y * m_width + 1];
-        color.b = m_pixels[x + y * m_width + 2];
-        color.a = m_pixels[x + y * m_width + 3];
-        return color;
+        if(x >= m_width || y >= m_height) {
+            throw std::out_of_range{"Pixel is outside of the image."};
+        }
+        float components[4]{};
+        const auto pixel = m_pixels.data() + y * m_stride + static_cast<std::size_t>(x) * pixel_size(m_format);
+        decode_pixels(pixel, m_format, components, 1);
+        return Color{components[0], components[1], components[2], components[3]};
     }
 
-    std::tuple<unsigned int, unsigned int> Image::size() {
+    std::tuple<unsigned int, unsigned int> Image::size() const {
         return std::make_tuple(m_width, m_height);
     }
+
+    PixelFormat Image::format() const noexcept {
+        return m_format;
+    }
+
+    Uint8* Image::pixels() noexcept {
+        return m_pixels.empty() ? nullptr : m_pixels.data();
+    }
+
+    const Uint8* Image::pixels() const noexcept {
+        return m_pixels.empty() ? nullptr : m_pixels.data();
+    }
+
+    std::size_t Image::stride() const noexcept {
+        return m_stride;
+    }
+
+    ImageView Image::view() const noexcept {
+        return ImageView{pixels(), m_width, m_height, m_stride, m_format};
+    }
+
+    MutableImageView Image::view() noexcept {
+        return MutableImageView{pixels(), m_width, m_height, m_stride, m_format};
+    }
+
+    ImageView Image::view(const RectU& area) const {
+        return view().subview(area);
+    }
+
+    MutableImageView Image::view(const RectU& area) {
+        return view().subview(area);
+    }
+
+    Image::operator ImageView() const noexcept {
+        return view();
+    }
+
+    bool Image::overlaps(const ImageView& view) const noexcept {
+        const auto begin = m_pixels.data();
+        return !view.empty() && !m_pixels.empty() && std::less_equal<const Uint8*>{}(begin, view.pixels)
+                && std::less<const Uint8*>{}(view.pixels, begin + m_pixels.size());
+    }
+
+    void Image::allocate(const unsigned int width, const unsigned int height, const PixelFormat format) {
+        // A multiple of the pixel size too, so OpenGL can take the stride as GL_UNPACK_ROW_LENGTH.
+        const auto alignment = std::lcm<std::size_t>(ROW_ALIGNMENT, pixel_size(format));
+        const auto row_bytes = static_cast<std::size_t>(width) * pixel_size(format);
+        m_stride = (row_bytes + alignment - 1) / alignment * alignment;
+        m_pixels.resize(m_stride * height);
+        m_width = width;
+        m_height = height;
+        m_format = format;
+    }
   
 }
@@ -0,0 +1,165 @@
+#include <ogf/graphics/image_batch_loader.hxx>
+
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <mutex>
+
+#include <ogf/graphics/image.hxx>
+#include <ogf/graphics/image_info.hxx>
+#include <ogf/graphics/texture.hxx>
+#include <ogf/utils/thread_pool.hxx>
+
+namespace ogf {
+
+    struct ImageBatchLoader::Impl {
+        struct Job {
+            std::string filename{};
+            std::size_t bytes{};
+        };
+
+        struct Result {
+            std::string        filename{};
+            Image              image{};
+            std::exception_ptr error{};
+            std::size_t        bytes{};
+        };
+
+        // Read just the header of the file to find out how much memory the decoded image will take, then either start
+        // decoding or defer the job until enough images are collected.
+        void probe(std::string filename);
+        void decode(Job job);
+
+        // Start deferred jobs which fit into the budget. Must be called with the mutex locked.
+        void dispatch_deferred();
+
+        bool take_result(std::unique_lock<std::mutex>& mutex_lock, std::string& filename, Image& image);
+
+        std::size_t budget{};
+        std::size_t used{};       // Bytes reserved by images being decoded or waiting for collection.
+        std::size_t pending{};    // Files added, but not collected.
+        std::size_t running{};    // Tasks submitted to the thread pool, but not finished.
+        std::deque<Job>         deferred{};
+        std::deque<Result>      ready{};
+        mutable std::mutex      mutex{};
+        std::condition_variable condition{};
+    };
+
+    void ImageBatchLoader::Impl::probe(std::string filename) {
+        // If the header can't be read, the decode fails too and reports the error, so zero bytes are fine here.
+        std::size_t bytes{0};
+        ImageInfo info{};
+        if(read_image_info(filename, info)) {
+            bytes = static_cast<std::size_t>(info.width) * info.height * pixel_size(info.format);
+        }
+        {
+            std::lock_guard<std::mutex> mutex_lock{mutex};
+            if(used != 0 && used + bytes > budget) {
+                deferred.push_back(Job{std::move(filename), bytes});
+                --running;
+                condition.notify_all();
+                return;
+            }
+            used += bytes;
+        }
+        decode(Job{std::move(filename), bytes});
+    }
+
+    void ImageBatchLoader::Impl::decode(Job job) {
+        Result result{};
+        try {
+            result.image.load_from_file(job.filename);
+        } catch(...) {
+            result.error = std::current_exception();
+        }
+        result.filename = std::move(job.filename);
+        result.bytes = job.bytes;
+        // The destructor may delete the loader as soon as the mutex is unlocked, so everything is done under it.
+        std::lock_guard<std::mutex> mutex_lock{mutex};
+        ready.push_back(std::move(result));
+        --running;
+        condition.notify_all();
+    }
+
+    void ImageBatchLoader::Impl::dispatch_deferred() {
+        while(!deferred.empty() && (used == 0 || used + deferred.front().bytes <= budget)) {
+            used += deferred.front().bytes;
+            ++running;
+            default_thread_pool().submit([this, job = std::move(deferred.front())]() mutable {
+                decode(std::move(job));
+            });
+            deferred.pop_front();
+        }
+    }
+
+    bool ImageBatchLoader::Impl::take_result(std::unique_lock<std::mutex>& mutex_lock, std::string& filename,
+            Image& image) {
+        if(ready.empty()) {
+            return false;
+        }
+        auto result = std::move(ready.front());
+        ready.pop_front();
+        used -= result.bytes;
+        --pending;
+        dispatch_deferred();
+        mutex_lock.unlock();
+        filename = std::move(result.filename);
+        if(result.error) {
+            std::rethrow_exception(result.error);
+        }
+        image = std::move(result.image);
+        return true;
+    }
+
+    ImageBatchLoader::ImageBatchLoader(const std::size_t memory_budget) {
+        m_impl = std::make_unique<Impl>();
+        m_impl->budget = memory_budget;
+    }
+
+    ImageBatchLoader::~ImageBatchLoader() {
+        {
+            std::unique_lock<std::mutex> mutex_lock{m_impl->mutex};
+            m_impl->deferred.clear();
+            m_impl->condition.wait(mutex_lock, [this]() { return m_impl->running == 0; });
+            // Jobs deferred while waiting would never be started.
+            m_impl->deferred.clear();
+        }
+    }
+
+    void ImageBatchLoader::add(const std::string_view filename) {
+        {
+            std::lock_guard<std::mutex> mutex_lock{m_impl->mutex};
+            ++m_impl->pending;
+            ++m_impl->running;
+        }
+        default_thread_pool().submit([impl = m_impl.get(), filename = std::string{filename}]() mutable {
+            impl->probe(std::move(filename));
+        });
+    }
+
+    bool ImageBatchLoader::wait_next(std::string& filename, Image& image) {
+        std::unique_lock<std::mutex> mutex_lock{m_impl->mutex};
+        m_impl->condition.wait(mutex_lock, [this]() { return !m_impl->ready.empty() || m_impl->pending == 0; });
+        return m_impl->take_result(mutex_lock, filename, image);
+    }
+
+    bool ImageBatchLoader::wait_next(std::string& filename, Texture& texture) {
+        Image image{};
+        if(!wait_next(filename, image)) {
+            return false;
+        }
+        texture.load_from_image(image);
+        return true;
+    }
+
+    bool ImageBatchLoader::poll_next(std::string& filename, Image& image) {
+        std::unique_lock<std::mutex> mutex_lock{m_impl->mutex};
+        return m_impl->take_result(mutex_lock, filename, image);
+    }
+
+    std::size_t ImageBatchLoader::pending() const {
+        std::lock_guard<std::mutex> mutex_lock{m_impl->mutex};
+        return m_impl->pending;
+    }
+
+}
@@ -0,0 +1,459 @@
+#include <ogf/graphics/image_decoder.hxx>
+
+#include <algorithm>
+#include <array>
+#include <csetjmp>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+#include <jpeglib.h>
+#include <zlib.h>
+
+namespace ogf {
+
+    namespace {
+
+        constexpr std::array<Uint8, 8> PNG_SIGNATURE{0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+
+        // Compressed data is read from the file in pieces of this size.
+        constexpr std::size_t INPUT_BUFFER_SIZE = 64 * 1024;
+
+        Uint32 read_big_endian(const Uint8* data) {
+            return Uint32{data[0]} << 24 | Uint32{data[1]} << 16 | Uint32{data[2]} << 8 | Uint32{data[3]};
+        }
+
+        Uint8 paeth(const int a, const int b, const int c) {
+            const auto p = a + b - c;
+            const auto pa = std::abs(p - a);
+            const auto pb = std::abs(p - b);
+            const auto pc = std::abs(p - c);
+            if(pa <= pb && pa <= pc) {
+                return static_cast<Uint8>(a);
+            }
+            return static_cast<Uint8>(pb <= pc ? b : c);
+        }
+
+        // Decoder of a single file format.
+        class RowSource {
+        public:
+            virtual ~RowSource() = default;
+
+            // Decode the next row in the output format.
+            virtual void read_row(Uint8* pixels) = 0;
+
+            unsigned int width{};
+            unsigned int height{};
+            PixelFormat  format{};
+        };
+
+        class PngSource final : public RowSource {
+        public:
+            explicit PngSource(const std::string& filename);
+            ~PngSource() override;
+
+            void read_row(Uint8* pixels) override;
+
+        private:
+            [[noreturn]] void fail(const std::string& reason) const;
+
+            void read(void* data, const std::size_t size);
+
+            // Parse chunks up to the first IDAT chunk.
+            void read_header();
+
+            // Check the header and pick the output format.
+            void configure();
+
+            // Give the inflater the next piece of image data. Returns false when there's no more.
+            bool feed_input();
+
+            void unfilter();
+
+            std::string             m_filename{};
+            std::ifstream           m_file{};
+            z_stream                m_stream{};
+            bool                    m_stream_ready{false};
+            std::vector<Uint8>      m_input{};
+            Uint32                  m_chunk_left{0};   // Bytes of the current IDAT chunk not read yet.
+            std::vector<Uint8>      m_row{};           // Filter type byte followed by the row.
+            std::vector<Uint8>      m_previous{};      // Previous unfiltered row.
+            std::array<Uint8, 1024> m_palette{};       // RGBA entries.
+            bool                    m_has_alpha{false};
+            unsigned int            m_bit_depth{};
+            unsigned int            m_color_type{};
+            std::size_t             m_bpp{};           // Bytes per pixel used by the filters, at least 1.
+        };
+
+        PngSource::PngSource(const std::string& filename) : m_filename{filename} {
+            m_file.open(filename, std::ios::binary);
+            if(!m_file.good()) {
+                throw std::runtime_error{"Failed to open image \"" + filename + "\"."};
+            }
+            read_header();
+            configure();
+            if(inflateInit(&m_stream) != Z_OK) {
+                fail("the inflater can't be initialized");
+            }
+            m_stream_ready = true;
+            m_input.resize(INPUT_BUFFER_SIZE);
+        }
+
+        PngSource::~PngSource() {
+            if(m_stream_ready) {
+                inflateEnd(&m_stream);
+            }
+        }
+
+        void PngSource::fail(const std::string& reason) const {
+            throw std::runtime_error{"Failed to decode image \"" + m_filename + "\": " + reason + "."};
+        }
+
+        void PngSource::read(void* data, const std::size_t size) {
+            m_file.read(static_cast<char*>(data), static_cast<std::streamsize>(size));
+            if(!m_file.good()) {
+                fail("the file ends early");
+            }
+        }
+
+        void PngSource::read_header() {
+            std::array<Uint8, 8> signature{};
+            read(signature.data(), signature.size());
+            if(signature != PNG_SIGNATURE) {
+                fail("not a PNG file");
+            }
+            bool has_header{false};
+            while(true) {
+                Uint8 chunk[8];
+                read(chunk, sizeof(chunk));
+                const auto length = read_big_endian(chunk);
+                const auto type = std::string{reinterpret_cast<const char*>(chunk + 4), 4};
+                if(type == "IDAT") {
+                    if(!has_header) {
+                        fail("the header is missing");
+                    }
+                    m_chunk_left = length;
+                    return;
+                }
+                if(type == "IEND") {
+                    fail("there's no image data");
+                }
+                if(type == "IHDR") {
+                    Uint8 header[13];
+                    if(length != sizeof(header)) {
+                        fail("the header is corrupted");
+                    }
+                    read(header, sizeof(header));
+                    width = read_big_endian(header);
+                    height = read_big_endian(header + 4);
+                    m_bit_depth = header[8];
+                    m_color_type = header[9];
+                    if(header[12] != 0) {
+                        fail("interlaced files can't be decoded row by row");
+                    }
+                    has_header = true;
+                } else if(type == "PLTE" && length <= 768 && length % 3 == 0) {
+                    Uint8 entries[768];
+                    read(entries, length);
+                    for(Uint32 i = 0; i < length / 3; ++i) {
+                        std::memcpy(&m_palette[i * 4], &entries[i * 3], 3);
+                        m_palette[i * 4 + 3] = 255;
+                    }
+                } else if(type == "tRNS" && m_color_type == 3 && length <= 256) {
+                    Uint8 alpha[256];
+                    read(alpha, length);
+                    for(Uint32 i = 0; i < length; ++i) {
+                        m_palette[i * 4 + 3] = alpha[i];
+                    }
+                    m_has_alpha = true;
+                } else {
+                    m_file.seekg(length, std::ios::cur);
+                }
+                // Chunk CRCs aren't checked, inflate checks the image data.
+                m_file.seekg(4, std::ios::cur);
+            }
+        }
+
+        void PngSource::configure() {
+            unsigned int channels{};
+            switch(m_color_type) {
+                case 0: channels = 1; break;
+                case 2: channels = 3; break;
+                case 3: channels = 1; break;
+                case 4: channels = 2; break;
+                case 6: channels = 4; break;
+                default: fail("the color type is unknown");
+            }
+            const auto low_depth = m_bit_depth == 1 || m_bit_depth == 2 || m_bit_depth == 4;
+            if(!(m_bit_depth == 8 || (m_bit_depth == 16 && m_color_type != 3)
+                    || (low_depth && (m_color_type == 0 || m_color_type == 3)))) {
+                fail("the bit depth isn't valid for the color type");
+            }
+            // Palette entries are expanded to their colors.
+            const auto output_channels = m_color_type == 3 ? (m_has_alpha ? 4 : 3) : channels;
+            const auto first_format = m_bit_depth == 16 ? PixelFormat::R16 : PixelFormat::R8;
+            format = static_cast<PixelFormat>(static_cast<unsigned int>(first_format) + output_channels - 1);
+            const auto bits = static_cast<std::size_t>(channels) * m_bit_depth;
+            m_bpp = std::max<std::size_t>(bits / 8, 1);
+            m_row.resize((static_cast<std::size_t>(width) * bits + 7) / 8 + 1);
+            m_previous.assign(m_row.size() - 1, 0);
+        }
+
+        bool PngSource::feed_input() {
+            while(m_chunk_left == 0) {
+                Uint8 chunk[12];
+                read(chunk, sizeof(chunk));   // CRC of the previous chunk and header of the next one.
+                const auto length = read_big_endian(chunk + 4);
+                if(std::memcmp(chunk + 8, "IDAT", 4) == 0) {
+                    m_chunk_left = length;
+                } else if(std::memcmp(chunk + 8, "IEND", 4) == 0) {
+                    return false;
+                } else {
+                    m_file.seekg(length, std::ios::cur);
+                }
+            }
+            const auto size = std::min<std::size_t>(m_chunk_left, m_input.size());
+            read(m_input.data(), size);
+            m_chunk_left -= static_cast<Uint32>(size);
+            m_stream.next_in = m_input.data();
+            m_stream.avail_in = static_cast<uInt>(size);
+            return true;
+        }
+
+        void PngSource::unfilter() {
+            const auto row = m_row.data() + 1;
+            const auto previous = m_previous.data();
+            const auto size = m_previous.size();
+            switch(m_row[0]) {
+                case 0:
+                    break;
+                case 1:
+                    for(auto i = m_bpp; i < size; ++i) {
+                        row[i] = static_cast<Uint8>(row[i] + row[i - m_bpp]);
+                    }
+                    break;
+                case 2:
+                    for(std::size_t i = 0; i < size; ++i) {
+                        row[i] = static_cast<Uint8>(row[i] + previous[i]);
+                    }
+                    break;
+                case 3:
+                    for(std::size_t i = 0; i < size; ++i) {
+                        const auto left = i >= m_bpp ? row[i - m_bpp] : 0;
+                        row[i] = static_cast<Uint8>(row[i] + (left + previous[i]) / 2);
+                    }
+                    break;
+                case 4:
+                    for(std::size_t i = 0; i < size; ++i) {
+                        const auto left = i >= m_bpp ? row[i - m_bpp] : 0;
+                        const auto upper_left = i >= m_bpp ? previous[i - m_bpp] : 0;
+                        row[i] = static_cast<Uint8>(row[i] + paeth(left, previous[i], upper_left));
+                    }
+                    break;
+                default:
+                    fail("the filter type is unknown");
+            }
+            std::memcpy(previous, row, size);
+        }
+
+        void PngSource::read_row(Uint8* pixels) {
+            m_stream.next_out = m_row.data();
+            m_stream.avail_out = static_cast<uInt>(m_row.size());
+            while(m_stream.avail_out > 0) {
+                if(m_stream.avail_in == 0 && !feed_input()) {
+                    fail("the image data ends early");
+                }
+                const auto result = inflate(&m_stream, Z_NO_FLUSH);
+                if(result == Z_STREAM_END && m_stream.avail_out > 0) {
+                    fail("the image data ends early");
+                }
+                if(result != Z_OK && result != Z_STREAM_END && result != Z_BUF_ERROR) {
+                    fail("the image data is corrupted");
+                }
+            }
+            unfilter();
+            const auto row = m_row.data() + 1;
+            if(m_bit_depth == 16) {
+                // Samples are big endian in the file and native in images.
+                for(std::size_t i = 0; i < m_previous.size(); i += 2) {
+                    const auto sample = static_cast<Uint16>(row[i] << 8 | row[i + 1]);
+                    std::memcpy(pixels + i, &sample, sizeof(sample));
+                }
+            } else if(m_color_type == 3) {
+                const auto mask = (1u << m_bit_depth) - 1;
+                const auto channels = m_has_alpha ? 4u : 3u;
+                for(unsigned int x = 0; x < width; ++x) {
+                    const auto bit = static_cast<std::size_t>(x) * m_bit_depth;
+                    const auto index = (row[bit / 8] >> (8 - m_bit_depth - bit % 8)) & mask;
+                    std::memcpy(pixels + static_cast<std::size_t>(x) * channels, &m_palette[index * 4], channels);
+                }
+            } else if(m_bit_depth < 8) {
+                const auto mask = (1u << m_bit_depth) - 1;
+                const auto scale = 255 / mask;
+                for(unsigned int x = 0; x < width; ++x) {
+                    const auto bit = static_cast<std::size_t>(x) * m_bit_depth;
+                    pixels[x] = static_cast<Uint8>(((row[bit / 8] >> (8 - m_bit_depth - bit % 8)) & mask) * scale);
+                }
+            } else {
+                std::memcpy(pixels, row, m_previous.size());
+            }
+        }
+
+        struct JpegError {
+            jpeg_error_mgr manager{};
+            std::jmp_buf   jump{};
+            char           message[JMSG_LENGTH_MAX]{};
+        };
+
+        // libjpeg can't return errors, it calls this and expects it not to return.
+        [[noreturn]] void exit_on_jpeg_error(j_common_ptr info) {
+            auto& error = *reinterpret_cast<JpegError*>(info->err);
+            (*info->err->format_message)(info, error.message);
+            std::longjmp(error.jump, 1);
+        }
+
+        class JpegSource final : public RowSource {
+        public:
+            JpegSource() = default;
+            ~JpegSource() override;
+
+            // Errors longjmp back into the function which called libjpeg, so it mustn't have any objects with
+            // destructors. That's why this isn't done by the constructor.
+            void open(const std::string& filename);
+
+            void read_row(Uint8* pixels) override;
+
+        private:
+            [[noreturn]] void fail(const std::string& reason) const;
+
+            std::string            m_filename{};
+            std::FILE*             m_file{nullptr};
+            jpeg_decompress_struct m_info{};
+            JpegError              m_error{};
+            bool                   m_created{false};
+        };
+
+        JpegSource::~JpegSource() {
+            if(m_created) {
+                jpeg_destroy_decompress(&m_info);
+            }
+            if(m_file != nullptr) {
+                std::fclose(m_file);
+            }
+        }
+
+        void JpegSource::fail(const std::string& reason) const {
+            throw std::runtime_error{"Failed to decode image \"" + m_filename + "\": " + reason + "."};
+        }
+
+        void JpegSource::open(const std::string& filename) {
+            m_filename = filename;
+            m_file = std::fopen(filename.c_str(), "rb");
+            if(m_file == nullptr) {
+                throw std::runtime_error{"Failed to open image \"" + filename + "\"."};
+            }
+            m_info.err = jpeg_std_error(&m_error.manager);
+            m_error.manager.error_exit = exit_on_jpeg_error;
+            if(setjmp(m_error.jump) != 0) {
+                fail(m_error.message);
+            }
+            jpeg_create_decompress(&m_info);
+            m_created = true;
+            jpeg_stdio_src(&m_info, m_file);
+            jpeg_read_header(&m_info, TRUE);
+            // Progressive files are decoded from all of their scans at once, which needs memory for the whole image.
+            if(jpeg_has_multiple_scans(&m_info)) {
+                fail("progressive files can't be decoded row by row");
+            }
+            if(m_info.jpeg_color_space == JCS_GRAYSCALE) {
+                m_info.out_color_space = JCS_GRAYSCALE;
+                format = PixelFormat::R8;
+            } else if(m_info.num_components == 3) {
+                m_info.out_color_space = JCS_RGB;
+                format = PixelFormat::RGB8;
+            } else {
+                fail("only grayscale and color files are supported");
+            }
+            jpeg_start_decompress(&m_info);
+            width = m_info.output_width;
+            height = m_info.output_height;
+        }
+
+        void JpegSource::read_row(Uint8* pixels) {
+            if(setjmp(m_error.jump) != 0) {
+                fail(m_error.message);
+            }
+            JSAMPROW row = pixels;
+            jpeg_read_scanlines(&m_info, &row, 1);
+        }
+
+    }
+
+    struct ImageRowDecoder::Impl {
+        std::string                filename{};
+        std::unique_ptr<RowSource> source{};
+        unsigned int               next_row{0};
+    };
+
+    ImageRowDecoder::ImageRowDecoder() noexcept = default;
+
+    ImageRowDecoder::~ImageRowDecoder() = default;
+
+    void ImageRowDecoder::open(const std::string_view filename) {
+        m_impl.reset();
+        const std::string name{filename};
+        std::array<Uint8, 8> signature{};
+        std::ifstream file{name, std::ios::binary};
+        file.read(reinterpret_cast<char*>(signature.data()), signature.size());
+        if(!file.good()) {
+            throw std::runtime_error{"Failed to open image \"" + name + "\"."};
+        }
+        file.close();
+        auto impl = std::make_unique<Impl>();
+        impl->filename = name;
+        if(signature == PNG_SIGNATURE) {
+            impl->source = std::make_unique<PngSource>(name);
+        } else if(signature[0] == 0xFF && signature[1] == 0xD8) {
+            auto source = std::make_unique<JpegSource>();
+            source->open(name);
+            impl->source = std::move(source);
+        } else {
+            throw std::runtime_error{"Failed to open image \"" + name
+                    + "\": only PNG and JPEG files can be decoded row by row."};
+        }
+        if(impl->source->width == 0 || impl->source->height == 0) {
+            throw std::runtime_error{"Failed to open image \"" + name + "\": the image is empty."};
+        }
+        m_impl = std::move(impl);
+    }
+
+    void ImageRowDecoder::read_rows(Uint8* pixels, const std::size_t stride, const unsigned int count) {
+        if(m_impl == nullptr) {
+            throw std::runtime_error{"Failed to decode image: no file is open."};
+        }
+        if(count > m_impl->source->height - m_impl->next_row) {
+            throw std::runtime_error{"Failed to decode image \"" + m_impl->filename + "\": there are fewer rows left."};
+        }
+        for(unsigned int row = 0; row < count; ++row) {
+            m_impl->source->read_row(pixels + row * stride);
+            ++m_impl->next_row;
+        }
+    }
+
+    unsigned int ImageRowDecoder::width() const noexcept {
+        return m_impl != nullptr ? m_impl->source->width : 0;
+    }
+
+    unsigned int ImageRowDecoder::height() const noexcept {
+        return m_impl != nullptr ? m_impl->source->height : 0;
+    }
+
+    PixelFormat ImageRowDecoder::format() const noexcept {
+        return m_impl != nullptr ? m_impl->source->format : PixelFormat::RGBA8;
+    }
+
+}
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <string>
+
+#include <ogf/graphics/pixel_format.hxx>
+#include <ogf/types.hxx>
+
+namespace ogf {
+
+    // Decodes an image file row by row from the top, keeping just a few rows in memory, so images far bigger than
+    // memory can be processed. Takes non-interlaced PNG and baseline JPEG files. Pixels get the same format as with
+    // Image::load_from_file(): palette PNGs are expanded to RGB8 or RGBA8 and grayscale ones with fewer than 8 bits are
+    // scaled to R8. JPEG files are decoded to R8 or RGB8.
+    class ImageRowDecoder {
+    public:
+        ImageRowDecoder() noexcept;
+        ~ImageRowDecoder();
+
+        ImageRowDecoder(const ImageRowDecoder&) = delete;
+        ImageRowDecoder& operator=(const ImageRowDecoder&) = delete;
+
+        // Read the header of the file. Throws if the file can't be opened or can't be decoded row by row.
+        void open(const std::string_view filename);
+
+        // Decode the next rows, stride bytes apart. Throws if the file is corrupted or has fewer rows left.
+        void read_rows(Uint8* pixels, const std::size_t stride, const unsigned int count);
+
+        unsigned int width() const noexcept;
+        unsigned int height() const noexcept;
+        PixelFormat format() const noexcept;
+
+    private:
+        struct Impl;
+        std::unique_ptr<Impl> m_impl{};
+    };
+
+}
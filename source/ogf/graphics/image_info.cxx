@@ -0,0 +1,44 @@
+#include <ogf/graphics/image_info.hxx>
+
+#include <algorithm>
+#include <array>
+#include <fstream>
+
+#include <stb_image.h>
+
+namespace ogf {
+
+    namespace {
+
+        // stb_image can decode 16-bit PNG files, but the bundled version can't tell them apart, so the bit depth is
+        // read from the IHDR chunk, which always comes first.
+        bool is_16_bit_png(const std::string& filename) {
+            std::ifstream file{filename, std::ios::binary};
+            std::array<unsigned char, 25> header{};
+            file.read(reinterpret_cast<char*>(header.data()), header.size());
+            constexpr std::array<unsigned char, 8> signature{0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+            return file.good() && std::equal(signature.begin(), signature.end(), header.begin())
+                    && header[24] == 16;
+        }
+
+    }
+
+    bool read_image_info(const std::string_view filename, ImageInfo& info) {
+        const std::string name{filename};
+        int width{}, height{}, channels{};
+        if(!stbi_info(name.c_str(), &width, &height, &channels) || channels < 1 || channels > 4) {
+            return false;
+        }
+        auto first_format = PixelFormat::R8;
+        if(stbi_is_hdr(name.c_str())) {
+            first_format = PixelFormat::R32F;
+        } else if(is_16_bit_png(name)) {
+            first_format = PixelFormat::R16;
+        }
+        info.width = static_cast<unsigned int>(width);
+        info.height = static_cast<unsigned int>(height);
+        info.format = static_cast<PixelFormat>(static_cast<unsigned int>(first_format) + channels - 1);
+        return true;
+    }
+
+}
@@ -0,0 +1,19 @@
+#pragma once
+
+#include <string>
+
+#include <ogf/graphics/pixel_format.hxx>
+
+namespace ogf {
+
+    struct ImageInfo {
+        unsigned int width{};
+        unsigned int height{};
+        PixelFormat  format{};   // Format Image::load_from_file() decodes the file to.
+    };
+
+    // Read the size and pixel format of an image file from its header, without decoding it. Returns false if the file
+    // can't be opened or isn't a supported image.
+    bool read_image_info(const std::string_view filename, ImageInfo& info);
+
+}
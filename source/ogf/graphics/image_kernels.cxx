@@ -0,0 +1,444 @@
+#include <ogf/graphics/image_kernels.hxx>
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#define OGF_IMAGE_KERNELS_SSE2
+#include <immintrin.h>
+#endif
+
+#if defined(OGF_IMAGE_KERNELS_SSE2) && defined(__GNUC__)
+#define OGF_IMAGE_KERNELS_AVX2
+#endif
+
+#include <ogf/graphics/pixel_conversion.hxx>
+#include <ogf/utils/thread_pool.hxx>
+
+namespace ogf {
+
+    namespace {
+
+        // Bytes processed by a single task. Big enough to amortize scheduling, small enough to balance the load.
+        constexpr std::size_t BYTES_PER_TASK = 256 * 1024;
+
+        // Call body(first, last) for bands of rows covering [0 .. rows).
+        template<typename F>
+        void for_each_band(const unsigned int rows, const std::size_t row_bytes, const F& body) {
+            if(rows == 0 || row_bytes == 0) {
+                return;
+            }
+            const auto rows_per_task = static_cast<unsigned int>(
+                    std::clamp<std::size_t>(BYTES_PER_TASK / row_bytes, 1, rows));
+            const auto tasks = (rows + rows_per_task - 1) / rows_per_task;
+            if(tasks == 1) {
+                body(0u, rows);
+                return;
+            }
+            parallel_for(tasks, [&](const std::size_t task) {
+                const auto first = static_cast<unsigned int>(task) * rows_per_task;
+                body(first, std::min(first + rows_per_task, rows));
+            });
+        }
+
+        // x * y / 255 rounded to nearest. Exact for all 8-bit inputs.
+        Uint8 multiply_255(const unsigned int x, const unsigned int y) {
+            const auto t = x * y + 128;
+            return static_cast<Uint8>((t + (t >> 8)) >> 8);
+        }
+
+        using Rgba8Kernel = void (*)(Uint8*, const std::size_t);
+        using Rgba8BlendKernel = void (*)(const Uint8*, Uint8*, const std::size_t);
+        using Rgba8SwizzleKernel = void (*)(Uint8*, const std::size_t, const Uint8*);
+        using ReverseKernel = void (*)(Uint8*, const std::size_t);
+
+        void premultiply_rgba8_generic(Uint8* pixels, const std::size_t count) {
+            for(std::size_t i = 0; i < count; ++i, pixels += 4) {
+                const auto alpha = pixels[3];
+                pixels[0] = multiply_255(pixels[0], alpha);
+                pixels[1] = multiply_255(pixels[1], alpha);
+                pixels[2] = multiply_255(pixels[2], alpha);
+            }
+        }
+
+        void blend_rgba8_generic(const Uint8* source, Uint8* target, const std::size_t count) {
+            for(std::size_t i = 0; i < count; ++i, source += 4, target += 4) {
+                const auto inverse_alpha = 255u - source[3];
+                for(int channel = 0; channel < 4; ++channel) {
+                    const auto value = source[channel] + multiply_255(target[channel], inverse_alpha);
+                    target[channel] = static_cast<Uint8>(std::min(value, 255));
+                }
+            }
+        }
+
+        void swizzle_rgba8_generic(Uint8* pixels, const std::size_t count, const Uint8* mask) {
+            for(std::size_t i = 0; i < count; ++i, pixels += 4) {
+                const Uint8 pixel[4]{pixels[0], pixels[1], pixels[2], pixels[3]};
+                for(int channel = 0; channel < 4; ++channel) {
+                    pixels[channel] = pixel[mask[channel]];
+                }
+            }
+        }
+
+        // Reverse the order of count 4-byte pixels.
+        void reverse_4byte_generic(Uint8* pixels, const std::size_t count) {
+            for(std::size_t left = 0, right = count; right - left > 1; ++left, --right) {
+                std::swap_ranges(pixels + left * 4, pixels + left * 4 + 4, pixels + (right - 1) * 4);
+            }
+        }
+
+#if defined(OGF_IMAGE_KERNELS_SSE2)
+        // Multiply 16-bit lanes and divide by 255 with the same rounding as multiply_255().
+        __m128i multiply_255_sse2(const __m128i x, const __m128i y) {
+            const auto t = _mm_add_epi16(_mm_mullo_epi16(x, y), _mm_set1_epi16(128));
+            return _mm_srli_epi16(_mm_add_epi16(t, _mm_srli_epi16(t, 8)), 8);
+        }
+
+        // Copy alpha of two pixels unpacked to 16-bit lanes over all lanes of the pixel.
+        __m128i broadcast_alpha_sse2(const __m128i pixels) {
+            return _mm_shufflehi_epi16(_mm_shufflelo_epi16(pixels, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3));
+        }
+
+        void premultiply_rgba8_sse2(Uint8* pixels, const std::size_t count) {
+            const auto zero = _mm_setzero_si128();
+            // Alpha itself is multiplied by 255, which leaves it unchanged.
+            const auto color_mask = _mm_setr_epi16(-1, -1, -1, 0, -1, -1, -1, 0);
+            const auto alpha_factor = _mm_setr_epi16(0, 0, 0, 255, 0, 0, 0, 255);
+            std::size_t i{0};
+            for(; i + 4 <= count; i += 4) {
+                const auto address = reinterpret_cast<__m128i*>(pixels + i * 4);
+                const auto bytes = _mm_loadu_si128(address);
+                const auto low = _mm_unpacklo_epi8(bytes, zero);
+                const auto high = _mm_unpackhi_epi8(bytes, zero);
+                const auto low_factor = _mm_or_si128(_mm_and_si128(broadcast_alpha_sse2(low), color_mask),
+                        alpha_factor);
+                const auto high_factor = _mm_or_si128(_mm_and_si128(broadcast_alpha_sse2(high), color_mask),
+                        alpha_factor);
+                _mm_storeu_si128(address, _mm_packus_epi16(multiply_255_sse2(low, low_factor),
+                        multiply_255_sse2(high, high_factor)));
+            }
+            premultiply_rgba8_generic(pixels + i * 4, count - i);
+        }
+
+        void blend_rgba8_sse2(const Uint8* source, Uint8* target, const std::size_t count) {
+            const auto zero = _mm_setzero_si128();
+            const auto full = _mm_set1_epi16(255);
+            std::size_t i{0};
+            for(; i + 4 <= count; i += 4) {
+                const auto address = reinterpret_cast<__m128i*>(target + i * 4);
+                const auto front = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + i * 4));
+                const auto back = _mm_loadu_si128(address);
+                const auto low_factor = _mm_sub_epi16(full, broadcast_alpha_sse2(_mm_unpacklo_epi8(front, zero)));
+                const auto high_factor = _mm_sub_epi16(full, broadcast_alpha_sse2(_mm_unpackhi_epi8(front, zero)));
+                const auto scaled = _mm_packus_epi16(multiply_255_sse2(_mm_unpacklo_epi8(back, zero), low_factor),
+                        multiply_255_sse2(_mm_unpackhi_epi8(back, zero), high_factor));
+                _mm_storeu_si128(address, _mm_adds_epu8(front, scaled));
+            }
+            blend_rgba8_generic(source + i * 4, target + i * 4, count - i);
+        }
+
+        void reverse_4byte_sse2(Uint8* pixels, const std::size_t count) {
+            std::size_t left{0}, right{count};
+            // Swap blocks of four pixels from both ends, reversing them on the way.
+            for(; right - left >= 8; left += 4, right -= 4) {
+                const auto left_address = reinterpret_cast<__m128i*>(pixels + left * 4);
+                const auto right_address = reinterpret_cast<__m128i*>(pixels + (right - 4) * 4);
+                const auto left_pixels = _mm_loadu_si128(left_address);
+                const auto right_pixels = _mm_loadu_si128(right_address);
+                _mm_storeu_si128(left_address, _mm_shuffle_epi32(right_pixels, _MM_SHUFFLE(0, 1, 2, 3)));
+                _mm_storeu_si128(right_address, _mm_shuffle_epi32(left_pixels, _MM_SHUFFLE(0, 1, 2, 3)));
+            }
+            reverse_4byte_generic(pixels + left * 4, right - left);
+        }
+#endif
+
+#if defined(OGF_IMAGE_KERNELS_AVX2)
+        __attribute__((target("ssse3")))
+        void swizzle_rgba8_ssse3(Uint8* pixels, const std::size_t count, const Uint8* mask) {
+            const auto shuffle = _mm_loadu_si128(reinterpret_cast<const __m128i*>(mask));
+            std::size_t i{0};
+            for(; i + 4 <= count; i += 4) {
+                const auto address = reinterpret_cast<__m128i*>(pixels + i * 4);
+                _mm_storeu_si128(address, _mm_shuffle_epi8(_mm_loadu_si128(address), shuffle));
+            }
+            swizzle_rgba8_generic(pixels + i * 4, count - i, mask);
+        }
+
+        __attribute__((target("avx2")))
+        void swizzle_rgba8_avx2(Uint8* pixels, const std::size_t count, const Uint8* mask) {
+            // The shuffle works within 128-bit lanes, which never splits a pixel.
+            const auto shuffle = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(mask)));
+            std::size_t i{0};
+            for(; i + 8 <= count; i += 8) {
+                const auto address = reinterpret_cast<__m256i*>(pixels + i * 4);
+                _mm256_storeu_si256(address, _mm256_shuffle_epi8(_mm256_loadu_si256(address), shuffle));
+            }
+            swizzle_rgba8_ssse3(pixels + i * 4, count - i, mask);
+        }
+
+        __attribute__((target("avx2")))
+        __m256i multiply_255_avx2(const __m256i x, const __m256i y) {
+            const auto t = _mm256_add_epi16(_mm256_mullo_epi16(x, y), _mm256_set1_epi16(128));
+            return _mm256_srli_epi16(_mm256_add_epi16(t, _mm256_srli_epi16(t, 8)), 8);
+        }
+
+        __attribute__((target("avx2")))
+        __m256i broadcast_alpha_avx2(const __m256i pixels) {
+            return _mm256_shufflehi_epi16(_mm256_shufflelo_epi16(pixels, _MM_SHUFFLE(3, 3, 3, 3)),
+                    _MM_SHUFFLE(3, 3, 3, 3));
+        }
+
+        __attribute__((target("avx2")))
+        void premultiply_rgba8_avx2(Uint8* pixels, const std::size_t count) {
+            const auto zero = _mm256_setzero_si256();
+            const auto color_mask = _mm256_setr_epi16(-1, -1, -1, 0, -1, -1, -1, 0, -1, -1, -1, 0, -1, -1, -1, 0);
+            const auto alpha_factor = _mm256_setr_epi16(0, 0, 0, 255, 0, 0, 0, 255, 0, 0, 0, 255, 0, 0, 0, 255);
+            std::size_t i{0};
+            for(; i + 8 <= count; i += 8) {
+                const auto address = reinterpret_cast<__m256i*>(pixels + i * 4);
+                const auto bytes = _mm256_loadu_si256(address);
+                // Unpacking and packing both work within 128-bit lanes, so the pixel order is kept.
+                const auto low = _mm256_unpacklo_epi8(bytes, zero);
+                const auto high = _mm256_unpackhi_epi8(bytes, zero);
+                const auto low_factor = _mm256_or_si256(_mm256_and_si256(broadcast_alpha_avx2(low), color_mask),
+                        alpha_factor);
+                const auto high_factor = _mm256_or_si256(_mm256_and_si256(broadcast_alpha_avx2(high), color_mask),
+                        alpha_factor);
+                _mm256_storeu_si256(address, _mm256_packus_epi16(multiply_255_avx2(low, low_factor),
+                        multiply_255_avx2(high, high_factor)));
+            }
+            premultiply_rgba8_sse2(pixels + i * 4, count - i);
+        }
+
+        __attribute__((target("avx2")))
+        void blend_rgba8_avx2(const Uint8* source, Uint8* target, const std::size_t count) {
+            const auto zero = _mm256_setzero_si256();
+            const auto full = _mm256_set1_epi16(255);
+            std::size_t i{0};
+            for(; i + 8 <= count; i += 8) {
+                const auto address = reinterpret_cast<__m256i*>(target + i * 4);
+                const auto front = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(source + i * 4));
+                const auto back = _mm256_loadu_si256(address);
+                const auto low_factor = _mm256_sub_epi16(full, broadcast_alpha_avx2(_mm256_unpacklo_epi8(front, zero)));
+                const auto high_factor = _mm256_sub_epi16(full,
+                        broadcast_alpha_avx2(_mm256_unpackhi_epi8(front, zero)));
+                const auto scaled = _mm256_packus_epi16(
+                        multiply_255_avx2(_mm256_unpacklo_epi8(back, zero), low_factor),
+                        multiply_255_avx2(_mm256_unpackhi_epi8(back, zero), high_factor));
+                _mm256_storeu_si256(address, _mm256_adds_epu8(front, scaled));
+            }
+            blend_rgba8_sse2(source + i * 4, target + i * 4, count - i);
+        }
+
+        __attribute__((target("avx2")))
+        void reverse_4byte_avx2(Uint8* pixels, const std::size_t count) {
+            const auto reverse = _mm256_setr_epi32(7, 6, 5, 4, 3, 2, 1, 0);
+            std::size_t left{0}, right{count};
+            for(; right - left >= 16; left += 8, right -= 8) {
+                const auto left_address = reinterpret_cast<__m256i*>(pixels + left * 4);
+                const auto right_address = reinterpret_cast<__m256i*>(pixels + (right - 8) * 4);
+                const auto left_pixels = _mm256_loadu_si256(left_address);
+                const auto right_pixels = _mm256_loadu_si256(right_address);
+                _mm256_storeu_si256(left_address, _mm256_permutevar8x32_epi32(right_pixels, reverse));
+                _mm256_storeu_si256(right_address, _mm256_permutevar8x32_epi32(left_pixels, reverse));
+            }
+            reverse_4byte_sse2(pixels + left * 4, right - left);
+        }
+#endif
+
+        // The widest implementation supported by the CPU is picked once.
+
+        Rgba8Kernel select_premultiply_rgba8() {
+#if defined(OGF_IMAGE_KERNELS_AVX2)
+            if(__builtin_cpu_supports("avx2")) {
+                return premultiply_rgba8_avx2;
+            }
+#endif
+#if defined(OGF_IMAGE_KERNELS_SSE2)
+            return premultiply_rgba8_sse2;
+#else
+            return premultiply_rgba8_generic;
+#endif
+        }
+
+        Rgba8BlendKernel select_blend_rgba8() {
+#if defined(OGF_IMAGE_KERNELS_AVX2)
+            if(__builtin_cpu_supports("avx2")) {
+                return blend_rgba8_avx2;
+            }
+#endif
+#if defined(OGF_IMAGE_KERNELS_SSE2)
+            return blend_rgba8_sse2;
+#else
+            return blend_rgba8_generic;
+#endif
+        }
+
+        Rgba8SwizzleKernel select_swizzle_rgba8() {
+#if defined(OGF_IMAGE_KERNELS_AVX2)
+            if(__builtin_cpu_supports("avx2")) {
+                return swizzle_rgba8_avx2;
+            }
+            if(__builtin_cpu_supports("ssse3")) {
+                return swizzle_rgba8_ssse3;
+            }
+#endif
+            return swizzle_rgba8_generic;
+        }
+
+        ReverseKernel select_reverse_4byte() {
+#if defined(OGF_IMAGE_KERNELS_AVX2)
+            if(__builtin_cpu_supports("avx2")) {
+                return reverse_4byte_avx2;
+            }
+#endif
+#if defined(OGF_IMAGE_KERNELS_SSE2)
+            return reverse_4byte_sse2;
+#else
+            return reverse_4byte_generic;
+#endif
+        }
+
+        std::size_t row_bytes(const MutableImageView& view) {
+            return static_cast<std::size_t>(view.width) * pixel_size(view.format);
+        }
+
+    }
+
+    void fill_pixels(const MutableImageView& target, const Uint8* pixel) {
+        // One row is built pixel by pixel, the rest are plain copies of it.
+        const auto size = pixel_size(target.format);
+        std::vector<Uint8> pattern(row_bytes(target));
+        for(std::size_t offset = 0; offset < pattern.size(); offset += size) {
+            std::memcpy(pattern.data() + offset, pixel, size);
+        }
+        for_each_band(target.height, pattern.size(), [&](const unsigned int first, const unsigned int last) {
+            for(auto y = first; y < last; ++y) {
+                std::memcpy(target.row(y), pattern.data(), pattern.size());
+            }
+        });
+    }
+
+    void copy_pixels(const ImageView& source, const MutableImageView& target) {
+        for_each_band(target.height, row_bytes(target), [&](const unsigned int first, const unsigned int last) {
+            for(auto y = first; y < last; ++y) {
+                convert_pixels(source.row(y), source.format, target.row(y), target.format, target.width);
+            }
+        });
+    }
+
+    void blend_pixels_over(const ImageView& source, const MutableImageView& target) {
+        if(source.format == PixelFormat::RGBA8 && target.format == PixelFormat::RGBA8) {
+            static const auto kernel = select_blend_rgba8();
+            for_each_band(target.height, row_bytes(target), [&](const unsigned int first, const unsigned int last) {
+                for(auto y = first; y < last; ++y) {
+                    kernel(source.row(y), target.row(y), target.width);
+                }
+            });
+            return;
+        }
+        // Everything else is blended in floats.
+        for_each_band(target.height, row_bytes(target), [&](const unsigned int first, const unsigned int last) {
+            std::vector<float> front(static_cast<std::size_t>(target.width) * 4);
+            std::vector<float> back(front.size());
+            for(auto y = first; y < last; ++y) {
+                decode_pixels(source.row(y), source.format, front.data(), target.width);
+                decode_pixels(target.row(y), target.format, back.data(), target.width);
+                for(std::size_t i = 0; i < front.size(); i += 4) {
+                    const auto inverse_alpha = 1.0f - front[i + 3];
+                    for(std::size_t channel = 0; channel < 4; ++channel) {
+                        back[i + channel] = front[i + channel] + back[i + channel] * inverse_alpha;
+                    }
+                }
+                encode_pixels(back.data(), target.row(y), target.format, target.width);
+            }
+        });
+    }
+
+    void swizzle_pixels(const MutableImageView& target, const std::array<unsigned int, 4>& order) {
+        const auto channels = channel_count(target.format);
+        const auto size = channel_size(target.format);
+        if(target.format == PixelFormat::RGBA8) {
+            static const auto kernel = select_swizzle_rgba8();
+            // Byte shuffle mask for four pixels, the scalar code uses just the first four entries.
+            Uint8 mask[16]{};
+            for(unsigned int i = 0; i < 16; ++i) {
+                mask[i] = static_cast<Uint8>(i / 4 * 4 + order[i % 4]);
+            }
+            for_each_band(target.height, row_bytes(target), [&](const unsigned int first, const unsigned int last) {
+                for(auto y = first; y < last; ++y) {
+                    kernel(target.row(y), target.width, mask);
+                }
+            });
+            return;
+        }
+        for_each_band(target.height, row_bytes(target), [&](const unsigned int first, const unsigned int last) {
+            Uint8 pixel[16]{};
+            for(auto y = first; y < last; ++y) {
+                auto pixels = target.row(y);
+                for(unsigned int x = 0; x < target.width; ++x, pixels += channels * size) {
+                    std::memcpy(pixel, pixels, channels * size);
+                    for(unsigned int channel = 0; channel < channels; ++channel) {
+                        std::memcpy(pixels + channel * size, pixel + order[channel] * size, size);
+                    }
+                }
+            }
+        });
+    }
+
+    void premultiply_pixels(const MutableImageView& target) {
+        if(channel_count(target.format) % 2 != 0) {
+            return;
+        }
+        if(target.format == PixelFormat::RGBA8) {
+            static const auto kernel = select_premultiply_rgba8();
+            for_each_band(target.height, row_bytes(target), [&](const unsigned int first, const unsigned int last) {
+                for(auto y = first; y < last; ++y) {
+                    kernel(target.row(y), target.width);
+                }
+            });
+            return;
+        }
+        for_each_band(target.height, row_bytes(target), [&](const unsigned int first, const unsigned int last) {
+            std::vector<float> pixels(static_cast<std::size_t>(target.width) * 4);
+            for(auto y = first; y < last; ++y) {
+                decode_pixels(target.row(y), target.format, pixels.data(), target.width);
+                for(std::size_t i = 0; i < pixels.size(); i += 4) {
+                    pixels[i] *= pixels[i + 3];
+                    pixels[i + 1] *= pixels[i + 3];
+                    pixels[i + 2] *= pixels[i + 3];
+                }
+                encode_pixels(pixels.data(), target.row(y), target.format, target.width);
+            }
+        });
+    }
+
+    void flip_pixels_horizontally(const MutableImageView& target) {
+        const auto size = pixel_size(target.format);
+        static const auto reverse_4byte = select_reverse_4byte();
+        for_each_band(target.height, row_bytes(target), [&](const unsigned int first, const unsigned int last) {
+            for(auto y = first; y < last; ++y) {
+                auto pixels = target.row(y);
+                if(size == 4) {
+                    reverse_4byte(pixels, target.width);
+                    continue;
+                }
+                for(std::size_t left = 0, right = target.width; right - left > 1; ++left, --right) {
+                    std::swap_ranges(pixels + left * size, pixels + (left + 1) * size, pixels + (right - 1) * size);
+                }
+            }
+        });
+    }
+
+    void flip_pixels_vertically(const MutableImageView& target) {
+        const auto bytes = row_bytes(target);
+        for_each_band(target.height / 2, bytes, [&](const unsigned int first, const unsigned int last) {
+            for(auto y = first; y < last; ++y) {
+                const auto top = target.row(y);
+                std::swap_ranges(top, top + bytes, target.row(target.height - 1 - y));
+            }
+        });
+    }
+
+}
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+
+#include <ogf/graphics/image_view.hxx>
+#include <ogf/types.hxx>
+
+namespace ogf {
+
+    // Bulk pixel operations behind the Image methods. Big views are split into row bands running on the library
+    // thread pool, small ones are processed on the calling thread. Rows are processed with SIMD where available.
+
+    // Set every pixel to given pixel, encoded in the view format.
+    void fill_pixels(const MutableImageView& target, const Uint8* pixel);
+
+    // Copy pixels into a view of the same size, converting them to the target format. The views can't overlap.
+    void copy_pixels(const ImageView& source, const MutableImageView& target);
+
+    // Blend pixels over a view of the same size. Both have premultiplied alpha; formats without alpha are opaque.
+    void blend_pixels_over(const ImageView& source, const MutableImageView& target);
+
+    // Channel i of every pixel becomes its channel order[i]. Only the first channel_count() entries are used.
+    void swizzle_pixels(const MutableImageView& target, const std::array<unsigned int, 4>& order);
+
+    // Multiply colors by alpha. Does nothing for formats without alpha.
+    void premultiply_pixels(const MutableImageView& target);
+
+    void flip_pixels_horizontally(const MutableImageView& target);
+    void flip_pixels_vertically(const MutableImageView& target);
+
+}
@@ -0,0 +1,136 @@
+#include <ogf/graphics/mipmaps.hxx>
+
+#include <algorithm>
+#include <array>
+#include <fstream>
+#include <stdexcept>
+
+#include <ogf/graphics/image.hxx>
+#include <ogf/graphics/resampler.hxx>
+
+namespace ogf {
+
+    namespace {
+
+        constexpr std::array<char, 8> CACHE_MAGIC{'O', 'G', 'F', 'M', 'I', 'P', '0', '2'};
+
+        template<typename T>
+        void write_value(std::ofstream& file, const T value) {
+            file.write(reinterpret_cast<const char*>(&value), sizeof(value));
+        }
+
+        template<typename T>
+        T read_value(std::ifstream& file) {
+            T value{};
+            file.read(reinterpret_cast<char*>(&value), sizeof(value));
+            return value;
+        }
+
+    }
+
+    std::vector<Image> generate_mipmaps(const ImageView& image, const MipmapFilter filter, const bool srgb) {
+        const auto [width, height] = image.size();
+        std::vector<Image> mipmaps{};
+        if(width <= 1 && height <= 1) {
+            return mipmaps;
+        }
+        const auto kernel = filter == MipmapFilter::KAISER ? ResampleKernel::KAISER : ResampleKernel::BOX;
+        // Every level is filtered from the previous one kept in floats, so rounding errors don't accumulate. Colors
+        // are weighted by alpha, so transparent pixels don't bleed into their neighbours.
+        const auto format = image.format;
+        const auto has_alpha = channel_count(format) % 2 == 0;
+        auto level = to_linear(image.pixels, format, width, height, image.stride, srgb);
+        if(has_alpha) {
+            premultiply(level);
+        }
+        FloatImage straight{};
+        while(level.width > 1 || level.height > 1) {
+            level = resample(level, std::max(level.width / 2, 1u), std::max(level.height / 2, 1u), kernel);
+            const auto* output = &level;
+            if(has_alpha) {
+                straight = level;
+                unpremultiply(straight);
+                output = &straight;
+            }
+            Image& mipmap = mipmaps.emplace_back();
+            mipmap.create(level.width, level.height, Color::BLACK, format);
+            from_linear(*output, mipmap.pixels(), format, mipmap.stride(), srgb);
+        }
+        return mipmaps;
+    }
+
+    void save_mipmaps_to_file(const std::string_view filename, const std::vector<Image>& mipmaps) {
+        std::ofstream file{std::string{filename}, std::ios::binary};
+        if(!file.good()) {
+            throw std::runtime_error{"Failed to open mipmap cache \"" + std::string{filename} + "\" for writing."};
+        }
+        file.write(CACHE_MAGIC.data(), CACHE_MAGIC.size());
+        write_value(file, static_cast<Uint32>(mipmaps.size()));
+        for(const auto& mipmap : mipmaps) {
+            const auto [width, height] = mipmap.size();
+            write_value(file, static_cast<Uint32>(width));
+            write_value(file, static_cast<Uint32>(height));
+            write_value(file, static_cast<Uint32>(mipmap.format()));
+            // Rows are stored without their padding, so the cache doesn't depend on the row alignment.
+            const auto row_bytes = static_cast<std::size_t>(width) * pixel_size(mipmap.format());
+            for(unsigned int y = 0; y < height; ++y) {
+                file.write(reinterpret_cast<const char*>(mipmap.pixels() + y * mipmap.stride()), row_bytes);
+            }
+        }
+        if(!file.good()) {
+            throw std::runtime_error{"Failed to write mipmap cache \"" + std::string{filename} + "\"."};
+        }
+    }
+
+    std::vector<Image> load_mipmaps_from_file(const std::string_view filename) {
+        std::ifstream file{std::string{filename}, std::ios::binary | std::ios::ate};
+        const auto file_size = static_cast<std::streamoff>(file.tellg());
+        file.seekg(0);
+        std::array<char, 8> magic{};
+        file.read(magic.data(), magic.size());
+        if(!file.good() || magic != CACHE_MAGIC) {
+            throw std::runtime_error{"Failed to open mipmap cache \"" + std::string{filename} + "\"."};
+        }
+        const auto corrupted = [&]() {
+            return std::runtime_error{"Mipmap cache \"" + std::string{filename} + "\" is corrupted."};
+        };
+        const auto count = read_value<Uint32>(file);
+        // A 32-bit sized texture can't have more levels than that.
+        if(!file.good() || count > 32) {
+            throw corrupted();
+        }
+        std::vector<Image> mipmaps(count);
+        Uint32 previous_width{0}, previous_height{0};
+        for(auto& mipmap : mipmaps) {
+            const auto width = read_value<Uint32>(file);
+            const auto height = read_value<Uint32>(file);
+            const auto format = read_value<Uint32>(file);
+            if(!file.good() || format > static_cast<Uint32>(PixelFormat::RGBA32F) || width == 0 || height == 0) {
+                throw corrupted();
+            }
+            // Every level halves the previous one, and its pixels have to be in the rest of the file, so a corrupted
+            // header can't make this allocate more than the file holds.
+            if(previous_width != 0 && (width != std::max(previous_width / 2, 1u)
+                    || height != std::max(previous_height / 2, 1u))) {
+                throw corrupted();
+            }
+            const auto row_bytes = static_cast<std::size_t>(width) * pixel_size(static_cast<PixelFormat>(format));
+            const auto remaining = static_cast<std::size_t>(file_size - static_cast<std::streamoff>(file.tellg()));
+            if(remaining / row_bytes < height) {
+                throw corrupted();
+            }
+            previous_width = width;
+            previous_height = height;
+            // Every row is read from the file, so the pixels aren't cleared.
+            mipmap.allocate(width, height, static_cast<PixelFormat>(format));
+            for(Uint32 y = 0; y < height; ++y) {
+                file.read(reinterpret_cast<char*>(mipmap.pixels() + y * mipmap.stride()), row_bytes);
+            }
+        }
+        if(!file.good()) {
+            throw corrupted();
+        }
+        return mipmaps;
+    }
+
+}
@@ -0,0 +1,365 @@
+#include <ogf/graphics/pixel_conversion.hxx>
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#define OGF_PIXEL_CONVERSION_SSE2
+#include <immintrin.h>
+#endif
+
+#if defined(OGF_PIXEL_CONVERSION_SSE2) && defined(__GNUC__)
+#define OGF_PIXEL_CONVERSION_SSSE3
+#endif
+
+#include <ogf/graphics/color32.hxx>
+
+namespace ogf {
+
+    namespace {
+
+        // Pixels converted through the float buffer at once.
+        constexpr std::size_t CHUNK_SIZE = 256;
+
+        Uint32 float_bits(const float value) noexcept {
+            Uint32 bits{};
+            std::memcpy(&bits, &value, sizeof(bits));
+            return bits;
+        }
+
+        float bits_float(const Uint32 bits) noexcept {
+            float value{};
+            std::memcpy(&value, &bits, sizeof(value));
+            return value;
+        }
+
+        bool is_8bit(const PixelFormat format) noexcept {
+            return static_cast<unsigned int>(format) < static_cast<unsigned int>(PixelFormat::R16);
+        }
+
+        // Channel of a pixel each RGBA component is read from, or -1 if it's missing. One and two channel formats are
+        // grey and grey with alpha.
+        std::array<int, 4> component_channels(const unsigned int channels) noexcept {
+            switch(channels) {
+                case 1: return {0, 0, 0, -1};
+                case 2: return {0, 0, 0, 1};
+                case 3: return {0, 1, 2, -1};
+                default: return {0, 1, 2, 3};
+            }
+        }
+
+        // RGBA component a channel of a pixel is written from.
+        unsigned int channel_component(const unsigned int channel, const unsigned int channels) noexcept {
+            return channels == 2 && channel == 1 ? 3 : channel;
+        }
+
+        // Buckets of the table giving the first guess of an encoded sRGB value. Even at the steepest part of the curve
+        // a bucket spans less than one 8-bit step, so the guess is either right or one below.
+        constexpr unsigned int SRGB_ENCODE_BUCKETS = 4096;
+
+        const std::array<float, 256>& srgb_decode_table() noexcept {
+            static const auto table = []() {
+                std::array<float, 256> table{};
+                for(std::size_t i = 0; i < table.size(); ++i) {
+                    table[i] = srgb_to_linear(static_cast<float>(i) / 255.0f);
+                }
+                return table;
+            }();
+            return table;
+        }
+
+        struct SrgbEncodeTable {
+            // Encoded value at the start of each bucket, plus one entry for exactly 1.0f.
+            std::array<Uint8, SRGB_ENCODE_BUCKETS + 1> guesses{};
+            // Linear value from which each encoded value rounds up to the next one.
+            std::array<float, 256>                      thresholds{};
+
+            Uint8 encode(const float clamped, const Int32 bucket) const noexcept {
+                const auto guess = guesses[static_cast<std::size_t>(bucket)];
+                return static_cast<Uint8>(guess + (clamped >= thresholds[guess] ? 1 : 0));
+            }
+        };
+
+        const SrgbEncodeTable& srgb_encode_table() noexcept {
+            static const auto table = []() {
+                SrgbEncodeTable table{};
+                for(std::size_t i = 0; i < 255; ++i) {
+                    table.thresholds[i] = srgb_to_linear((static_cast<float>(i) + 0.5f) / 255.0f);
+                }
+                table.thresholds[255] = 2.0f;
+                std::size_t value{0};
+                for(std::size_t bucket = 0; bucket < table.guesses.size(); ++bucket) {
+                    const auto linear = static_cast<float>(bucket) / SRGB_ENCODE_BUCKETS;
+                    while(linear >= table.thresholds[value]) {
+                        ++value;
+                    }
+                    table.guesses[bucket] = static_cast<Uint8>(value);
+                }
+                return table;
+            }();
+            return table;
+        }
+
+        // Clamp the components of a float RGBA pixel and find their encode table buckets.
+        void clamp_to_buckets(const float* rgba, float* clamped, Int32* buckets) noexcept {
+#if defined(OGF_PIXEL_CONVERSION_SSE2)
+            const auto values = _mm_min_ps(_mm_max_ps(_mm_loadu_ps(rgba), _mm_setzero_ps()), _mm_set1_ps(1.0f));
+            _mm_storeu_ps(clamped, values);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(buckets),
+                    _mm_cvttps_epi32(_mm_mul_ps(values, _mm_set1_ps(SRGB_ENCODE_BUCKETS))));
+#else
+            for(int channel = 0; channel < 4; ++channel) {
+                clamped[channel] = std::clamp(rgba[channel], 0.0f, 1.0f);
+                buckets[channel] = static_cast<Int32>(clamped[channel] * SRGB_ENCODE_BUCKETS);
+            }
+#endif
+        }
+
+        // Fast paths for the most common conversions. Each converts as many pixels as it can and returns their count,
+        // the rest goes through the generic code.
+        using FastConversion = std::size_t (*)(const Uint8*, Uint8*, const std::size_t);
+
+        std::size_t no_fast_conversion(const Uint8*, Uint8*, const std::size_t) noexcept {
+            return 0;
+        }
+
+#if defined(OGF_PIXEL_CONVERSION_SSE2)
+        std::size_t rgba8_to_rgba32f(const Uint8* source, Uint8* target, const std::size_t count) noexcept {
+            const auto zero = _mm_setzero_si128();
+            const auto scale = _mm_set1_ps(1.0f / 255.0f);
+            auto output = reinterpret_cast<float*>(target);
+            std::size_t i{0};
+            for(; i + 4 <= count; i += 4) {
+                const auto bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + i * 4));
+                const auto low = _mm_unpacklo_epi8(bytes, zero);
+                const auto high = _mm_unpackhi_epi8(bytes, zero);
+                const __m128i words[4]{_mm_unpacklo_epi16(low, zero), _mm_unpackhi_epi16(low, zero),
+                        _mm_unpacklo_epi16(high, zero), _mm_unpackhi_epi16(high, zero)};
+                for(int pixel = 0; pixel < 4; ++pixel) {
+                    _mm_storeu_ps(output + (i + pixel) * 4, _mm_mul_ps(_mm_cvtepi32_ps(words[pixel]), scale));
+                }
+            }
+            return i;
+        }
+
+        std::size_t rgba32f_to_rgba8(const Uint8* source, Uint8* target, const std::size_t count) noexcept {
+            const auto input = reinterpret_cast<const float*>(source);
+            const auto zero = _mm_setzero_ps();
+            const auto one = _mm_set1_ps(1.0f);
+            const auto scale = _mm_set1_ps(255.0f);
+            const auto half = _mm_set1_ps(0.5f);
+            // Same rounding as the scalar code: clamp, scale, add a half and truncate.
+            const auto quantize = [&](const float* pixel) {
+                const auto clamped = _mm_min_ps(_mm_max_ps(_mm_loadu_ps(pixel), zero), one);
+                return _mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(clamped, scale), half));
+            };
+            std::size_t i{0};
+            for(; i + 4 <= count; i += 4) {
+                const auto low = _mm_packs_epi32(quantize(input + i * 4), quantize(input + i * 4 + 4));
+                const auto high = _mm_packs_epi32(quantize(input + i * 4 + 8), quantize(input + i * 4 + 12));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(target + i * 4), _mm_packus_epi16(low, high));
+            }
+            return i;
+        }
+#endif
+
+#if defined(OGF_PIXEL_CONVERSION_SSSE3)
+        __attribute__((target("ssse3")))
+        std::size_t rgb8_to_rgba8(const Uint8* source, Uint8* target, const std::size_t count) noexcept {
+            const auto shuffle = _mm_setr_epi8(0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11, -1);
+            const auto alpha = _mm_set1_epi32(static_cast<int>(0xFF000000u));
+            std::size_t i{0};
+            // Every load takes 16 bytes but uses only 12, so the loop stops before reading past the source.
+            for(; (i + 4) * 3 + 4 <= count * 3; i += 4) {
+                const auto bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + i * 3));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(target + i * 4),
+                        _mm_or_si128(_mm_shuffle_epi8(bytes, shuffle), alpha));
+            }
+            return i;
+        }
+
+        __attribute__((target("ssse3")))
+        std::size_t rgba8_to_rgb8(const Uint8* source, Uint8* target, const std::size_t count) noexcept {
+            const auto shuffle = _mm_setr_epi8(0, 1, 2, 4, 5, 6, 8, 9, 10, 12, 13, 14, -1, -1, -1, -1);
+            std::size_t i{0};
+            // Every store writes 16 bytes of which 12 are valid, so the loop stops before writing past the target.
+            for(; (i + 4) * 3 + 4 <= count * 3; i += 4) {
+                const auto bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + i * 4));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(target + i * 3), _mm_shuffle_epi8(bytes, shuffle));
+            }
+            return i;
+        }
+#endif
+
+        FastConversion select_fast_conversion(const PixelFormat source_format, const PixelFormat target_format) {
+#if defined(OGF_PIXEL_CONVERSION_SSE2)
+            if(source_format == PixelFormat::RGBA8 && target_format == PixelFormat::RGBA32F) {
+                return rgba8_to_rgba32f;
+            }
+            if(source_format == PixelFormat::RGBA32F && target_format == PixelFormat::RGBA8) {
+                return rgba32f_to_rgba8;
+            }
+#endif
+#if defined(OGF_PIXEL_CONVERSION_SSSE3)
+            static const bool has_ssse3 = __builtin_cpu_supports("ssse3");
+            if(has_ssse3 && source_format == PixelFormat::RGB8 && target_format == PixelFormat::RGBA8) {
+                return rgb8_to_rgba8;
+            }
+            if(has_ssse3 && source_format == PixelFormat::RGBA8 && target_format == PixelFormat::RGB8) {
+                return rgba8_to_rgb8;
+            }
+#endif
+            static_cast<void>(source_format);
+            static_cast<void>(target_format);
+            return no_fast_conversion;
+        }
+
+    }
+
+    float half_to_float(const Uint16 half) noexcept {
+        constexpr Uint32 shifted_exponent = 0x7C00u << 13;
+        auto bits = static_cast<Uint32>(half & 0x7FFFu) << 13;
+        const auto exponent = bits & shifted_exponent;
+        bits += (127u - 15u) << 23;
+        if(exponent == shifted_exponent) {
+            // Infinity or NaN.
+            bits += (128u - 16u) << 23;
+        } else if(exponent == 0) {
+            // Zero or subnormal, renormalized by the float unit.
+            bits += 1u << 23;
+            bits = float_bits(bits_float(bits) - bits_float(113u << 23));
+        }
+        return bits_float(bits | static_cast<Uint32>(half & 0x8000u) << 16);
+    }
+
+    Uint16 float_to_half(const float value) noexcept {
+        constexpr Uint32 float_infinity = 255u << 23;
+        constexpr Uint32 half_overflow = (127u + 16u) << 23;
+        constexpr Uint32 subnormal_magic = ((127u - 15u) + (23u - 10u) + 1u) << 23;
+        auto bits = float_bits(value);
+        const auto sign = bits & 0x80000000u;
+        bits ^= sign;
+        Uint32 half{};
+        if(bits >= half_overflow) {
+            half = bits > float_infinity ? 0x7E00u : 0x7C00u;
+        } else if(bits < 113u << 23) {
+            // Adding the magic number lets the float unit do the rounding of subnormals.
+            half = float_bits(bits_float(bits) + bits_float(subnormal_magic)) - subnormal_magic;
+        } else {
+            const auto odd_mantissa = (bits >> 13) & 1u;
+            bits -= 112u << 23;
+            bits += 0xFFFu + odd_mantissa;
+            half = bits >> 13;
+        }
+        return static_cast<Uint16>(half | sign >> 16);
+    }
+
+    void decode_pixels(const Uint8* source, const PixelFormat format, float* rgba, const std::size_t count) noexcept {
+        const auto channels = channel_count(format);
+        const auto size = channel_size(format);
+        const auto is_float = is_float_format(format);
+        const auto components = component_channels(channels);
+        for(std::size_t i = 0; i < count; ++i, rgba += 4) {
+            float values[4]{};
+            for(unsigned int channel = 0; channel < channels; ++channel, source += size) {
+                if(size == 1) {
+                    values[channel] = *source / 255.0f;
+                } else if(size == 2) {
+                    Uint16 value{};
+                    std::memcpy(&value, source, sizeof(value));
+                    values[channel] = is_float ? half_to_float(value) : value / 65535.0f;
+                } else {
+                    std::memcpy(values + channel, source, sizeof(float));
+                }
+            }
+            for(std::size_t component = 0; component < 4; ++component) {
+                rgba[component] = components[component] >= 0 ? values[components[component]] : 1.0f;
+            }
+        }
+    }
+
+    void encode_pixels(const float* rgba, Uint8* target, const PixelFormat format, const std::size_t count) noexcept {
+        const auto channels = channel_count(format);
+        const auto size = channel_size(format);
+        const auto is_float = is_float_format(format);
+        for(std::size_t i = 0; i < count; ++i, rgba += 4) {
+            for(unsigned int channel = 0; channel < channels; ++channel, target += size) {
+                const auto value = rgba[channel_component(channel, channels)];
+                if(size == 1) {
+                    *target = static_cast<Uint8>(std::clamp(value, 0.0f, 1.0f) * 255.0f + 0.5f);
+                } else if(size == 2) {
+                    const auto encoded = is_float ? float_to_half(value)
+                            : static_cast<Uint16>(std::clamp(value, 0.0f, 1.0f) * 65535.0f + 0.5f);
+                    std::memcpy(target, &encoded, sizeof(encoded));
+                } else {
+                    std::memcpy(target, &value, sizeof(float));
+                }
+            }
+        }
+    }
+
+    void decode_srgb_pixels(const Uint8* source, const PixelFormat format, float* rgba,
+            const std::size_t count) noexcept {
+        const auto& table = srgb_decode_table();
+        const auto channels = channel_count(format);
+        for(std::size_t i = 0; i < count; ++i, source += channels, rgba += 4) {
+            rgba[0] = table[source[0]];
+            rgba[1] = table[source[1]];
+            rgba[2] = table[source[2]];
+            rgba[3] = channels == 4 ? source[3] / 255.0f : 1.0f;
+        }
+    }
+
+    void encode_srgb_pixels(const float* rgba, Uint8* target, const PixelFormat format,
+            const std::size_t count) noexcept {
+        const auto& table = srgb_encode_table();
+        const auto channels = channel_count(format);
+        for(std::size_t i = 0; i < count; ++i, rgba += 4, target += channels) {
+            float clamped[4]{};
+            Int32 buckets[4]{};
+            clamp_to_buckets(rgba, clamped, buckets);
+            target[0] = table.encode(clamped[0], buckets[0]);
+            target[1] = table.encode(clamped[1], buckets[1]);
+            target[2] = table.encode(clamped[2], buckets[2]);
+            if(channels == 4) {
+                target[3] = static_cast<Uint8>(clamped[3] * 255.0f + 0.5f);
+            }
+        }
+    }
+
+    void convert_pixels(const Uint8* source, const PixelFormat source_format, Uint8* target,
+            const PixelFormat target_format, std::size_t count) noexcept {
+        if(source_format == target_format) {
+            std::memcpy(target, source, count * pixel_size(source_format));
+            return;
+        }
+        const auto converted = select_fast_conversion(source_format, target_format)(source, target, count);
+        source += converted * pixel_size(source_format);
+        target += converted * pixel_size(target_format);
+        count -= converted;
+        // Channel count changes of 8-bit pixels are common and need no arithmetic.
+        if(is_8bit(source_format) && is_8bit(target_format)) {
+            const auto source_channels = channel_count(source_format);
+            const auto target_channels = channel_count(target_format);
+            const auto components = component_channels(source_channels);
+            int sources[4]{};
+            for(unsigned int channel = 0; channel < target_channels; ++channel) {
+                sources[channel] = components[channel_component(channel, target_channels)];
+            }
+            for(std::size_t i = 0; i < count; ++i, source += source_channels, target += target_channels) {
+                for(unsigned int channel = 0; channel < target_channels; ++channel) {
+                    target[channel] = sources[channel] >= 0 ? source[sources[channel]] : 255;
+                }
+            }
+            return;
+        }
+        float buffer[CHUNK_SIZE * 4];
+        for(std::size_t first = 0; first < count; first += CHUNK_SIZE) {
+            const auto chunk = std::min(CHUNK_SIZE, count - first);
+            decode_pixels(source + first * pixel_size(source_format), source_format, buffer, chunk);
+            encode_pixels(buffer, target + first * pixel_size(target_format), target_format, chunk);
+        }
+    }
+
+}
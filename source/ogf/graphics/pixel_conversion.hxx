@@ -0,0 +1,33 @@
+#pragma once
+
+#include <cstddef>
+
+#include <ogf/graphics/pixel_format.hxx>
+#include <ogf/types.hxx>
+
+namespace ogf {
+
+    // Convert between single and half precision floats, rounding to nearest even.
+    float half_to_float(const Uint16 half) noexcept;
+    Uint16 float_to_half(const float value) noexcept;
+
+    // Decode pixels to float RGBA. Normalized channels are mapped to [0.0f .. 1.0f] and missing alpha is one. One and
+    // two channel pixels are grey and grey with alpha, the grey value goes to all color channels.
+    void decode_pixels(const Uint8* source, const PixelFormat format, float* rgba, const std::size_t count) noexcept;
+
+    // Encode float RGBA pixels. Normalized channels are clamped and rounded to nearest. One and two channel pixels
+    // keep red as the grey value, and alpha.
+    void encode_pixels(const float* rgba, Uint8* target, const PixelFormat format, const std::size_t count) noexcept;
+
+    // Decode RGB8 or RGBA8 pixels with sRGB colors to linear float RGBA and encode them back, through lookup tables.
+    // Alpha is linear. Encoding clamps to [0.0f .. 1.0f] and rounds colors to the nearest sRGB value.
+    void decode_srgb_pixels(const Uint8* source, const PixelFormat format, float* rgba,
+            const std::size_t count) noexcept;
+    void encode_srgb_pixels(const float* rgba, Uint8* target, const PixelFormat format,
+            const std::size_t count) noexcept;
+
+    // Convert a run of pixels between formats. Channels missing in the source are filled as in decode_pixels().
+    void convert_pixels(const Uint8* source, const PixelFormat source_format, Uint8* target,
+            const PixelFormat target_format, const std::size_t count) noexcept;
+
+}
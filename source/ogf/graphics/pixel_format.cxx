@@ -0,0 +1,24 @@
+#include <ogf/graphics/pixel_format.hxx>
+
+namespace ogf {
+
+    // Formats are ordered by channel type and then by channel count, so both can be computed from the index.
+
+    unsigned int channel_count(const PixelFormat format) noexcept {
+        return static_cast<unsigned int>(format) % 4 + 1;
+    }
+
+    unsigned int channel_size(const PixelFormat format) noexcept {
+        constexpr unsigned int sizes[]{1, 2, 2, 4};
+        return sizes[static_cast<unsigned int>(format) / 4];
+    }
+
+    unsigned int pixel_size(const PixelFormat format) noexcept {
+        return channel_count(format) * channel_size(format);
+    }
+
+    bool is_float_format(const PixelFormat format) noexcept {
+        return static_cast<unsigned int>(format) >= static_cast<unsigned int>(PixelFormat::R16F);
+    }
+
+}
@@ -0,0 +1,208 @@
+#include <ogf/graphics/png_writer.hxx>
+
+#include <algorithm>
+#include <array>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <vector>
+
+#include <zlib.h>
+
+#include <ogf/utils/thread_pool.hxx>
+
+namespace ogf {
+
+    namespace {
+
+        // Bands smaller than this don't pay for the stitching and the lost matches across band boundaries.
+        constexpr std::size_t MIN_BAND_BYTES = 256 * 1024;
+
+        // Deflate window size. Each band is primed with this much of the preceding band's data.
+        constexpr std::size_t DICTIONARY_SIZE = 32 * 1024;
+
+        Uint8 paeth(const int a, const int b, const int c) {
+            const auto p = a + b - c;
+            const auto pa = std::abs(p - a);
+            const auto pb = std::abs(p - b);
+            const auto pc = std::abs(p - c);
+            if(pa <= pb && pa <= pc) {
+                return static_cast<Uint8>(a);
+            }
+            return static_cast<Uint8>(pb <= pc ? b : c);
+        }
+
+        // Filter a single row with every PNG filter type and keep the one with the smallest sum of absolute values,
+        // which is the heuristic recommended by the PNG specification. The output starts with the filter type byte.
+        void filter_row(const Uint8* row, const Uint8* previous_row, const std::size_t row_bytes,
+                const unsigned int bpp, Uint8* output) {
+            std::array<std::vector<Uint8>, 5> candidates{};
+            std::size_t best_cost{~std::size_t{0}};
+            std::size_t best_filter{0};
+            for(std::size_t filter = 0; filter < candidates.size(); ++filter) {
+                auto& candidate = candidates[filter];
+                candidate.resize(row_bytes);
+                std::size_t cost{0};
+                for(std::size_t i = 0; i < row_bytes; ++i) {
+                    const int a = i >= bpp ? row[i - bpp] : 0;
+                    const int b = previous_row != nullptr ? previous_row[i] : 0;
+                    const int c = i >= bpp && previous_row != nullptr ? previous_row[i - bpp] : 0;
+                    Uint8 predictor{0};
+                    switch(filter) {
+                        case 1: predictor = static_cast<Uint8>(a); break;
+                        case 2: predictor = static_cast<Uint8>(b); break;
+                        case 3: predictor = static_cast<Uint8>((a + b) / 2); break;
+                        case 4: predictor = paeth(a, b, c); break;
+                        default: break;
+                    }
+                    candidate[i] = static_cast<Uint8>(row[i] - predictor);
+                    cost += std::abs(static_cast<Int8>(candidate[i]));
+                }
+                if(cost < best_cost) {
+                    best_cost = cost;
+                    best_filter = filter;
+                }
+            }
+            output[0] = static_cast<Uint8>(best_filter);
+            std::copy(candidates[best_filter].begin(), candidates[best_filter].end(), output + 1);
+        }
+
+        struct Band {
+            std::vector<Uint8> filtered{};
+            std::vector<Uint8> compressed{};
+            uLong              adler{};
+        };
+
+        // Deflate a band as raw deflate data. Every band but the last ends with a sync flush, which leaves the stream
+        // byte-aligned and without the final block bit set, so the bands can simply be concatenated.
+        void deflate_band(Band& band, const Band* previous_band, const bool last) {
+            z_stream stream{};
+            if(deflateInit2(&stream, Z_DEFAULT_COMPRESSION, Z_DEFLATED, -15, 8, Z_DEFAULT_STRATEGY) != Z_OK) {
+                throw std::runtime_error{"Failed to initialize deflate stream."};
+            }
+            if(previous_band != nullptr) {
+                const auto& dictionary = previous_band->filtered;
+                const auto dictionary_size = std::min(dictionary.size(), DICTIONARY_SIZE);
+                deflateSetDictionary(&stream, dictionary.data() + dictionary.size() - dictionary_size,
+                        static_cast<uInt>(dictionary_size));
+            }
+            band.compressed.resize(deflateBound(&stream, static_cast<uLong>(band.filtered.size())) + 16);
+            stream.next_in = band.filtered.data();
+            stream.avail_in = static_cast<uInt>(band.filtered.size());
+            stream.next_out = band.compressed.data();
+            stream.avail_out = static_cast<uInt>(band.compressed.size());
+            const auto result = deflate(&stream, last ? Z_FINISH : Z_SYNC_FLUSH);
+            if(result != (last ? Z_STREAM_END : Z_OK)) {
+                deflateEnd(&stream);
+                throw std::runtime_error{"Failed to deflate PNG data."};
+            }
+            band.compressed.resize(stream.total_out);
+            deflateEnd(&stream);
+            band.adler = adler32(adler32(0, nullptr, 0), band.filtered.data(), static_cast<uInt>(band.filtered.size()));
+        }
+
+        void put_uint32(std::vector<Uint8>& output, const Uint32 value) {
+            output.push_back(static_cast<Uint8>(value >> 24));
+            output.push_back(static_cast<Uint8>(value >> 16));
+            output.push_back(static_cast<Uint8>(value >> 8));
+            output.push_back(static_cast<Uint8>(value));
+        }
+
+        void put_chunk(std::ofstream& file, const char* type, const std::vector<Uint8>& data) {
+            std::vector<Uint8> header{};
+            put_uint32(header, static_cast<Uint32>(data.size()));
+            header.insert(header.end(), type, type + 4);
+            auto crc = crc32(crc32(0, nullptr, 0), header.data() + 4, 4);
+            if(!data.empty()) {
+                // crc32() resets to the initial value when given a null buffer.
+                crc = crc32(crc, data.data(), static_cast<uInt>(data.size()));
+            }
+            std::vector<Uint8> footer{};
+            put_uint32(footer, static_cast<Uint32>(crc));
+            file.write(reinterpret_cast<const char*>(header.data()), header.size());
+            file.write(reinterpret_cast<const char*>(data.data()), data.size());
+            file.write(reinterpret_cast<const char*>(footer.data()), footer.size());
+        }
+
+    }
+
+    void write_png(const std::string_view filename, const Uint8* pixels, const unsigned int width,
+            const unsigned int height, const unsigned int channels, const std::size_t stride,
+            const unsigned int bit_depth, const unsigned int max_bands) {
+        constexpr std::array<Uint8, 5> color_types{0, 0, 4, 2, 6};
+        if(width == 0 || height == 0 || channels == 0 || channels > 4 || (bit_depth != 8 && bit_depth != 16)) {
+            throw std::runtime_error{"Failed to save image \"" + std::string{filename} + "\": invalid image."};
+        }
+        const auto bytes_per_pixel = channels * bit_depth / 8;
+        const std::size_t row_bytes = static_cast<std::size_t>(width) * bytes_per_pixel;
+        const auto band_limit = std::max<std::size_t>(max_bands != 0 ? max_bands
+                : default_thread_pool().thread_count(), 1);
+        auto band_count = std::clamp<std::size_t>(row_bytes * height / MIN_BAND_BYTES, 1,
+                std::min<std::size_t>(band_limit, height));
+        const auto rows_per_band = (height + band_count - 1) / band_count;
+        // Rounding the rows up may leave the last bands empty, e.g. 50 rows in 16 bands of 4 need only 13 of them.
+        band_count = (height + rows_per_band - 1) / rows_per_band;
+
+        std::vector<Band> bands(band_count);
+        parallel_for(band_count, [&](const std::size_t index) {
+            const auto first_row = index * rows_per_band;
+            const auto last_row = std::min<std::size_t>(first_row + rows_per_band, height);
+            auto& band = bands[index];
+            band.filtered.resize((last_row - first_row) * (row_bytes + 1));
+            // PNG stores 16-bit samples big-endian, so such rows are swapped into scratch buffers first.
+            std::vector<Uint8> swapped_row{}, swapped_previous_row{};
+            const auto swap_row = [&](const Uint8* row, std::vector<Uint8>& output) {
+                output.resize(row_bytes);
+                for(std::size_t i = 0; i < row_bytes; i += 2) {
+                    Uint16 value{};
+                    std::memcpy(&value, row + i, sizeof(value));
+                    output[i] = static_cast<Uint8>(value >> 8);
+                    output[i + 1] = static_cast<Uint8>(value);
+                }
+                return output.data();
+            };
+            for(auto y = first_row; y < last_row; ++y) {
+                const Uint8* row = pixels + y * stride;
+                const Uint8* previous_row = y > 0 ? row - stride : nullptr;
+                if(bit_depth == 16) {
+                    previous_row = previous_row != nullptr ? swap_row(previous_row, swapped_previous_row) : nullptr;
+                    row = swap_row(row, swapped_row);
+                }
+                filter_row(row, previous_row, row_bytes, bytes_per_pixel,
+                        band.filtered.data() + (y - first_row) * (row_bytes + 1));
+            }
+        });
+        // Dictionaries need the previous band's filtered data, so compression starts once all bands are filtered.
+        parallel_for(band_count, [&](const std::size_t index) {
+            deflate_band(bands[index], index > 0 ? &bands[index - 1] : nullptr, index + 1 == band_count);
+        });
+
+        std::vector<Uint8> idat{0x78, 0x9c};
+        auto adler = adler32(0, nullptr, 0);
+        for(const auto& band : bands) {
+            idat.insert(idat.end(), band.compressed.begin(), band.compressed.end());
+            adler = adler32_combine(adler, band.adler, static_cast<z_off_t>(band.filtered.size()));
+        }
+        put_uint32(idat, static_cast<Uint32>(adler));
+
+        std::vector<Uint8> ihdr{};
+        put_uint32(ihdr, width);
+        put_uint32(ihdr, height);
+        ihdr.insert(ihdr.end(), {static_cast<Uint8>(bit_depth), color_types[channels], 0, 0, 0});
+
+        std::ofstream file{std::string{filename}, std::ios::binary};
+        if(!file.good()) {
+            throw std::runtime_error{"Failed to open image \"" + std::string{filename} + "\" for writing."};
+        }
+        constexpr std::array<char, 8> signature{'\x89', 'P', 'N', 'G', '\r', '\n', '\x1a', '\n'};
+        file.write(signature.data(), signature.size());
+        put_chunk(file, "IHDR", ihdr);
+        put_chunk(file, "IDAT", idat);
+        put_chunk(file, "IEND", {});
+        if(!file.good()) {
+            throw std::runtime_error{"Failed to write image \"" + std::string{filename} + "\"."};
+        }
+    }
+
+}
@@ -0,0 +1,17 @@
+#pragma once
+
+#include <string>
+
+#include <ogf/types.hxx>
+
+namespace ogf {
+
+    // Write pixels with given channel count and bit depth, 8 or 16, to a PNG file. 16-bit channels are in native byte
+    // order. Big images are split into row bands which are filtered and deflated in parallel, and the resulting streams
+    // are stitched into a single IDAT stream. There are at most max_bands bands, or as many as the library thread pool
+    // has threads if it's 0.
+    void write_png(const std::string_view filename, const Uint8* pixels, const unsigned int width,
+            const unsigned int height, const unsigned int channels, const std::size_t stride,
+            const unsigned int bit_depth = 8, const unsigned int max_bands = 0);
+
+}
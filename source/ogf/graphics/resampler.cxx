@@ -0,0 +1,375 @@
+#include <ogf/graphics/resampler.hxx>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+
+#if defined(__SSE__) || defined(_M_X64)
+#define OGF_RESAMPLER_SSE
+#include <immintrin.h>
+#endif
+
+#if defined(OGF_RESAMPLER_SSE) && defined(__GNUC__)
+#define OGF_RESAMPLER_AVX2
+#endif
+
+#include <ogf/graphics/pixel_conversion.hxx>
+#include <ogf/utils/thread_pool.hxx>
+
+namespace ogf {
+
+    namespace {
+
+        // Rows processed by a single task. Big enough to amortize scheduling, small enough to balance the load.
+        constexpr unsigned int ROWS_PER_TASK = 16;
+
+        constexpr float PI = 3.14159265358979f;
+
+        // Zeroth order modified Bessel function of the first kind, needed by the Kaiser window.
+        float bessel_i0(const float x) {
+            float sum{1.0f};
+            float term{1.0f};
+            for(int k = 1; k < 32; ++k) {
+                term *= (x / (2.0f * k)) * (x / (2.0f * k));
+                sum += term;
+                if(term < sum * 1e-8f) {
+                    break;
+                }
+            }
+            return sum;
+        }
+
+        float sinc(const float x) {
+            if(std::abs(x) < 1e-6f) {
+                return 1.0f;
+            }
+            return std::sin(PI * x) / (PI * x);
+        }
+
+        // Kaiser-windowed sinc, x is in destination pixels.
+        float kaiser(const float x) {
+            constexpr float radius = 3.0f;
+            constexpr float alpha = 4.0f;
+            if(std::abs(x) >= radius) {
+                return 0.0f;
+            }
+            const auto t = x / radius;
+            return sinc(x) * bessel_i0(alpha * std::sqrt(1.0f - t * t)) / bessel_i0(alpha);
+        }
+
+        float tent(const float x) {
+            return std::max(1.0f - std::abs(x), 0.0f);
+        }
+
+        // Mitchell-Netravali cubic with B = C = 1/3.
+        float mitchell(const float x) {
+            constexpr float b = 1.0f / 3.0f;
+            constexpr float c = 1.0f / 3.0f;
+            const auto t = std::abs(x);
+            if(t < 1.0f) {
+                return ((12.0f - 9.0f * b - 6.0f * c) * t * t * t + (-18.0f + 12.0f * b + 6.0f * c) * t * t
+                        + (6.0f - 2.0f * b)) / 6.0f;
+            }
+            if(t < 2.0f) {
+                return ((-b - 6.0f * c) * t * t * t + (6.0f * b + 30.0f * c) * t * t + (-12.0f * b - 48.0f * c) * t
+                        + (8.0f * b + 24.0f * c)) / 6.0f;
+            }
+            return 0.0f;
+        }
+
+        float lanczos3(const float x) {
+            return std::abs(x) < 3.0f ? sinc(x) * sinc(x / 3.0f) : 0.0f;
+        }
+
+        float kernel_support(const ResampleKernel kernel) {
+            switch(kernel) {
+                case ResampleKernel::BOX: return 0.5f;
+                case ResampleKernel::BILINEAR: return 1.0f;
+                case ResampleKernel::MITCHELL: return 2.0f;
+                case ResampleKernel::LANCZOS3: return 3.0f;
+                case ResampleKernel::KAISER: return 3.0f;
+            }
+            return 0.5f;
+        }
+
+        // Weight of a source pixel at distance x from the destination pixel center, x is in destination pixels. Box is
+        // handled separately as exact coverage.
+        float kernel_weight(const ResampleKernel kernel, const float x) {
+            switch(kernel) {
+                case ResampleKernel::BILINEAR: return tent(x);
+                case ResampleKernel::MITCHELL: return mitchell(x);
+                case ResampleKernel::LANCZOS3: return lanczos3(x);
+                default: return kaiser(x);
+            }
+        }
+
+        // Weights of every destination pixel along one axis. Each destination pixel has the same number of taps, the
+        // unused ones have zero weight, which keeps the inner loops free of branches.
+        struct FilterTable {
+            std::vector<int>   first{};
+            std::vector<float> weights{};
+            unsigned int       taps{};
+        };
+
+        FilterTable make_filter_table(const unsigned int source_size, const unsigned int target_size,
+                const ResampleKernel kernel) {
+            const auto scale = static_cast<float>(source_size) / target_size;
+            // When minifying, the kernel is stretched over more source pixels.
+            const auto filter_scale = std::max(scale, 1.0f);
+            const auto support = kernel_support(kernel) * filter_scale;
+            FilterTable table{};
+            table.taps = static_cast<unsigned int>(std::ceil(support * 2.0f)) + 1;
+            table.taps = std::min(table.taps, source_size);
+            table.first.resize(target_size);
+            table.weights.assign(static_cast<std::size_t>(target_size) * table.taps, 0.0f);
+            for(unsigned int i = 0; i < target_size; ++i) {
+                const auto center = (i + 0.5f) * scale;
+                auto first = static_cast<int>(std::floor(center - support));
+                first = std::clamp(first, 0, static_cast<int>(source_size - table.taps));
+                table.first[i] = first;
+                auto weights = table.weights.data() + static_cast<std::size_t>(i) * table.taps;
+                float sum{0.0f};
+                for(unsigned int tap = 0; tap < table.taps; ++tap) {
+                    const auto source = static_cast<float>(first + tap);
+                    float weight{};
+                    if(kernel == ResampleKernel::BOX) {
+                        // Exact coverage of the source pixel by the destination footprint, handles odd sizes.
+                        const auto left = std::max(source, center - support);
+                        const auto right = std::min(source + 1.0f, center + support);
+                        weight = std::max(right - left, 0.0f);
+                    } else {
+                        weight = kernel_weight(kernel, (source + 0.5f - center) / filter_scale);
+                    }
+                    weights[tap] = weight;
+                    sum += weight;
+                }
+                if(sum != 0.0f) {
+                    for(unsigned int tap = 0; tap < table.taps; ++tap) {
+                        weights[tap] /= sum;
+                    }
+                }
+            }
+            return table;
+        }
+
+        void filter_row_horizontal_generic(const float* source, float* target, const FilterTable& table,
+                const unsigned int width) {
+            for(unsigned int x = 0; x < width; ++x) {
+                const auto weights = table.weights.data() + static_cast<std::size_t>(x) * table.taps;
+                const auto input = source + static_cast<std::size_t>(table.first[x]) * 4;
+#if defined(OGF_RESAMPLER_SSE)
+                // One RGBA pixel is exactly one SSE register.
+                auto sum = _mm_setzero_ps();
+                for(unsigned int tap = 0; tap < table.taps; ++tap) {
+                    sum = _mm_add_ps(sum, _mm_mul_ps(_mm_set1_ps(weights[tap]), _mm_loadu_ps(input + tap * 4)));
+                }
+                _mm_storeu_ps(target + static_cast<std::size_t>(x) * 4, sum);
+#else
+                std::array<float, 4> sum{};
+                for(unsigned int tap = 0; tap < table.taps; ++tap) {
+                    for(std::size_t c = 0; c < 4; ++c) {
+                        sum[c] += weights[tap] * input[tap * 4 + c];
+                    }
+                }
+                std::copy(sum.begin(), sum.end(), target + static_cast<std::size_t>(x) * 4);
+#endif
+            }
+        }
+
+#if defined(OGF_RESAMPLER_AVX2)
+        // Two neighbouring source pixels fill one AVX register, the halves are summed at the end.
+        __attribute__((target("avx2,fma")))
+        void filter_row_horizontal_avx2(const float* source, float* target, const FilterTable& table,
+                const unsigned int width) {
+            for(unsigned int x = 0; x < width; ++x) {
+                const auto weights = table.weights.data() + static_cast<std::size_t>(x) * table.taps;
+                const auto input = source + static_cast<std::size_t>(table.first[x]) * 4;
+                auto sum = _mm256_setzero_ps();
+                unsigned int tap{0};
+                for(; tap + 2 <= table.taps; tap += 2) {
+                    const auto weight = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_set1_ps(weights[tap])),
+                            _mm_set1_ps(weights[tap + 1]), 1);
+                    sum = _mm256_fmadd_ps(weight, _mm256_loadu_ps(input + tap * 4), sum);
+                }
+                auto total = _mm_add_ps(_mm256_castps256_ps128(sum), _mm256_extractf128_ps(sum, 1));
+                if(tap < table.taps) {
+                    total = _mm_fmadd_ps(_mm_set1_ps(weights[tap]), _mm_loadu_ps(input + tap * 4), total);
+                }
+                _mm_storeu_ps(target + static_cast<std::size_t>(x) * 4, total);
+            }
+        }
+#endif
+
+        using HorizontalKernel = void (*)(const float*, float*, const FilterTable&, const unsigned int);
+
+        HorizontalKernel select_horizontal_kernel() {
+#if defined(OGF_RESAMPLER_AVX2)
+            if(__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) {
+                return filter_row_horizontal_avx2;
+            }
+#endif
+            return filter_row_horizontal_generic;
+        }
+
+        // Vertical pass works on whole rows, so it maps onto the widest registers available.
+        void filter_row_vertical_generic(const float* const* rows, const float* weights, const unsigned int taps,
+                float* target, const std::size_t count) {
+            std::size_t i{0};
+#if defined(OGF_RESAMPLER_SSE)
+            for(; i + 4 <= count; i += 4) {
+                auto sum = _mm_setzero_ps();
+                for(unsigned int tap = 0; tap < taps; ++tap) {
+                    sum = _mm_add_ps(sum, _mm_mul_ps(_mm_set1_ps(weights[tap]), _mm_loadu_ps(rows[tap] + i)));
+                }
+                _mm_storeu_ps(target + i, sum);
+            }
+#endif
+            for(; i < count; ++i) {
+                float sum{0.0f};
+                for(unsigned int tap = 0; tap < taps; ++tap) {
+                    sum += weights[tap] * rows[tap][i];
+                }
+                target[i] = sum;
+            }
+        }
+
+#if defined(OGF_RESAMPLER_AVX2)
+        __attribute__((target("avx2,fma")))
+        void filter_row_vertical_avx2(const float* const* rows, const float* weights, const unsigned int taps,
+                float* target, const std::size_t count) {
+            std::size_t i{0};
+            for(; i + 8 <= count; i += 8) {
+                auto sum = _mm256_setzero_ps();
+                for(unsigned int tap = 0; tap < taps; ++tap) {
+                    sum = _mm256_fmadd_ps(_mm256_set1_ps(weights[tap]), _mm256_loadu_ps(rows[tap] + i), sum);
+                }
+                _mm256_storeu_ps(target + i, sum);
+            }
+            filter_row_vertical_generic(rows, weights, taps, target + i, count - i);
+        }
+#endif
+
+        using VerticalKernel = void (*)(const float* const*, const float*, const unsigned int, float*,
+                const std::size_t);
+
+        VerticalKernel select_vertical_kernel() {
+#if defined(OGF_RESAMPLER_AVX2)
+            if(__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) {
+                return filter_row_vertical_avx2;
+            }
+#endif
+            return filter_row_vertical_generic;
+        }
+
+        std::size_t task_count(const unsigned int rows) {
+            return (rows + ROWS_PER_TASK - 1) / ROWS_PER_TASK;
+        }
+
+    }
+
+    FloatImage to_linear(const Uint8* pixels, const PixelFormat format, const unsigned int width,
+            const unsigned int height, const std::size_t stride, const bool srgb) {
+        const auto decode_srgb = srgb && (format == PixelFormat::RGB8 || format == PixelFormat::RGBA8);
+        FloatImage image{};
+        image.width = width;
+        image.height = height;
+        image.pixels.resize(static_cast<std::size_t>(width) * height * 4);
+        parallel_for(task_count(height), [&](const std::size_t task) {
+            const auto last_row = std::min<std::size_t>((task + 1) * ROWS_PER_TASK, height);
+            for(auto y = task * ROWS_PER_TASK; y < last_row; ++y) {
+                const auto source = pixels + y * stride;
+                auto target = image.pixels.data() + y * width * 4;
+                if(decode_srgb) {
+                    decode_srgb_pixels(source, format, target, width);
+                } else {
+                    decode_pixels(source, format, target, width);
+                }
+            }
+        });
+        return image;
+    }
+
+    void from_linear(const FloatImage& image, Uint8* pixels, const PixelFormat format, const std::size_t stride,
+            const bool srgb) {
+        const auto encode_srgb = srgb && (format == PixelFormat::RGB8 || format == PixelFormat::RGBA8);
+        parallel_for(task_count(image.height), [&](const std::size_t task) {
+            const auto last_row = std::min<std::size_t>((task + 1) * ROWS_PER_TASK, image.height);
+            for(auto y = task * ROWS_PER_TASK; y < last_row; ++y) {
+                const auto source = image.pixels.data() + y * image.width * 4;
+                auto target = pixels + y * stride;
+                if(encode_srgb) {
+                    encode_srgb_pixels(source, target, format, image.width);
+                } else {
+                    encode_pixels(source, target, format, image.width);
+                }
+            }
+        });
+    }
+
+    void premultiply(FloatImage& image) {
+        parallel_for(task_count(image.height), [&](const std::size_t task) {
+            const auto last_row = std::min<std::size_t>((task + 1) * ROWS_PER_TASK, image.height);
+            auto pixel = image.pixels.data() + task * ROWS_PER_TASK * image.width * 4;
+            const auto end = image.pixels.data() + last_row * image.width * 4;
+            for(; pixel != end; pixel += 4) {
+                pixel[0] *= pixel[3];
+                pixel[1] *= pixel[3];
+                pixel[2] *= pixel[3];
+            }
+        });
+    }
+
+    void unpremultiply(FloatImage& image) {
+        parallel_for(task_count(image.height), [&](const std::size_t task) {
+            const auto last_row = std::min<std::size_t>((task + 1) * ROWS_PER_TASK, image.height);
+            auto pixel = image.pixels.data() + task * ROWS_PER_TASK * image.width * 4;
+            const auto end = image.pixels.data() + last_row * image.width * 4;
+            for(; pixel != end; pixel += 4) {
+                // Negative lobes of the filters can push alpha slightly below zero.
+                const auto scale = pixel[3] > 0.0f ? 1.0f / pixel[3] : 0.0f;
+                pixel[0] *= scale;
+                pixel[1] *= scale;
+                pixel[2] *= scale;
+            }
+        });
+    }
+
+    FloatImage resample(const FloatImage& image, const unsigned int width, const unsigned int height,
+            const ResampleKernel kernel) {
+        static const auto horizontal_kernel = select_horizontal_kernel();
+        static const auto vertical_kernel = select_vertical_kernel();
+        const auto horizontal_table = make_filter_table(image.width, width, kernel);
+        const auto vertical_table = make_filter_table(image.height, height, kernel);
+
+        FloatImage horizontal{};
+        horizontal.width = width;
+        horizontal.height = image.height;
+        horizontal.pixels.resize(static_cast<std::size_t>(width) * image.height * 4);
+        parallel_for(task_count(image.height), [&](const std::size_t task) {
+            const auto last_row = std::min<std::size_t>((task + 1) * ROWS_PER_TASK, image.height);
+            for(auto y = task * ROWS_PER_TASK; y < last_row; ++y) {
+                horizontal_kernel(image.pixels.data() + y * image.width * 4,
+                        horizontal.pixels.data() + y * width * 4, horizontal_table, width);
+            }
+        });
+
+        FloatImage result{};
+        result.width = width;
+        result.height = height;
+        result.pixels.resize(static_cast<std::size_t>(width) * height * 4);
+        const std::size_t row_floats = static_cast<std::size_t>(width) * 4;
+        parallel_for(task_count(height), [&](const std::size_t task) {
+            std::vector<const float*> rows(vertical_table.taps);
+            const auto last_row = std::min<std::size_t>((task + 1) * ROWS_PER_TASK, height);
+            for(auto y = task * ROWS_PER_TASK; y < last_row; ++y) {
+                for(unsigned int tap = 0; tap < vertical_table.taps; ++tap) {
+                    rows[tap] = horizontal.pixels.data() + (vertical_table.first[y] + tap) * row_floats;
+                }
+                vertical_kernel(rows.data(), vertical_table.weights.data() + y * vertical_table.taps,
+                        vertical_table.taps, result.pixels.data() + y * row_floats, row_floats);
+            }
+        });
+        return result;
+    }
+
+}
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include <ogf/graphics/pixel_format.hxx>
+#include <ogf/types.hxx>
+
+namespace ogf {
+
+    enum class ResampleKernel {
+        BOX, BILINEAR, MITCHELL, LANCZOS3, KAISER
+    };
+
+    // RGBA image with linear-light float components, used as the working format of all filtering.
+    struct FloatImage {
+        std::vector<float> pixels{};
+        unsigned int       width{};
+        unsigned int       height{};
+    };
+
+    // Convert pixels of given format to linear light RGBA. Colors of RGB8 and RGBA8 pixels are decoded if srgb is true,
+    // everything else is taken as linear.
+    FloatImage to_linear(const Uint8* pixels, const PixelFormat format, const unsigned int width,
+            const unsigned int height, const std::size_t stride, const bool srgb);
+
+    // Convert linear pixels back to given format, rounding to nearest.
+    void from_linear(const FloatImage& image, Uint8* pixels, const PixelFormat format, const std::size_t stride,
+            const bool srgb);
+
+    // Multiply colors by alpha and back. Colors of pixels with zero alpha become zero when dividing.
+    void premultiply(FloatImage& image);
+    void unpremultiply(FloatImage& image);
+
+    // Resample the image to given size with a separable filter. Both passes are split into row bands which run on the
+    // library thread pool.
+    FloatImage resample(const FloatImage& image, const unsigned int width, const unsigned int height,
+            const ResampleKernel kernel);
+
+}
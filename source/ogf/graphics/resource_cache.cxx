@@ -0,0 +1,323 @@
+#include <ogf/graphics/resource_cache.hxx>
+
+#include <algorithm>
+#include <condition_variable>
+#include <exception>
+#include <filesystem>
+#include <mutex>
+#include <system_error>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
+
+#include <ogf/graphics/image.hxx>
+#include <ogf/graphics/texture.hxx>
+#include <ogf/graphics/texture_container.hxx>
+#include <ogf/types.hxx>
+#include <ogf/utils/hash.hxx>
+#include <ogf/utils/mapped_file.hxx>
+#include <ogf/utils/thread_pool.hxx>
+
+namespace ogf {
+
+    namespace {
+
+        // Size and modification time of a file, to notice when it changes after being hashed.
+        struct FileStamp {
+            std::uintmax_t                  size{};
+            std::filesystem::file_time_type time{};
+        };
+
+        bool operator!=(const FileStamp& left, const FileStamp& right) {
+            return left.size != right.size || left.time != right.time;
+        }
+
+        std::string canonical_path(const std::string_view filename) {
+            std::error_code error{};
+            auto path = std::filesystem::weakly_canonical(std::filesystem::path{filename}, error);
+            return error ? std::string{filename} : path.string();
+        }
+
+        // Missing files get a stamp which never matches a stamp of an existing file.
+        FileStamp stamp_file(const std::string& filename) {
+            std::error_code error{};
+            FileStamp stamp{};
+            stamp.size = std::filesystem::file_size(filename, error);
+            stamp.time = std::filesystem::last_write_time(filename, error);
+            return stamp;
+        }
+
+        Uint64 hash_file(const std::string& filename) {
+            MappedFile file{};
+            file.open(filename);
+            return hash_bytes(file.data(), file.size());
+        }
+
+    }
+
+    struct ResourceCache::Impl {
+        template<typename T>
+        struct Entry {
+            std::shared_ptr<const T> resource{};
+            std::size_t              bytes{};
+            Uint64                   last_used{};
+        };
+
+        struct File {
+            Uint64    hash{};
+            FileStamp stamp{};
+        };
+
+        template<typename T>
+        using Entries = std::unordered_map<Uint64, Entry<T>>;   // Keyed by content hash.
+
+        // Get the resource made from the file if the file hasn't changed since it was hashed. Must be called with the
+        // mutex locked.
+        template<typename T>
+        std::shared_ptr<const T> find(Entries<T>& entries, const std::string& path, const FileStamp& stamp);
+
+        // Add the resource unless a resource with the same content was added meanwhile. Returns the cached one. Must be
+        // called with the mutex locked.
+        template<typename T>
+        std::shared_ptr<const T> insert(Entries<T>& entries, const Uint64 hash, std::shared_ptr<const T> resource,
+                const std::size_t bytes);
+
+        std::shared_ptr<const Image> decode(const std::string& path, const FileStamp& stamp);
+
+        // Decode the image and publish it through the promise of the in-flight load registered for the path, then
+        // unregister the load.
+        void load(const std::string& path, const FileStamp& stamp, std::promise<std::shared_ptr<const Image>> promise);
+
+        // Evict resources held by nobody but the cache, least recently used first, until the cache fits into the
+        // budget. Textures are skipped unless called from the GL thread. Must be called with the mutex locked.
+        void evict(const bool evict_textures);
+
+        std::size_t budget{};
+        std::size_t usage{};
+        Uint64      clock{};     // Incremented on every access, orders resources for eviction.
+        std::size_t running{};   // Image loads started, but not finished.
+        std::unordered_map<std::string, File>                                              files{};
+        std::unordered_map<std::string, std::shared_future<std::shared_ptr<const Image>>> loading{};
+        Entries<Image>          images{};
+        Entries<Texture>        textures{};
+        mutable std::mutex      mutex{};
+        std::condition_variable condition{};
+    };
+
+    template<typename T>
+    std::shared_ptr<const T> ResourceCache::Impl::find(Entries<T>& entries, const std::string& path,
+            const FileStamp& stamp) {
+        const auto file = files.find(path);
+        if(file == files.end() || file->second.stamp != stamp) {
+            return nullptr;
+        }
+        const auto entry = entries.find(file->second.hash);
+        if(entry == entries.end()) {
+            return nullptr;
+        }
+        entry->second.last_used = ++clock;
+        return entry->second.resource;
+    }
+
+    template<typename T>
+    std::shared_ptr<const T> ResourceCache::Impl::insert(Entries<T>& entries, const Uint64 hash,
+            std::shared_ptr<const T> resource, const std::size_t bytes) {
+        auto [entry, inserted] = entries.try_emplace(hash);
+        if(inserted) {
+            entry->second.resource = std::move(resource);
+            entry->second.bytes = bytes;
+            usage += bytes;
+        }
+        entry->second.last_used = ++clock;
+        return entry->second.resource;
+    }
+
+    std::shared_ptr<const Image> ResourceCache::Impl::decode(const std::string& path, const FileStamp& stamp) {
+        const auto hash = hash_file(path);
+        {
+            std::lock_guard<std::mutex> mutex_lock{mutex};
+            files[path] = File{hash, stamp};
+            if(auto image = find(images, path, stamp)) {
+                return image;
+            }
+        }
+        auto image = std::make_shared<Image>();
+        image->load_from_file(path);
+        const auto height = std::get<1>(image->size());
+        const auto bytes = image->stride() * height;
+        std::lock_guard<std::mutex> mutex_lock{mutex};
+        // Another file with the same content may have been decoded meanwhile, then that image is shared.
+        auto cached = insert<Image>(images, hash, std::move(image), bytes);
+        evict(false);
+        return cached;
+    }
+
+    void ResourceCache::Impl::load(const std::string& path, const FileStamp& stamp,
+            std::promise<std::shared_ptr<const Image>> promise) {
+        try {
+            promise.set_value(decode(path, stamp));
+        } catch(...) {
+            promise.set_exception(std::current_exception());
+        }
+        // The destructor may delete the cache as soon as the mutex is unlocked, so everything is done under it.
+        std::lock_guard<std::mutex> mutex_lock{mutex};
+        loading.erase(path);
+        --running;
+        condition.notify_all();
+    }
+
+    void ResourceCache::Impl::evict(const bool evict_textures) {
+        if(usage <= budget) {
+            return;
+        }
+        // Last use, content hash and whether it's a texture.
+        std::vector<std::tuple<Uint64, Uint64, bool>> unused{};
+        for(const auto& [hash, entry] : images) {
+            if(entry.resource.use_count() == 1) {
+                unused.emplace_back(entry.last_used, hash, false);
+            }
+        }
+        if(evict_textures) {
+            for(const auto& [hash, entry] : textures) {
+                if(entry.resource.use_count() == 1) {
+                    unused.emplace_back(entry.last_used, hash, true);
+                }
+            }
+        }
+        std::sort(unused.begin(), unused.end());
+        for(const auto& candidate : unused) {
+            if(usage <= budget) {
+                break;
+            }
+            const auto hash = std::get<1>(candidate);
+            if(std::get<2>(candidate)) {
+                usage -= textures.at(hash).bytes;
+                textures.erase(hash);
+            } else {
+                usage -= images.at(hash).bytes;
+                images.erase(hash);
+            }
+        }
+    }
+
+    ResourceCache::ResourceCache(const std::size_t memory_budget) {
+        m_impl = std::make_unique<Impl>();
+        m_impl->budget = memory_budget;
+    }
+
+    ResourceCache::~ResourceCache() {
+        {
+            std::unique_lock<std::mutex> mutex_lock{m_impl->mutex};
+            m_impl->condition.wait(mutex_lock, [this]() { return m_impl->running == 0; });
+        }
+    }
+
+    std::shared_future<std::shared_ptr<const Image>> ResourceCache::load_image_async(const std::string_view filename) {
+        auto& impl = *m_impl;
+        auto path = canonical_path(filename);
+        const auto stamp = stamp_file(path);
+        std::lock_guard<std::mutex> mutex_lock{impl.mutex};
+        if(const auto load = impl.loading.find(path); load != impl.loading.end()) {
+            return load->second;
+        }
+        if(auto image = impl.find(impl.images, path, stamp)) {
+            std::promise<std::shared_ptr<const Image>> promise{};
+            promise.set_value(std::move(image));
+            return promise.get_future().share();
+        }
+        std::promise<std::shared_ptr<const Image>> promise{};
+        auto load = promise.get_future().share();
+        impl.loading.emplace(path, load);
+        ++impl.running;
+        default_thread_pool().submit([&impl, path = std::move(path), stamp, promise = std::move(promise)]() mutable {
+            impl.load(path, stamp, std::move(promise));
+        });
+        return load;
+    }
+
+    std::shared_ptr<const Image> ResourceCache::load_image(const std::string_view filename) {
+        // Same as load_image_async(), but a new load runs on the calling thread. The pool task would hold the image
+        // until the pool gets to destroy the task, this way the caller's handle is the only one when this returns.
+        auto& impl = *m_impl;
+        const auto path = canonical_path(filename);
+        const auto stamp = stamp_file(path);
+        std::promise<std::shared_ptr<const Image>> promise{};
+        std::shared_future<std::shared_ptr<const Image>> load{};
+        bool decoding{false};
+        {
+            std::lock_guard<std::mutex> mutex_lock{impl.mutex};
+            if(const auto found = impl.loading.find(path); found != impl.loading.end()) {
+                load = found->second;
+            } else if(auto image = impl.find(impl.images, path, stamp)) {
+                return image;
+            } else {
+                load = promise.get_future().share();
+                impl.loading.emplace(path, load);
+                ++impl.running;
+                decoding = true;
+            }
+        }
+        if(decoding) {
+            impl.load(path, stamp, std::move(promise));
+        }
+        return load.get();
+    }
+
+    std::shared_ptr<const Texture> ResourceCache::load_texture(const std::string_view filename) {
+        auto& impl = *m_impl;
+        const auto path = canonical_path(filename);
+        const auto stamp = stamp_file(path);
+        {
+            std::lock_guard<std::mutex> mutex_lock{impl.mutex};
+            if(auto texture = impl.find(impl.textures, path, stamp)) {
+                return texture;
+            }
+        }
+        // Hashing first finds textures uploaded from copies of the file without decoding it.
+        const auto hash = hash_file(path);
+        {
+            std::lock_guard<std::mutex> mutex_lock{impl.mutex};
+            impl.files[path] = Impl::File{hash, stamp};
+            if(auto texture = impl.find(impl.textures, path, stamp)) {
+                return texture;
+            }
+        }
+        auto texture = std::make_shared<Texture>();
+        std::size_t bytes{};
+        if(has_texture_container_extension(path)) {
+            texture->load_from_file(path);
+            bytes = static_cast<std::size_t>(stamp.size);
+        } else {
+            // An image decoded for the upload only would take a share of the budget while nobody uses it, so it's only
+            // taken from the cache when it's there already.
+            std::shared_ptr<const Image> image{};
+            {
+                std::lock_guard<std::mutex> mutex_lock{impl.mutex};
+                image = impl.find(impl.images, path, stamp);
+            }
+            Image decoded{};
+            if(!image) {
+                decoded.load_from_file(path);
+            }
+            const auto& source = image ? *image : decoded;
+            texture->load_from_image(source);
+            // Mipmaps add a third to the base level.
+            bytes = source.stride() * std::get<1>(source.size()) * 4 / 3;
+        }
+        std::lock_guard<std::mutex> mutex_lock{impl.mutex};
+        auto cached = impl.insert<Texture>(impl.textures, hash, std::move(texture), bytes);
+        impl.evict(true);
+        return cached;
+    }
+
+    void ResourceCache::trim() {
+        std::lock_guard<std::mutex> mutex_lock{m_impl->mutex};
+        m_impl->evict(true);
+    }
+
+    std::size_t ResourceCache::memory_usage() const {
+        std::lock_guard<std::mutex> mutex_lock{m_impl->mutex};
+        return m_impl->usage;
+    }
+
+}
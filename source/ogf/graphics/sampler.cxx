@@ -0,0 +1,148 @@
+#include <ogf/graphics/sampler.hxx>
+
+#include <algorithm>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include <glad/glad.h>
+
+#include <ogf/graphics/gl_extensions.hxx>
+
+namespace ogf {
+
+    namespace {
+
+        constexpr unsigned int MAX_ANISOTROPY = 16;
+
+        struct SamplerCache {
+            // The GL context is usually gone at exit, samplers still cached go away with it.
+            ~SamplerCache() {
+                for(auto& [key, sampler] : samplers) {
+                    static_cast<void>(sampler.release());
+                }
+            }
+
+            std::mutex                                           mutex{};
+            std::unordered_map<Uint32, std::unique_ptr<Sampler>> samplers{};
+            std::vector<GLuint>                                  bound{};   // Sampler bound to every texture unit.
+        };
+
+        SamplerCache& sampler_cache() {
+            static SamplerCache cache{};
+            return cache;
+        }
+
+        GLint gl_wrap(const SamplerWrap wrap) {
+            switch(wrap) {
+                case SamplerWrap::REPEAT: return GL_REPEAT;
+                case SamplerWrap::MIRRORED_REPEAT: return GL_MIRRORED_REPEAT;
+                case SamplerWrap::CLAMP_TO_EDGE: return GL_CLAMP_TO_EDGE;
+                case SamplerWrap::CLAMP_TO_BORDER: return GL_CLAMP_TO_BORDER;
+            }
+            return GL_REPEAT;
+        }
+
+        GLint gl_min_filter(const SamplerFilter filter, const SamplerMipmapMode mode) {
+            const auto linear = filter == SamplerFilter::LINEAR;
+            switch(mode) {
+                case SamplerMipmapMode::NONE: return linear ? GL_LINEAR : GL_NEAREST;
+                case SamplerMipmapMode::NEAREST: return linear ? GL_LINEAR_MIPMAP_NEAREST : GL_NEAREST_MIPMAP_NEAREST;
+                case SamplerMipmapMode::LINEAR: return linear ? GL_LINEAR_MIPMAP_LINEAR : GL_NEAREST_MIPMAP_LINEAR;
+            }
+            return GL_LINEAR;
+        }
+
+        unsigned int clamp_anisotropy(const unsigned int anisotropy) {
+            return std::clamp(anisotropy, 1u, MAX_ANISOTROPY);
+        }
+
+    }
+
+    Uint32 SamplerDescriptor::pack() const noexcept {
+        return static_cast<Uint32>(min_filter)
+                | static_cast<Uint32>(mag_filter) << 1
+                | static_cast<Uint32>(mipmap_mode) << 2
+                | static_cast<Uint32>(wrap_s) << 4
+                | static_cast<Uint32>(wrap_t) << 6
+                | static_cast<Uint32>(clamp_anisotropy(max_anisotropy) - 1) << 8;
+    }
+
+    bool operator==(const SamplerDescriptor& left, const SamplerDescriptor& right) noexcept {
+        return left.pack() == right.pack();
+    }
+
+    bool operator!=(const SamplerDescriptor& left, const SamplerDescriptor& right) noexcept {
+        return !(left == right);
+    }
+
+    Sampler::Sampler(const SamplerDescriptor& descriptor) : m_descriptor{descriptor} {
+        m_descriptor.max_anisotropy = clamp_anisotropy(descriptor.max_anisotropy);
+        glGenSamplers(1, &m_sampler);
+        glSamplerParameteri(m_sampler, GL_TEXTURE_MIN_FILTER, gl_min_filter(descriptor.min_filter,
+                descriptor.mipmap_mode));
+        glSamplerParameteri(m_sampler, GL_TEXTURE_MAG_FILTER,
+                descriptor.mag_filter == SamplerFilter::LINEAR ? GL_LINEAR : GL_NEAREST);
+        glSamplerParameteri(m_sampler, GL_TEXTURE_WRAP_S, gl_wrap(descriptor.wrap_s));
+        glSamplerParameteri(m_sampler, GL_TEXTURE_WRAP_T, gl_wrap(descriptor.wrap_t));
+        if(m_descriptor.max_anisotropy > 1
+                && (has_gl_version(4, 6) || has_gl_extension("GL_EXT_texture_filter_anisotropic"))) {
+            GLfloat supported{1.0f};
+            glGetFloatv(GL_MAX_TEXTURE_MAX_ANISOTROPY_EXT, &supported);
+            glSamplerParameterf(m_sampler, GL_TEXTURE_MAX_ANISOTROPY_EXT,
+                    std::min(static_cast<GLfloat>(m_descriptor.max_anisotropy), supported));
+        }
+    }
+
+    Sampler::~Sampler() {
+        glDeleteSamplers(1, &m_sampler);
+    }
+
+    const Sampler& Sampler::get(const SamplerDescriptor& descriptor) {
+        auto& cache = sampler_cache();
+        std::lock_guard<std::mutex> lock{cache.mutex};
+        auto& sampler = cache.samplers[descriptor.pack()];
+        if(sampler == nullptr) {
+            sampler.reset(new Sampler{descriptor});
+        }
+        return *sampler;
+    }
+
+    void Sampler::clear_cache() {
+        auto& cache = sampler_cache();
+        std::lock_guard<std::mutex> lock{cache.mutex};
+        cache.samplers.clear();
+        cache.bound.clear();
+    }
+
+    void Sampler::bind(const unsigned int unit) const {
+        auto& cache = sampler_cache();
+        std::lock_guard<std::mutex> lock{cache.mutex};
+        if(unit >= cache.bound.size()) {
+            cache.bound.resize(unit + 1, 0);
+        } else if(cache.bound[unit] == m_sampler) {
+            return;
+        }
+        glBindSampler(unit, m_sampler);
+        cache.bound[unit] = m_sampler;
+    }
+
+    void Sampler::unbind(const unsigned int unit) {
+        auto& cache = sampler_cache();
+        std::lock_guard<std::mutex> lock{cache.mutex};
+        if(unit < cache.bound.size()) {
+            cache.bound[unit] = 0;
+        }
+        glBindSampler(unit, 0);
+    }
+
+    const SamplerDescriptor& Sampler::descriptor() const noexcept {
+        return m_descriptor;
+    }
+
+    unsigned int Sampler::native_handle() const noexcept {
+        return m_sampler;
+    }
+
+}
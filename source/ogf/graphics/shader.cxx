@@ -1,11 +1,22 @@
 #include <ogf/graphics/shader.hxx>
 
+#include <algorithm>
+#include <array>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
 #include <fstream>
+#include <iterator>
+#include <memory>
 #include <optional>
 #include <sstream>
+#include <vector>
 
 #include <glad/glad.h>
 
+#include <ogf/graphics/gl_extensions.hxx>
+#include <ogf/utils/hash.hxx>
+
 namespace ogf {
 
     namespace {
@@ -24,10 +35,185 @@ namespace ogf {
             return file_content.str();
         }
 
+        // Stages in the order of Shader::StageSources.
+        constexpr GLenum STAGE_TYPES[]{GL_VERTEX_SHADER, GL_GEOMETRY_SHADER, GL_FRAGMENT_SHADER, GL_COMPUTE_SHADER};
+        const char* const STAGE_NAMES[]{"vertex", "geometry", "fragment", "compute"};
+
+        // Sources of all stages with just one of them given.
+        std::array<const char*, 4> stage_sources(const std::string_view source, const ShaderType type) {
+            std::array<const char*, 4> sources{};
+            switch(type) {
+                case ShaderType::VERTEX: {
+                    sources[0] = source.data();
+                    break;
+                }
+                case ShaderType::GEOMETRY: {
+                    sources[1] = source.data();
+                    break;
+                }
+                case ShaderType::FRAGMENT: {
+                    sources[2] = source.data();
+                    break;
+                }
+                case ShaderType::COMPUTE: {
+                    sources[3] = source.data();
+                    break;
+                }
+            }
+            return sources;
+        }
+
+        std::string info_log(const GLuint object, const bool program) {
+            std::string message(1024, '\0');
+            if(program) {
+                glGetProgramInfoLog(object, 1024, nullptr, message.data());
+            } else {
+                glGetShaderInfoLog(object, 1024, nullptr, message.data());
+            }
+            message.resize(std::strlen(message.c_str()));
+            return message;
+        }
+
+        // Program binary cache file: magic, both halves of the key, the binary format and the binary itself.
+        constexpr char BINARY_CACHE_MAGIC[8]{'O', 'G', 'F', 'P', 'B', '0', '0', '1'};
+        constexpr std::size_t BINARY_CACHE_HEADER_SIZE = sizeof(BINARY_CACHE_MAGIC) + 2 * sizeof(Uint64)
+                + sizeof(Uint32);
+
+        std::mutex  binary_cache_mutex{};
+        std::string binary_cache_directory{};
+
+        struct BinaryCacheKey {
+            Uint64 hash{};
+            // Checked against the file to catch collisions in the file name.
+            Uint64 check{};
+        };
+
+        BinaryCacheKey binary_cache_key(const std::array<const char*, 4>& sources) {
+            // Different seeds make the two halves independent.
+            BinaryCacheKey key{0, 0x9E3779B97F4A7C15u};
+            const auto add = [&](const char* text) {
+                // Missing stages get a length no string can have, so sources can't be shifted between stages.
+                const Uint64 size = text != nullptr ? std::strlen(text) : ~Uint64{0};
+                key.hash = hash_bytes(&size, sizeof(size), key.hash);
+                key.check = hash_bytes(&size, sizeof(size), key.check);
+                if(text != nullptr) {
+                    key.hash = hash_bytes(text, size, key.hash);
+                    key.check = hash_bytes(text, size, key.check);
+                }
+            };
+            for(const auto name : {GL_VENDOR, GL_RENDERER, GL_VERSION}) {
+                add(reinterpret_cast<const char*>(glGetString(name)));
+            }
+            for(const auto source : sources) {
+                add(source);
+            }
+            return key;
+        }
+
+        std::string binary_cache_filename(const std::string& directory, const BinaryCacheKey& key) {
+            char name[17]{};
+            std::snprintf(name, sizeof(name), "%016llx", static_cast<unsigned long long>(key.hash));
+            return (std::filesystem::path{directory} / (std::string{name} + ".bin")).string();
+        }
+
+        // Create a program from a cached binary. Returns 0 if there's no binary or the driver doesn't take it.
+        GLuint load_program_binary(const std::string& filename, const BinaryCacheKey& key) {
+            std::ifstream file{filename, std::ios::binary};
+            if(!file.good()) {
+                return 0;
+            }
+            const std::vector<char> data{std::istreambuf_iterator<char>{file}, std::istreambuf_iterator<char>{}};
+            if(data.size() <= BINARY_CACHE_HEADER_SIZE
+                    || std::memcmp(data.data(), BINARY_CACHE_MAGIC, sizeof(BINARY_CACHE_MAGIC)) != 0) {
+                return 0;
+            }
+            Uint64 hash{}, check{};
+            Uint32 format{};
+            auto field = data.data() + sizeof(BINARY_CACHE_MAGIC);
+            std::memcpy(&hash, field, sizeof(hash));
+            std::memcpy(&check, field + sizeof(hash), sizeof(check));
+            std::memcpy(&format, field + sizeof(hash) + sizeof(check), sizeof(format));
+            if(hash != key.hash || check != key.check) {
+                return 0;
+            }
+            const auto program = glCreateProgram();
+            gl_extension_functions().program_binary(program, format, data.data() + BINARY_CACHE_HEADER_SIZE,
+                    static_cast<GLsizei>(data.size() - BINARY_CACHE_HEADER_SIZE));
+            int success{};
+            glGetProgramiv(program, GL_LINK_STATUS, &success);
+            if(!success) {
+                glDeleteProgram(program);
+                return 0;
+            }
+            return program;
+        }
+
+        // Write the binary of a linked program to the cache. The cache is only an optimization, so failures are
+        // ignored. The file is written under a temporary name and renamed, so other processes never see a part of it.
+        void store_program_binary(const GLuint program, const std::string& filename, const BinaryCacheKey& key) {
+            GLint length{0};
+            glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length);
+            if(length <= 0) {
+                return;
+            }
+            std::vector<char> data(BINARY_CACHE_HEADER_SIZE + static_cast<std::size_t>(length));
+            GLenum format{};
+            gl_extension_functions().get_program_binary(program, length, &length, &format,
+                    data.data() + BINARY_CACHE_HEADER_SIZE);
+            if(length <= 0) {
+                return;
+            }
+            data.resize(BINARY_CACHE_HEADER_SIZE + static_cast<std::size_t>(length));
+            const auto format_value = static_cast<Uint32>(format);
+            const auto field = data.data() + sizeof(BINARY_CACHE_MAGIC);
+            std::memcpy(data.data(), BINARY_CACHE_MAGIC, sizeof(BINARY_CACHE_MAGIC));
+            std::memcpy(field, &key.hash, sizeof(key.hash));
+            std::memcpy(field + sizeof(key.hash), &key.check, sizeof(key.check));
+            std::memcpy(field + sizeof(key.hash) + sizeof(key.check), &format_value, sizeof(format_value));
+            std::error_code error{};
+            std::filesystem::create_directories(std::filesystem::path{filename}.parent_path(), error);
+            const auto temporary = filename + ".tmp";
+            {
+                std::ofstream file{temporary, std::ios::binary | std::ios::trunc};
+                if(!file.write(data.data(), static_cast<std::streamsize>(data.size()))) {
+                    file.close();
+                    std::filesystem::remove(temporary, error);
+                    return;
+                }
+            }
+            std::filesystem::rename(temporary, filename, error);
+            if(error) {
+                std::filesystem::remove(temporary, error);
+            }
+        }
+
+    }
+
+    void Shader::set_binary_cache_directory(const std::string_view directory) {
+        std::lock_guard<std::mutex> mutex_lock{binary_cache_mutex};
+        binary_cache_directory = directory;
+    }
+
+    // Stages submitted to the driver whose results haven't been checked yet.
+    struct Shader::PendingCompile {
+        std::array<GLuint, 4> shaders{};
+        std::string           cache_filename{};
+        BinaryCacheKey        cache_key{};
+    };
+
+    bool Shader::Uniform::update(const void* value, const std::size_t size) noexcept {
+        if(known && std::memcmp(shadow.data(), value, size) == 0) {
+            return false;
+        }
+        std::memcpy(shadow.data(), value, size);
+        known = true;
+        return true;
     }
 
+    Shader::Shader() noexcept = default;
+
     Shader::~Shader() {
-        glDeleteProgram(m_program);
+        release();
     }
 
     void Shader::load_from_file(const std::string_view filename, const ShaderType type) {
@@ -68,98 +254,357 @@ namespace ogf {
     }
 
     void Shader::load_from_memory(const std::string_view source, const ShaderType type) {
-        switch(type) {
-            case ShaderType::VERTEX: {
-                compile(source.data(), nullptr, nullptr);
-            }
-            case ShaderType::GEOMETRY: {
-                compile(nullptr, source.data(), nullptr);
-            }
-            case ShaderType::FRAGMENT: {
-                compile(nullptr, nullptr, source.data());
-            }
-        }
+        compile(stage_sources(source, type), false);
     }
 
     void Shader::load_from_memory(const std::string_view vertex_source, const std::string_view fragment_source) {
-        compile(vertex_source.data(), nullptr, fragment_source.data());
+        compile({vertex_source.data(), nullptr, fragment_source.data(), nullptr}, false);
     }
 
     void Shader::load_from_memory(const std::string_view vertex_source, const std::string_view geometry_source,
             const std::string_view fragment_source) {
-        compile(vertex_source.data(), geometry_source.data(), fragment_source.data());
+        compile({vertex_source.data(), geometry_source.data(), fragment_source.data(), nullptr}, false);
+    }
+
+    void Shader::load_from_memory_async(const std::string_view source, const ShaderType type) {
+        compile(stage_sources(source, type), true);
+    }
+
+    void Shader::load_from_memory_async(const std::string_view vertex_source,
+            const std::string_view fragment_source) {
+        compile({vertex_source.data(), nullptr, fragment_source.data(), nullptr}, true);
+    }
+
+    void Shader::load_from_memory_async(const std::string_view vertex_source, const std::string_view geometry_source,
+            const std::string_view fragment_source) {
+        compile({vertex_source.data(), geometry_source.data(), fragment_source.data(), nullptr}, true);
+    }
+
+    bool Shader::is_ready() {
+        std::lock_guard<std::mutex> mutex_lock{m_mutex};
+        if(!m_pending) {
+            return true;
+        }
+        if(has_parallel_shader_compile()) {
+            int completed{};
+            glGetProgramiv(m_program, GL_COMPLETION_STATUS_KHR, &completed);
+            if(!completed) {
+                return false;
+            }
+        }
+        finish();
+        return true;
+    }
+
+    void Shader::wait() {
+        std::lock_guard<std::mutex> mutex_lock{m_mutex};
+        if(m_pending) {
+            finish();
+        }
+    }
+
+    int Shader::uniform_location(const UniformName name) const noexcept {
+        const auto uniform = std::lower_bound(m_uniforms.begin(), m_uniforms.end(), name.hash,
+                [](const Uniform& uniform, const Uint64 hash) { return uniform.hash < hash; });
+        return uniform != m_uniforms.end() && uniform->hash == name.hash ? uniform->location : -1;
+    }
+
+    void Shader::set_uniform(const UniformName name, const int value) {
+        if(const auto uniform = find_uniform(name); uniform != nullptr && uniform->update(&value, sizeof(value))) {
+            glUniform1i(uniform->location, value);
+        }
+    }
+
+    void Shader::set_uniform(const UniformName name, const unsigned int value) {
+        if(const auto uniform = find_uniform(name); uniform != nullptr && uniform->update(&value, sizeof(value))) {
+            glUniform1ui(uniform->location, value);
+        }
+    }
+
+    void Shader::set_uniform(const UniformName name, const float value) {
+        if(const auto uniform = find_uniform(name); uniform != nullptr && uniform->update(&value, sizeof(value))) {
+            glUniform1f(uniform->location, value);
+        }
+    }
+
+    void Shader::set_uniform(const UniformName name, const Vector2F& value) {
+        const float values[]{value.x, value.y};
+        if(const auto uniform = find_uniform(name); uniform != nullptr && uniform->update(values, sizeof(values))) {
+            glUniform2fv(uniform->location, 1, values);
+        }
+    }
+
+    void Shader::set_uniform(const UniformName name, const Vector3F& value) {
+        const float values[]{value.x, value.y, value.z};
+        if(const auto uniform = find_uniform(name); uniform != nullptr && uniform->update(values, sizeof(values))) {
+            glUniform3fv(uniform->location, 1, values);
+        }
+    }
+
+    void Shader::set_uniform(const UniformName name, const Color& value) {
+        const float values[]{value.r, value.g, value.b, value.a};
+        if(const auto uniform = find_uniform(name); uniform != nullptr && uniform->update(values, sizeof(values))) {
+            glUniform4fv(uniform->location, 1, values);
+        }
+    }
+
+    void Shader::set_uniform_matrix4(const UniformName name, const float* values) {
+        if(const auto uniform = find_uniform(name); uniform != nullptr && uniform->update(values, 16 * sizeof(float))) {
+            glUniformMatrix4fv(uniform->location, 1, GL_FALSE, values);
+        }
+    }
+
+    bool Shader::bind_uniform_block(const UniformName name, const unsigned int binding) {
+        return bind_block(name, false, binding);
+    }
+
+    bool Shader::bind_storage_block(const UniformName name, const unsigned int binding) {
+        return bind_block(name, true, binding);
+    }
+
+    std::size_t Shader::uniform_block_size(const UniformName name) const noexcept {
+        for(const auto& block : m_blocks) {
+            if(block.hash == name.hash && !block.storage) {
+                return block.size;
+            }
+        }
+        return 0;
+    }
+
+    void Shader::dispatch(const unsigned int groups_x, const unsigned int groups_y, const unsigned int groups_z) {
+        prepare_dispatch();
+        gl_extension_functions().dispatch_compute(groups_x, groups_y, groups_z);
+    }
+
+    void Shader::dispatch_invocations(const unsigned int size_x, const unsigned int size_y,
+            const unsigned int size_z) {
+        prepare_dispatch();
+        const auto groups = [](const unsigned int size, const unsigned int group_size) {
+            return size / group_size + (size % group_size != 0 ? 1 : 0);
+        };
+        gl_extension_functions().dispatch_compute(groups(size_x, m_work_group_size[0]),
+                groups(size_y, m_work_group_size[1]), groups(size_z, m_work_group_size[2]));
+    }
+
+    void Shader::dispatch_indirect(const unsigned int buffer, const std::size_t offset) {
+        prepare_dispatch();
+        glBindBuffer(GL_DISPATCH_INDIRECT_BUFFER, buffer);
+        gl_extension_functions().dispatch_compute_indirect(static_cast<GLintptr>(offset));
+    }
+
+    std::array<unsigned int, 3> Shader::work_group_size() const noexcept {
+        return m_work_group_size;
     }
 
     unsigned int Shader::native_handle() const noexcept {
         return m_program;
     }
 
-    void Shader::compile(const char* vertex_source, const char* geometry_source, const char* fragment_source) {
+    void Shader::compile(const StageSources& sources, const bool async) {
+        if(sources[3] != nullptr && !has_compute_shaders()) {
+            throw std::runtime_error{"Failed to compile compute shader. Reason: compute shaders need OpenGL 4.3 or "
+                    "ARB_compute_shader.\n"};
+        }
         std::lock_guard<std::mutex> mutex_lock{m_mutex};
-        if(m_program != 0) {
-            glDeleteProgram(m_program);
-            m_program = 0;
+        release();
+        std::string cache_directory{};
+        if(has_program_binary()) {
+            std::lock_guard<std::mutex> cache_lock{binary_cache_mutex};
+            cache_directory = binary_cache_directory;
         }
-        unsigned int program = glCreateProgram();
-        if(vertex_source != nullptr) {
-            unsigned int vertex_shader = glCreateShader(GL_VERTEX_SHADER);
-            glShaderSource(vertex_shader, 1, &vertex_source, nullptr);
-            glCompileShader(vertex_shader);
-            int success{};
-            glGetShaderiv(vertex_shader, GL_COMPILE_STATUS, &success);
-            if(!success) {
-                std::string message(1024, '\0');
-                glGetShaderInfoLog(vertex_shader, 1024, nullptr, message.data());
-                glDeleteShader(vertex_shader);
-                glDeleteProgram(program);
-                throw std::runtime_error{"Failed to compile vertex shader. Reason: " + std::string{message} + "\n"};
+        auto pending = std::make_unique<PendingCompile>();
+        if(!cache_directory.empty()) {
+            pending->cache_key = binary_cache_key(sources);
+            pending->cache_filename = binary_cache_filename(cache_directory, pending->cache_key);
+            m_program = load_program_binary(pending->cache_filename, pending->cache_key);
+            if(m_program != 0) {
+                reflect(sources[3] != nullptr);
+                return;
             }
-            glAttachShader(program, vertex_shader);
-            glDeleteShader(vertex_shader);
         }
-        if(geometry_source != nullptr) {
-            unsigned int geometry_shader = glCreateShader(GL_GEOMETRY_SHADER);
-            glShaderSource(geometry_shader, 1, &geometry_source, nullptr);
-            glCompileShader(geometry_shader);
-            int success{};
-            glGetShaderiv(geometry_shader, GL_COMPILE_STATUS, &success);
-            if(!success) {
-                std::string message(1024, '\0');
-                glGetShaderInfoLog(geometry_shader, 1024, nullptr, message.data());
-                glDeleteShader(geometry_shader);
-                glDeleteProgram(program);
-                throw std::runtime_error{"Failed to compile geometry shader. Reason: " + std::string{message} + "\n"};
-            }
-            glAttachShader(program, geometry_shader);
-            glDeleteShader(geometry_shader);
+        // Everything is submitted before any status is queried, so the driver can work on all stages at once.
+        m_program = glCreateProgram();
+        if(!pending->cache_filename.empty()) {
+            gl_extension_functions().program_parameteri(m_program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
         }
-        if(fragment_source != nullptr) {
-            unsigned int fragment_shader = glCreateShader(GL_FRAGMENT_SHADER);
-            glShaderSource(fragment_shader, 1, &fragment_source, nullptr);
-            glCompileShader(fragment_shader);
-            int success{};
-            glGetShaderiv(fragment_shader, GL_COMPILE_STATUS, &success);
-            if(!success) {
-                std::string message(1024, '\0');
-                glGetShaderInfoLog(fragment_shader, 1024, nullptr, message.data());
-                glDeleteShader(fragment_shader);
-                glDeleteProgram(program);
-                throw std::runtime_error{"Failed to compile fragment shader. Reason: " + std::string{message} + "\n"};
+        for(std::size_t stage = 0; stage < pending->shaders.size(); ++stage) {
+            if(sources[stage] == nullptr) {
+                continue;
             }
-            glAttachShader(program, fragment_shader);
-            glDeleteShader(fragment_shader);
+            const auto shader = glCreateShader(STAGE_TYPES[stage]);
+            glShaderSource(shader, 1, &sources[stage], nullptr);
+            glCompileShader(shader);
+            glAttachShader(m_program, shader);
+            pending->shaders[stage] = shader;
         }
-        glLinkProgram(program);
+        glLinkProgram(m_program);
+        glFlush();
+        m_pending = std::move(pending);
+        if(!async) {
+            finish();
+        }
+    }
+
+    void Shader::finish() {
+        const auto pending = std::move(m_pending);
+        const auto program = m_program;
+        const auto delete_shaders = [&]() {
+            for(const auto shader : pending->shaders) {
+                if(shader != 0) {
+                    glDetachShader(program, shader);
+                    glDeleteShader(shader);
+                }
+            }
+        };
         int success{};
         glGetProgramiv(program, GL_LINK_STATUS, &success);
         if(!success) {
-            std::string message(1024, '\0');
-            glGetProgramInfoLog(program, 1024, nullptr, message.data());
+            // Report the first stage which failed to compile, or the linker if all of them compiled.
+            auto reason = "Failed to compile shader program. Reason: " + info_log(program, true) + "\n";
+            for(std::size_t stage = 0; stage < pending->shaders.size(); ++stage) {
+                const auto shader = pending->shaders[stage];
+                if(shader == 0) {
+                    continue;
+                }
+                glGetShaderiv(shader, GL_COMPILE_STATUS, &success);
+                if(!success) {
+                    reason = std::string{"Failed to compile "} + STAGE_NAMES[stage] + " shader. Reason: "
+                            + info_log(shader, false) + "\n";
+                    break;
+                }
+            }
+            delete_shaders();
             glDeleteProgram(program);
-            throw std::runtime_error{"Failed to compile shader program. Reason: " + std::string{message} + "\n"};
+            m_program = 0;
+            throw std::runtime_error{reason};
         }
-        m_program = program;
-        glFlush();
+        delete_shaders();
+        if(!pending->cache_filename.empty()) {
+            store_program_binary(program, pending->cache_filename, pending->cache_key);
+        }
+        reflect(pending->shaders[3] != 0);
+    }
+
+    void Shader::release() noexcept {
+        if(m_pending) {
+            for(const auto shader : m_pending->shaders) {
+                glDeleteShader(shader);
+            }
+            m_pending.reset();
+        }
+        if(m_program != 0) {
+            glDeleteProgram(m_program);
+            m_program = 0;
+        }
+        m_uniforms.clear();
+        m_blocks.clear();
+        m_work_group_size = {};
+    }
+
+    void Shader::reflect(const bool compute) {
+        if(compute) {
+            GLint size[3]{};
+            glGetProgramiv(m_program, GL_COMPUTE_WORK_GROUP_SIZE, size);
+            for(std::size_t i = 0; i < m_work_group_size.size(); ++i) {
+                m_work_group_size[i] = static_cast<unsigned int>(size[i]);
+            }
+        }
+        m_blocks.clear();
+        GLint block_count{0}, max_block_length{0};
+        glGetProgramiv(m_program, GL_ACTIVE_UNIFORM_BLOCKS, &block_count);
+        glGetProgramiv(m_program, GL_ACTIVE_UNIFORM_BLOCK_MAX_NAME_LENGTH, &max_block_length);
+        std::string block_name(static_cast<std::size_t>(std::max(max_block_length, 1)), '\0');
+        for(GLint i = 0; i < block_count; ++i) {
+            GLsizei length{0};
+            GLint size{0};
+            glGetActiveUniformBlockName(m_program, static_cast<GLuint>(i), max_block_length, &length,
+                    block_name.data());
+            glGetActiveUniformBlockiv(m_program, static_cast<GLuint>(i), GL_UNIFORM_BLOCK_DATA_SIZE, &size);
+            auto& block = m_blocks.emplace_back();
+            block.hash = UniformName{std::string_view{block_name.data(), static_cast<std::size_t>(length)}}.hash;
+            block.index = static_cast<unsigned int>(i);
+            block.size = static_cast<std::size_t>(size);
+        }
+        if(has_shader_storage_buffers()) {
+            const auto& gl = gl_extension_functions();
+            gl.get_program_interfaceiv(m_program, GL_SHADER_STORAGE_BLOCK, GL_ACTIVE_RESOURCES, &block_count);
+            gl.get_program_interfaceiv(m_program, GL_SHADER_STORAGE_BLOCK, GL_MAX_NAME_LENGTH, &max_block_length);
+            block_name.assign(static_cast<std::size_t>(std::max(max_block_length, 1)), '\0');
+            for(GLint i = 0; i < block_count; ++i) {
+                GLsizei length{0};
+                gl.get_program_resource_name(m_program, GL_SHADER_STORAGE_BLOCK, static_cast<GLuint>(i),
+                        max_block_length, &length, block_name.data());
+                auto& block = m_blocks.emplace_back();
+                block.hash = UniformName{std::string_view{block_name.data(), static_cast<std::size_t>(length)}}.hash;
+                block.index = static_cast<unsigned int>(i);
+                block.storage = true;
+            }
+        }
+
+        GLint count{0}, max_length{0};
+        glGetProgramiv(m_program, GL_ACTIVE_UNIFORMS, &count);
+        glGetProgramiv(m_program, GL_ACTIVE_UNIFORM_MAX_LENGTH, &max_length);
+        std::string name(static_cast<std::size_t>(std::max(max_length, 1)), '\0');
+        m_uniforms.clear();
+        m_uniforms.reserve(static_cast<std::size_t>(count));
+        for(GLint i = 0; i < count; ++i) {
+            GLsizei length{0};
+            GLint size{0};
+            GLenum type{};
+            glGetActiveUniform(m_program, static_cast<GLuint>(i), max_length, &length, &size, &type, name.data());
+            const auto location = glGetUniformLocation(m_program, name.c_str());
+            // Members of uniform blocks have no location.
+            if(location < 0) {
+                continue;
+            }
+            std::string_view base{name.data(), static_cast<std::size_t>(length)};
+            if(base.size() > 3 && base.substr(base.size() - 3) == "[0]") {
+                base.remove_suffix(3);
+            }
+            auto& uniform = m_uniforms.emplace_back();
+            uniform.hash = UniformName{base}.hash;
+            uniform.location = location;
+        }
+        std::sort(m_uniforms.begin(), m_uniforms.end(),
+                [](const Uniform& left, const Uniform& right) { return left.hash < right.hash; });
+    }
+
+    bool Shader::bind_block(const UniformName name, const bool storage, const unsigned int binding) {
+        if(m_pending) {
+            wait();
+        }
+        const auto block = std::find_if(m_blocks.begin(), m_blocks.end(),
+                [&](const Block& block) { return block.hash == name.hash && block.storage == storage; });
+        if(block == m_blocks.end()) {
+            return false;
+        }
+        if(block->binding != static_cast<int>(binding)) {
+            if(storage) {
+                gl_extension_functions().shader_storage_block_binding(m_program, block->index, binding);
+            } else {
+                glUniformBlockBinding(m_program, block->index, binding);
+            }
+            block->binding = static_cast<int>(binding);
+        }
+        return true;
+    }
+
+    void Shader::prepare_dispatch() {
+        if(m_pending) {
+            wait();
+        }
+        if(m_work_group_size[0] == 0) {
+            throw std::runtime_error{"Failed to dispatch shader program: it has no compute shader."};
+        }
+    }
+
+    Shader::Uniform* Shader::find_uniform(const UniformName name) {
+        if(m_pending) {
+            wait();
+        }
+        const auto uniform = std::lower_bound(m_uniforms.begin(), m_uniforms.end(), name.hash,
+                [](const Uniform& uniform, const Uint64 hash) { return uniform.hash < hash; });
+        return uniform != m_uniforms.end() && uniform->hash == name.hash ? &*uniform : nullptr;
     }
 
 }
@@ -0,0 +1,243 @@
+#include <ogf/graphics/shader_preprocessor.hxx>
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <optional>
+#include <sstream>
+#include <stdexcept>
+
+namespace ogf {
+
+    namespace {
+
+        std::optional<std::string> read_file(const std::filesystem::path& path) {
+            std::ifstream file{path, std::ios::binary};
+            if(!file.good()) {
+                return {};
+            }
+            std::stringstream content{};
+            content << file.rdbuf();
+            return content.str();
+        }
+
+        std::string_view trim_front(std::string_view text) {
+            while(!text.empty() && (text.front() == ' ' || text.front() == '\t')) {
+                text.remove_prefix(1);
+            }
+            return text;
+        }
+
+        // Get the argument of a preprocessor directive, or nothing if the line isn't that directive.
+        std::optional<std::string_view> directive(const std::string_view line, const std::string_view name) {
+            auto text = trim_front(line);
+            if(text.empty() || text.front() != '#') {
+                return {};
+            }
+            text = trim_front(text.substr(1));
+            if(text.substr(0, name.size()) != name) {
+                return {};
+            }
+            text.remove_prefix(name.size());
+            if(!text.empty() && text.front() != ' ' && text.front() != '\t' && text.front() != '"'
+                    && text.front() != '<') {
+                return {};
+            }
+            return trim_front(text);
+        }
+
+        bool has_version(const std::string_view source) {
+            std::size_t start{0};
+            while(start < source.size()) {
+                const auto end = std::min(source.find('\n', start), source.size());
+                if(directive(source.substr(start, end - start), "version")) {
+                    return true;
+                }
+                start = end + 1;
+            }
+            return false;
+        }
+
+        // Expands the includes of one source into the output.
+        class Expansion {
+        public:
+            Expansion(const std::vector<std::string>& include_directories,
+                    const std::vector<std::pair<std::string, std::string>>& sources, const ShaderDefines& defines)
+                    : m_include_directories{include_directories}, m_sources{sources}, m_defines{defines} {
+            }
+
+            std::string run(const std::string_view source, const std::string_view filename) {
+                if(!filename.empty()) {
+                    // The source itself counts as included, so including it again does nothing.
+                    std::error_code error{};
+                    m_files.push_back(File{std::filesystem::weakly_canonical(std::filesystem::path{filename}, error)
+                            .string(), 0, true});
+                }
+                if(!has_version(source)) {
+                    write_defines();
+                    m_output += "#line 1 0\n";
+                }
+                expand(source, filename, 0, false);
+                return std::move(m_output);
+            }
+
+        private:
+            // Included file with its source number. Files included only under #if and similar directives may be
+            // skipped by the GLSL preprocessor, so they're included again when they're needed elsewhere, with a guard.
+            struct File {
+                std::string  key{};
+                unsigned int number{};
+                bool         unconditional{false};
+            };
+
+            void write_defines() {
+                for(const auto& [name, value] : m_defines) {
+                    m_output += "#define " + name + (value.empty() ? "" : " " + value) + "\n";
+                }
+                m_defines_pending = false;
+            }
+
+            void expand(const std::string_view source, const std::string_view filename, const unsigned int number,
+                    const bool conditional) {
+                const auto directory = std::filesystem::path{filename}.parent_path();
+                std::size_t start{0};
+                unsigned int line_number{0};
+                unsigned int depth{0};
+                while(start < source.size()) {
+                    const auto end = std::min(source.find('\n', start), source.size());
+                    const auto line = source.substr(start, end - start);
+                    start = end + 1;
+                    ++line_number;
+                    if(directive(line, "if") || directive(line, "ifdef") || directive(line, "ifndef")) {
+                        ++depth;
+                    } else if(directive(line, "endif") && depth > 0) {
+                        --depth;
+                    }
+                    // #line sets the number of the line after it.
+                    if(const auto argument = directive(line, "include")) {
+                        include(*argument, directory, filename, line_number, conditional || depth > 0);
+                        m_output += "#line " + std::to_string(line_number + 1) + " " + std::to_string(number) + "\n";
+                        continue;
+                    }
+                    m_output.append(line).append("\n");
+                    if(m_defines_pending && number == 0 && directive(line, "version")) {
+                        write_defines();
+                        m_output += "#line " + std::to_string(line_number + 1) + " 0\n";
+                    }
+                }
+            }
+
+            void include(const std::string_view argument, const std::filesystem::path& directory,
+                    const std::string_view filename, const unsigned int line_number, const bool conditional) {
+                const auto close = argument.empty() ? std::string_view::npos
+                        : argument.find(argument.front() == '<' ? '>' : '"', 1);
+                if(close == std::string_view::npos || (argument.front() != '"' && argument.front() != '<')) {
+                    throw std::runtime_error{"Failed to preprocess shader \"" + std::string{filename}
+                            + "\": malformed #include on line " + std::to_string(line_number) + "."};
+                }
+                const std::string name{argument.substr(1, close - 1)};
+                for(const auto& [source_name, source] : m_sources) {
+                    if(source_name == name) {
+                        expand_once(source, name, name, conditional);
+                        return;
+                    }
+                }
+                std::vector<std::filesystem::path> candidates{directory / name};
+                for(const auto& include_directory : m_include_directories) {
+                    candidates.push_back(std::filesystem::path{include_directory} / name);
+                }
+                for(const auto& candidate : candidates) {
+                    std::error_code error{};
+                    if(!std::filesystem::is_regular_file(candidate, error)) {
+                        continue;
+                    }
+                    const auto path = std::filesystem::weakly_canonical(candidate, error).string();
+                    const auto file = find_file(path);
+                    if(file != nullptr && file->unconditional) {
+                        return;
+                    }
+                    const auto content = read_file(candidate);
+                    if(!content.has_value()) {
+                        break;
+                    }
+                    expand_once(*content, path, candidate.string(), conditional);
+                    return;
+                }
+                // The branch may be inactive, so it's up to the GLSL preprocessor to report the error.
+                if(conditional) {
+                    m_output += "#error can't find included file \"" + name + "\"\n";
+                    return;
+                }
+                throw std::runtime_error{"Failed to preprocess shader \"" + std::string{filename}
+                        + "\": can't find included file \"" + name + "\" on line " + std::to_string(line_number)
+                        + "."};
+            }
+
+            File* find_file(const std::string& key) {
+                const auto file = std::find_if(m_files.begin(), m_files.end(),
+                        [&](const File& file) { return file.key == key; });
+                return file != m_files.end() ? &*file : nullptr;
+            }
+
+            void expand_once(const std::string_view source, const std::string& key, const std::string& filename,
+                    const bool conditional) {
+                auto file = find_file(key);
+                if(file != nullptr && file->unconditional) {
+                    return;
+                }
+                // Guarded if the file may be or may have been skipped, so it's never there twice.
+                const auto guarded = conditional || file != nullptr;
+                if(file == nullptr) {
+                    file = &m_files.emplace_back(File{key, ++m_file_count, false});
+                }
+                file->unconditional = !conditional;
+                const auto number = std::to_string(file->number);
+                if(guarded) {
+                    m_output += "#ifndef OGF_INCLUDED_" + number + "\n#define OGF_INCLUDED_" + number + "\n";
+                }
+                m_output += "#line 1 " + number + "\n";
+                expand(source, filename, file->number, conditional);
+                if(guarded) {
+                    m_output += "#endif\n";
+                }
+            }
+
+            const std::vector<std::string>&                         m_include_directories;
+            const std::vector<std::pair<std::string, std::string>>& m_sources;
+            const ShaderDefines&                                    m_defines;
+            std::vector<File>                                       m_files{};
+            std::string                                             m_output{};
+            unsigned int                                            m_file_count{0};
+            bool                                                    m_defines_pending{true};
+        };
+
+    }
+
+    void ShaderPreprocessor::add_include_directory(const std::string_view directory) {
+        m_include_directories.emplace_back(directory);
+    }
+
+    void ShaderPreprocessor::add_source(const std::string_view name, const std::string_view source) {
+        for(auto& [source_name, content] : m_sources) {
+            if(source_name == name) {
+                content = source;
+                return;
+            }
+        }
+        m_sources.emplace_back(name, source);
+    }
+
+    std::string ShaderPreprocessor::process(const std::string_view source, const ShaderDefines& defines,
+            const std::string_view filename) const {
+        return Expansion{m_include_directories, m_sources, defines}.run(source, filename);
+    }
+
+    std::string ShaderPreprocessor::process_file(const std::string_view filename, const ShaderDefines& defines) const {
+        const auto source = read_file(std::filesystem::path{filename});
+        if(!source.has_value()) {
+            throw std::runtime_error{"Failed to open shader file \"" + std::string{filename} + "\"."};
+        }
+        return process(*source, defines, filename);
+    }
+
+}
@@ -0,0 +1,164 @@
+#include <ogf/graphics/shader_variants.hxx>
+
+#include <algorithm>
+#include <array>
+#include <fstream>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <unordered_map>
+
+#include <ogf/graphics/shader.hxx>
+#include <ogf/utils/thread_pool.hxx>
+
+namespace ogf {
+
+    namespace {
+
+        std::string read_shader_file(const std::string_view filename) {
+            std::ifstream file{std::string{filename}, std::ios::binary};
+            if(!file.good()) {
+                throw std::runtime_error{"Failed to open shader file \"" + std::string{filename} + "\"."};
+            }
+            std::stringstream content{};
+            content << file.rdbuf();
+            return content.str();
+        }
+
+        // Same defines in any order give the same key.
+        std::string variant_key(ShaderDefines defines) {
+            std::sort(defines.begin(), defines.end());
+            std::string key{};
+            for(const auto& [name, value] : defines) {
+                key.append(name).append("=").append(value).append("\n");
+            }
+            return key;
+        }
+
+    }
+
+    struct ShaderVariants::Impl {
+        // Preprocessed sources of the vertex, geometry, fragment and compute stages.
+        using Sources = std::array<std::string, 4>;
+
+        Sources preprocess(const ShaderDefines& defines) const;
+
+        // Start compiling a variant.
+        void load(Shader& shader, const Sources& variant_sources, const bool async) const;
+
+        ShaderPreprocessor                                       preprocessor{};
+        // Empty for stages which aren't present.
+        std::array<std::string, 4>                               filenames{};
+        Sources                                                  sources{};
+        std::unordered_map<std::string, std::unique_ptr<Shader>> variants{};
+    };
+
+    ShaderVariants::Impl::Sources ShaderVariants::Impl::preprocess(const ShaderDefines& defines) const {
+        Sources result{};
+        for(std::size_t stage = 0; stage < sources.size(); ++stage) {
+            if(!filenames[stage].empty()) {
+                result[stage] = preprocessor.process(sources[stage], defines, filenames[stage]);
+            }
+        }
+        return result;
+    }
+
+    void ShaderVariants::Impl::load(Shader& shader, const Sources& variant_sources, const bool async) const {
+        if(!filenames[3].empty()) {
+            if(async) {
+                shader.load_from_memory_async(variant_sources[3], ShaderType::COMPUTE);
+            } else {
+                shader.load_from_memory(variant_sources[3], ShaderType::COMPUTE);
+            }
+        } else if(!filenames[1].empty()) {
+            if(async) {
+                shader.load_from_memory_async(variant_sources[0], variant_sources[1], variant_sources[2]);
+            } else {
+                shader.load_from_memory(variant_sources[0], variant_sources[1], variant_sources[2]);
+            }
+        } else if(async) {
+            shader.load_from_memory_async(variant_sources[0], variant_sources[2]);
+        } else {
+            shader.load_from_memory(variant_sources[0], variant_sources[2]);
+        }
+    }
+
+    ShaderVariants::ShaderVariants(ShaderPreprocessor preprocessor, const std::string_view compute_filename) {
+        auto compute_source = read_shader_file(compute_filename);
+        m_impl = std::make_unique<Impl>();
+        m_impl->preprocessor = std::move(preprocessor);
+        m_impl->filenames[3] = std::string{compute_filename};
+        m_impl->sources[3] = std::move(compute_source);
+    }
+
+    ShaderVariants::ShaderVariants(ShaderPreprocessor preprocessor, const std::string_view vertex_filename,
+            const std::string_view fragment_filename) {
+        auto vertex_source = read_shader_file(vertex_filename);
+        auto fragment_source = read_shader_file(fragment_filename);
+        m_impl = std::make_unique<Impl>();
+        m_impl->preprocessor = std::move(preprocessor);
+        m_impl->filenames = {std::string{vertex_filename}, std::string{}, std::string{fragment_filename}};
+        m_impl->sources = {std::move(vertex_source), std::string{}, std::move(fragment_source)};
+    }
+
+    ShaderVariants::ShaderVariants(ShaderPreprocessor preprocessor, const std::string_view vertex_filename,
+            const std::string_view geometry_filename, const std::string_view fragment_filename) {
+        auto vertex_source = read_shader_file(vertex_filename);
+        auto geometry_source = read_shader_file(geometry_filename);
+        auto fragment_source = read_shader_file(fragment_filename);
+        m_impl = std::make_unique<Impl>();
+        m_impl->preprocessor = std::move(preprocessor);
+        m_impl->filenames = {std::string{vertex_filename}, std::string{geometry_filename},
+                std::string{fragment_filename}};
+        m_impl->sources = {std::move(vertex_source), std::move(geometry_source), std::move(fragment_source)};
+    }
+
+    ShaderVariants::~ShaderVariants() = default;
+
+    Shader& ShaderVariants::get(const ShaderDefines& defines) {
+        auto& impl = *m_impl;
+        auto key = variant_key(defines);
+        const auto variant = impl.variants.find(key);
+        if(variant != impl.variants.end()) {
+            try {
+                variant->second->wait();
+            } catch(...) {
+                // Forget the broken variant, so it's compiled again next time.
+                impl.variants.erase(variant);
+                throw;
+            }
+            return *variant->second;
+        }
+        const auto sources = impl.preprocess(defines);
+        auto shader = std::make_unique<Shader>();
+        impl.load(*shader, sources, false);
+        return *impl.variants.emplace(std::move(key), std::move(shader)).first->second;
+    }
+
+    void ShaderVariants::prepare(const std::vector<ShaderDefines>& variants) {
+        auto& impl = *m_impl;
+        std::vector<std::string> keys{};
+        std::vector<const ShaderDefines*> missing{};
+        for(const auto& defines : variants) {
+            auto key = variant_key(defines);
+            if(impl.variants.count(key) == 0 && std::find(keys.begin(), keys.end(), key) == keys.end()) {
+                keys.push_back(std::move(key));
+                missing.push_back(&defines);
+            }
+        }
+        std::vector<Impl::Sources> sources(missing.size());
+        parallel_for(missing.size(), [&](const std::size_t i) {
+            sources[i] = impl.preprocess(*missing[i]);
+        });
+        for(std::size_t i = 0; i < missing.size(); ++i) {
+            auto shader = std::make_unique<Shader>();
+            impl.load(*shader, sources[i], true);
+            impl.variants.emplace(std::move(keys[i]), std::move(shader));
+        }
+    }
+
+    std::size_t ShaderVariants::size() const noexcept {
+        return m_impl->variants.size();
+    }
+
+}
@@ -0,0 +1,70 @@
+#include <ogf/graphics/skyline_packer.hxx>
+
+#include <algorithm>
+#include <limits>
+
+namespace ogf {
+
+    SkylinePacker::SkylinePacker(const unsigned int width, const unsigned int height)
+            : m_skyline{Segment{0, 0, width}}, m_width{width}, m_height{height} {
+    }
+
+    std::optional<Vector2U> SkylinePacker::insert(const unsigned int width, const unsigned int height) {
+        std::size_t best_index{m_skyline.size()};
+        unsigned int best_y{std::numeric_limits<unsigned int>::max()};
+        for(std::size_t i = 0; i < m_skyline.size(); ++i) {
+            const auto y = fit(i, width);
+            if(y.has_value() && y.value() + height <= m_height && y.value() < best_y) {
+                best_y = y.value();
+                best_index = i;
+            }
+        }
+        if(best_index == m_skyline.size()) {
+            return {};
+        }
+        const Segment placed{m_skyline[best_index].x, best_y + height, width};
+        m_skyline.insert(m_skyline.begin() + best_index, placed);
+        // Cut the segments now hidden under the new one.
+        const auto right = placed.x + placed.width;
+        auto i = best_index + 1;
+        while(i < m_skyline.size() && m_skyline[i].x < right) {
+            auto& segment = m_skyline[i];
+            const auto segment_right = segment.x + segment.width;
+            if(segment_right <= right) {
+                m_skyline.erase(m_skyline.begin() + i);
+                continue;
+            }
+            segment.width = segment_right - right;
+            segment.x = right;
+            break;
+        }
+        // Merge neighbours of equal height.
+        for(std::size_t j = 0; j + 1 < m_skyline.size();) {
+            if(m_skyline[j].y == m_skyline[j + 1].y) {
+                m_skyline[j].width += m_skyline[j + 1].width;
+                m_skyline.erase(m_skyline.begin() + j + 1);
+            } else {
+                ++j;
+            }
+        }
+        return Vector2U{placed.x, best_y};
+    }
+
+    std::optional<unsigned int> SkylinePacker::fit(const std::size_t index, const unsigned int width) const {
+        const auto x = m_skyline[index].x;
+        if(x + width > m_width) {
+            return {};
+        }
+        unsigned int y{0};
+        unsigned int remaining{width};
+        for(auto i = index; remaining > 0; ++i) {
+            if(i == m_skyline.size()) {
+                return {};
+            }
+            y = std::max(y, m_skyline[i].y);
+            remaining -= std::min(remaining, m_skyline[i].width);
+        }
+        return y;
+    }
+
+}
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <optional>
+#include <vector>
+
+#include <ogf/math/vector2.hxx>
+
+namespace ogf {
+
+    // Packs rectangles into a fixed-size area using the skyline bottom-left heuristic: the area is tracked as a list of
+    // horizontal segments and each rectangle is placed where its top edge ends up lowest.
+    class SkylinePacker {
+    public:
+        SkylinePacker(const unsigned int width, const unsigned int height);
+
+        // Find a place for the rectangle. Returns the position of its top-left corner, or nothing if it doesn't fit.
+        std::optional<Vector2U> insert(const unsigned int width, const unsigned int height);
+
+    private:
+        struct Segment {
+            unsigned int x{};
+            unsigned int y{};
+            unsigned int width{};
+        };
+
+        // Get the lowest y at which a rectangle of given width fits when starting at given segment.
+        std::optional<unsigned int> fit(const std::size_t index, const unsigned int width) const;
+
+        std::vector<Segment> m_skyline{};
+        unsigned int         m_width{};
+        unsigned int         m_height{};
+    };
+
+}
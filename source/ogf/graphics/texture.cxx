@@ -1,36 +1,245 @@
 #include <ogf/graphics/texture.hxx>
 
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+
 #include <glad/glad.h>
 
+#include <ogf/graphics/compressed_image.hxx>
+#include <ogf/graphics/gl_extensions.hxx>
+#include <ogf/graphics/gl_pixel_format.hxx>
 #include <ogf/graphics/image.hxx>
+#include <ogf/graphics/mipmaps.hxx>
+#include <ogf/graphics/sampler.hxx>
+#include <ogf/graphics/texture_container.hxx>
+#include <ogf/utils/mapped_file.hxx>
 
 namespace ogf {
 
+    namespace {
+
+        GLenum gl_compressed_format(const CompressionFormat format) {
+            GLenum internal_format{};
+            switch(format) {
+                case CompressionFormat::BC1: internal_format = GL_COMPRESSED_RGBA_S3TC_DXT1_EXT; break;
+                case CompressionFormat::BC3: internal_format = GL_COMPRESSED_RGBA_S3TC_DXT5_EXT; break;
+                case CompressionFormat::BC4: internal_format = GL_COMPRESSED_RED_RGTC1; break;
+                case CompressionFormat::BC5: internal_format = GL_COMPRESSED_RG_RGTC2; break;
+                case CompressionFormat::BC7: internal_format = GL_COMPRESSED_RGBA_BPTC_UNORM_ARB; break;
+            }
+            if(!is_compressed_format_supported(internal_format)) {
+                throw std::runtime_error{"Compressed texture format isn't supported by the OpenGL context."};
+            }
+            return internal_format;
+        }
+
+        // Create a texture with the default sampling. Without direct state access it's left bound, so its levels can be
+        // specified by the caller.
+        GLuint create_texture() {
+            GLuint texture{0};
+            const auto& gl = gl_extension_functions();
+            if(has_direct_state_access()) {
+                gl.create_textures(GL_TEXTURE_2D, 1, &texture);
+            } else {
+                glGenTextures(1, &texture);
+                glBindTexture(GL_TEXTURE_2D, texture);
+            }
+            constexpr std::pair<GLenum, GLint> parameters[]{
+                {GL_TEXTURE_WRAP_S, GL_REPEAT}, {GL_TEXTURE_WRAP_T, GL_REPEAT},
+                {GL_TEXTURE_MIN_FILTER, GL_NEAREST}, {GL_TEXTURE_MAG_FILTER, GL_NEAREST}
+            };
+            for(const auto& [name, value] : parameters) {
+                if(has_direct_state_access()) {
+                    gl.texture_parameteri(texture, name, value);
+                } else {
+                    glTexParameteri(GL_TEXTURE_2D, name, value);
+                }
+            }
+            return texture;
+        }
+
+        void set_max_level(const GLuint texture, const std::size_t level) {
+            if(has_direct_state_access()) {
+                gl_extension_functions().texture_parameteri(texture, GL_TEXTURE_MAX_LEVEL, static_cast<GLint>(level));
+            } else {
+                glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, static_cast<GLint>(level));
+            }
+        }
+
+        // Upload the pixels into a region of the level. Without direct state access the texture has to be bound.
+        void upload_image(const GLuint texture, const ImageView& image, const unsigned int x, const unsigned int y,
+                const unsigned int level) {
+            const auto format = gl_pixel_format(image.format);
+            const auto [width, height] = image.size();
+            // Rows are padded to their stride, which is always a whole number of pixels.
+            glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+            glPixelStorei(GL_UNPACK_ROW_LENGTH, static_cast<GLint>(image.stride / pixel_size(image.format)));
+            if(has_direct_state_access()) {
+                gl_extension_functions().texture_sub_image_2d(texture, static_cast<GLint>(level), static_cast<GLint>(x),
+                        static_cast<GLint>(y), static_cast<GLsizei>(width), static_cast<GLsizei>(height), format.format,
+                        format.type, image.pixels);
+            } else {
+                glTexSubImage2D(GL_TEXTURE_2D, static_cast<GLint>(level), static_cast<GLint>(x), static_cast<GLint>(y),
+                        static_cast<GLsizei>(width), static_cast<GLsizei>(height), format.format, format.type,
+                        image.pixels);
+            }
+            glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+            glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+        }
+
+    }
+
     Texture::~Texture() {
         free();
     }
 
+    void Texture::create(const unsigned int width, const unsigned int height, const unsigned int levels,
+            const PixelFormat format) {
+        const auto gl_format = gl_pixel_format(format);
+        const auto level_count = std::max(levels, 1u);
+        if(m_texture != 0) {
+            free();
+        }
+        m_texture = create_texture();
+        set_texture_swizzle(GL_TEXTURE_2D, m_texture, format);
+        if(has_direct_state_access()) {
+            // Immutable storage is allocated at once and never revalidated by the driver.
+            gl_extension_functions().texture_storage_2d(m_texture, static_cast<GLsizei>(level_count),
+                    static_cast<GLenum>(gl_format.internal_format), static_cast<GLsizei>(width),
+                    static_cast<GLsizei>(height));
+        } else {
+            for(unsigned int level = 0; level < level_count; ++level) {
+                glTexImage2D(GL_TEXTURE_2D, static_cast<GLint>(level), gl_format.internal_format,
+                        std::max(width >> level, 1u), std::max(height >> level, 1u), 0, gl_format.format,
+                        gl_format.type, nullptr);
+            }
+        }
+        set_max_level(m_texture, level_count - 1);
+        m_width = width;
+        m_height = height;
+    }
+
     void Texture::load_from_file(const std::string_view filename) {
+        if(has_texture_container_extension(filename)) {
+            load_container(filename);
+            return;
+        }
         Image image{};
         image.load_from_file(filename);
         load_from_image(image);
     }
 
-    void Texture::load_from_image(const Image& image) {
+    void Texture::load_from_image(const ImageView& image) {
+        load_from_image(image, generate_mipmaps(image));
+    }
+
+    void Texture::load_from_image(const ImageView& image, const std::vector<Image>& mipmaps) {
+        for(const auto& mipmap : mipmaps) {
+            if(mipmap.format() != image.format) {
+                throw std::runtime_error{"Failed to load texture: mipmaps differ in format from the image."};
+            }
+        }
+        create(image.width, image.height, static_cast<unsigned int>(mipmaps.size() + 1), image.format);
+        upload_image(m_texture, image, 0, 0, 0);
+        for(std::size_t level = 0; level < mipmaps.size(); ++level) {
+            upload_image(m_texture, mipmaps[level], 0, 0, static_cast<unsigned int>(level + 1));
+        }
+    }
+
+    void Texture::load_from_image(const CompressedImage& image) {
+        if(image.m_levels.empty()) {
+            throw std::runtime_error{"Failed to load texture: the compressed image is empty."};
+        }
+        const auto format = gl_compressed_format(image.format());
+        if(m_texture != 0) {
+            free();
+        }
+        const auto& gl = gl_extension_functions();
+        const auto& base = image.m_levels.front();
+        m_texture = create_texture();
+        if(has_direct_state_access()) {
+            gl.texture_storage_2d(m_texture, static_cast<GLsizei>(image.m_levels.size()), format,
+                    static_cast<GLsizei>(base.width), static_cast<GLsizei>(base.height));
+        }
+        for(std::size_t level = 0; level < image.m_levels.size(); ++level) {
+            const auto& data = image.m_levels[level];
+            if(has_direct_state_access()) {
+                gl.compressed_texture_sub_image_2d(m_texture, static_cast<GLint>(level), 0, 0,
+                        static_cast<GLsizei>(data.width), static_cast<GLsizei>(data.height), format,
+                        static_cast<GLsizei>(data.data.size()), data.data.data());
+            } else {
+                glCompressedTexImage2D(GL_TEXTURE_2D, static_cast<GLint>(level), format, data.width, data.height, 0,
+                        static_cast<GLsizei>(data.data.size()), data.data.data());
+            }
+        }
+        set_max_level(m_texture, image.m_levels.size() - 1);
+        m_width = base.width;
+        m_height = base.height;
+    }
+
+    void Texture::load_container(const std::string_view filename) {
+        MappedFile file{};
+        file.open(filename);
+        const auto container = parse_texture_container(file.data(), file.size(), filename);
+        if(container.compressed && !is_compressed_format_supported(container.internal_format)) {
+            throw std::runtime_error{"Failed to load texture \"" + std::string{filename}
+                    + "\": the compressed format isn't supported by the OpenGL context."};
+        }
         if(m_texture != 0) {
             free();
         }
-        glGenTextures(1, &m_texture);
+        const auto& gl = gl_extension_functions();
+        const auto& base = container.levels.front();
+        m_texture = create_texture();
+        if(has_direct_state_access()) {
+            gl.texture_storage_2d(m_texture, static_cast<GLsizei>(container.levels.size()), container.internal_format,
+                    static_cast<GLsizei>(base.width), static_cast<GLsizei>(base.height));
+        }
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+        // Levels go straight from the mapping to the driver, the pages are read in as GL copies them.
+        for(std::size_t i = 0; i < container.levels.size(); ++i) {
+            const auto& level = container.levels[i];
+            const auto data = file.data() + level.offset;
+            const auto index = static_cast<GLint>(i);
+            const auto width = static_cast<GLsizei>(level.width);
+            const auto height = static_cast<GLsizei>(level.height);
+            if(has_direct_state_access() && container.compressed) {
+                gl.compressed_texture_sub_image_2d(m_texture, index, 0, 0, width, height, container.internal_format,
+                        static_cast<GLsizei>(level.size), data);
+            } else if(has_direct_state_access()) {
+                gl.texture_sub_image_2d(m_texture, index, 0, 0, width, height, container.format, container.type,
+                        data);
+            } else if(container.compressed) {
+                glCompressedTexImage2D(GL_TEXTURE_2D, index, container.internal_format, width, height, 0,
+                        static_cast<GLsizei>(level.size), data);
+            } else {
+                glTexImage2D(GL_TEXTURE_2D, index, static_cast<GLint>(container.internal_format), width, height, 0,
+                        container.format, container.type, data);
+            }
+        }
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+        set_max_level(m_texture, container.levels.size() - 1);
+        m_width = base.width;
+        m_height = base.height;
+    }
+
+    void Texture::update(const ImageView& image, const unsigned int x, const unsigned int y, const unsigned int level) {
+        if(!has_direct_state_access()) {
+            glBindTexture(GL_TEXTURE_2D, m_texture);
+        }
+        upload_image(m_texture, image, x, y, level);
+    }
+
+    void Texture::bind(const unsigned int unit) const {
+        glActiveTexture(GL_TEXTURE0 + unit);
         glBindTexture(GL_TEXTURE_2D, m_texture);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
-        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, image.m_width, image.m_height, 0, GL_RGBA, GL_UNSIGNED_BYTE,
-                image.m_pixels.data());
-        glGenerateMipmap(GL_TEXTURE_2D);
-        m_width = image.m_width;
-        m_height = image.m_height;
+        glActiveTexture(GL_TEXTURE0);
+    }
+
+    void Texture::bind(const unsigned int unit, const Sampler& sampler) const {
+        bind(unit);
+        sampler.bind(unit);
     }
 
     void Texture::free() noexcept {
@@ -41,4 +250,8 @@ namespace ogf {
         m_texture = 0;
     }
 
+    unsigned int Texture::native_handle() const noexcept {
+        return m_texture;
+    }
+
 }
@@ -0,0 +1,135 @@
+#include <ogf/graphics/texture_array.hxx>
+
+#include <algorithm>
+#include <stdexcept>
+
+#include <glad/glad.h>
+
+#include <ogf/graphics/gl_extensions.hxx>
+#include <ogf/graphics/gl_pixel_format.hxx>
+#include <ogf/graphics/image.hxx>
+#include <ogf/graphics/mipmaps.hxx>
+#include <ogf/graphics/sampler.hxx>
+
+namespace ogf {
+
+    TextureArray::~TextureArray() {
+        free();
+    }
+
+    void TextureArray::create(const unsigned int width, const unsigned int height, const unsigned int layers,
+            const unsigned int levels, const PixelFormat format) {
+        GLint max_layers{0};
+        glGetIntegerv(GL_MAX_ARRAY_TEXTURE_LAYERS, &max_layers);
+        if(layers == 0 || layers > static_cast<unsigned int>(max_layers)) {
+            throw std::runtime_error{"Failed to create texture array: the layer count isn't supported."};
+        }
+        const auto gl_format = gl_pixel_format(format);
+        const auto level_count = std::max(levels, 1u);
+        if(m_texture != 0) {
+            free();
+        }
+        const auto& gl = gl_extension_functions();
+        if(has_direct_state_access()) {
+            gl.create_textures(GL_TEXTURE_2D_ARRAY, 1, &m_texture);
+            gl.texture_storage_3d(m_texture, static_cast<GLsizei>(level_count),
+                    static_cast<GLenum>(gl_format.internal_format), static_cast<GLsizei>(width),
+                    static_cast<GLsizei>(height), static_cast<GLsizei>(layers));
+            gl.texture_parameteri(m_texture, GL_TEXTURE_MAX_LEVEL, static_cast<GLint>(level_count - 1));
+            set_texture_swizzle(GL_TEXTURE_2D_ARRAY, m_texture, format);
+        } else {
+            glGenTextures(1, &m_texture);
+            glBindTexture(GL_TEXTURE_2D_ARRAY, m_texture);
+            for(unsigned int level = 0; level < level_count; ++level) {
+                glTexImage3D(GL_TEXTURE_2D_ARRAY, static_cast<GLint>(level), gl_format.internal_format,
+                        std::max(width >> level, 1u), std::max(height >> level, 1u), static_cast<GLsizei>(layers), 0,
+                        gl_format.format, gl_format.type, nullptr);
+            }
+            glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAX_LEVEL, static_cast<GLint>(level_count - 1));
+            set_texture_swizzle(GL_TEXTURE_2D_ARRAY, m_texture, format);
+        }
+        m_width = width;
+        m_height = height;
+        m_layers = layers;
+        m_levels = level_count;
+    }
+
+    void TextureArray::load_from_images(const std::vector<Image>& images) {
+        if(images.empty()) {
+            throw std::runtime_error{"Failed to load texture array: no images given."};
+        }
+        const auto& first = images.front();
+        for(const auto& image : images) {
+            if(image.size() != first.size() || image.format() != first.format()) {
+                throw std::runtime_error{"Failed to load texture array: images differ in size or format."};
+            }
+        }
+        const auto [width, height] = first.size();
+        unsigned int levels{1};
+        while((std::max(width, height) >> levels) > 0) {
+            ++levels;
+        }
+        create(width, height, static_cast<unsigned int>(images.size()), levels, first.format());
+        for(std::size_t layer = 0; layer < images.size(); ++layer) {
+            update(images[layer], static_cast<unsigned int>(layer));
+            const auto mipmaps = generate_mipmaps(images[layer]);
+            for(std::size_t level = 0; level < mipmaps.size(); ++level) {
+                update(mipmaps[level], static_cast<unsigned int>(layer), 0, 0, static_cast<unsigned int>(level + 1));
+            }
+        }
+    }
+
+    void TextureArray::update(const ImageView& image, const unsigned int layer, const unsigned int x,
+            const unsigned int y, const unsigned int level) {
+        if(layer >= m_layers || level >= m_levels) {
+            throw std::out_of_range{"Texture array layer or level is out of range."};
+        }
+        const auto format = gl_pixel_format(image.format);
+        const auto [width, height] = image.size();
+        // Rows are padded to their stride, which is always a whole number of pixels.
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+        glPixelStorei(GL_UNPACK_ROW_LENGTH, static_cast<GLint>(image.stride / pixel_size(image.format)));
+        if(has_direct_state_access()) {
+            gl_extension_functions().texture_sub_image_3d(m_texture, static_cast<GLint>(level), static_cast<GLint>(x),
+                    static_cast<GLint>(y), static_cast<GLint>(layer), static_cast<GLsizei>(width),
+                    static_cast<GLsizei>(height), 1, format.format, format.type, image.pixels);
+        } else {
+            glBindTexture(GL_TEXTURE_2D_ARRAY, m_texture);
+            glTexSubImage3D(GL_TEXTURE_2D_ARRAY, static_cast<GLint>(level), static_cast<GLint>(x),
+                    static_cast<GLint>(y), static_cast<GLint>(layer), static_cast<GLsizei>(width),
+                    static_cast<GLsizei>(height), 1, format.format, format.type, image.pixels);
+        }
+        glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+    }
+
+    void TextureArray::bind(const unsigned int unit) const {
+        glActiveTexture(GL_TEXTURE0 + unit);
+        glBindTexture(GL_TEXTURE_2D_ARRAY, m_texture);
+        glActiveTexture(GL_TEXTURE0);
+    }
+
+    void TextureArray::bind(const unsigned int unit, const Sampler& sampler) const {
+        bind(unit);
+        sampler.bind(unit);
+    }
+
+    void TextureArray::free() noexcept {
+        if(m_texture == 0) {
+            return;
+        }
+        glDeleteTextures(1, &m_texture);
+        m_texture = 0;
+        m_layers = 0;
+        m_levels = 0;
+    }
+
+    unsigned int TextureArray::layer_count() const noexcept {
+        return m_layers;
+    }
+
+    unsigned int TextureArray::native_handle() const noexcept {
+        return m_texture;
+    }
+
+}
@@ -0,0 +1,135 @@
+#include <ogf/graphics/texture_atlas.hxx>
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+#include <ogf/graphics/mipmaps.hxx>
+#include <ogf/graphics/skyline_packer.hxx>
+#include <ogf/graphics/texture.hxx>
+
+namespace ogf {
+
+    namespace {
+
+        unsigned int round_up(const unsigned int value, const unsigned int alignment) {
+            return (value + alignment - 1) / alignment * alignment;
+        }
+
+        // Copy the image into the middle of a bigger one, repeating the edge pixels over the border.
+        Image make_slot(const ImageView& image, const unsigned int padding, const unsigned int slot_width,
+                const unsigned int slot_height) {
+            const auto [width, height] = image.size();
+            Image slot{};
+            slot.create(slot_width, slot_height);
+            slot.blit(image, static_cast<int>(padding), static_cast<int>(padding));
+            const auto view = slot.view();
+            const auto last_x = static_cast<std::size_t>(padding + width - 1) * 4;
+            for(auto y = padding; y < padding + height; ++y) {
+                const auto row = view.row(y);
+                for(std::size_t x = 0; x < padding * 4u; x += 4) {
+                    std::memcpy(row + x, row + padding * 4u, 4);
+                }
+                for(auto x = last_x + 4; x < slot_width * 4u; x += 4) {
+                    std::memcpy(row + x, row + last_x, 4);
+                }
+            }
+            const auto row_bytes = static_cast<std::size_t>(slot_width) * 4;
+            for(unsigned int y = 0; y < padding; ++y) {
+                std::memcpy(view.row(y), view.row(padding), row_bytes);
+            }
+            for(auto y = padding + height; y < slot_height; ++y) {
+                std::memcpy(view.row(y), view.row(padding + height - 1), row_bytes);
+            }
+            return slot;
+        }
+
+    }
+
+    TextureAtlas::TextureAtlas(const unsigned int page_size, const unsigned int padding,
+            const unsigned int alignment)
+            : m_page_size{page_size}, m_padding{padding}, m_alignment{std::max(alignment, 1u)} {
+        if((m_alignment & (m_alignment - 1)) != 0 || page_size % m_alignment != 0) {
+            throw std::runtime_error{"Texture atlas alignment must be a power of two dividing the page size."};
+        }
+        while((1u << m_mipmap_levels) < m_alignment) {
+            ++m_mipmap_levels;
+        }
+    }
+
+    TextureAtlas::~TextureAtlas() = default;
+
+    std::size_t TextureAtlas::add(const ImageView& image) {
+        const auto [width, height] = image.size();
+        if(width == 0 || height == 0) {
+            throw std::runtime_error{"Failed to add image to texture atlas: the image is empty."};
+        }
+        const auto slot_width = round_up(width + 2 * m_padding, m_alignment);
+        const auto slot_height = round_up(height + 2 * m_padding, m_alignment);
+        if(slot_width > m_page_size || slot_height > m_page_size) {
+            throw std::runtime_error{"Failed to add image to texture atlas: the image is bigger than a page."};
+        }
+        // Packing in units of the alignment keeps every slot aligned.
+        std::optional<Vector2U> position{};
+        std::size_t page{0};
+        for(; page < m_packers.size() && !position.has_value(); ++page) {
+            position = m_packers[page]->insert(slot_width / m_alignment, slot_height / m_alignment);
+        }
+        if(position.has_value()) {
+            --page;
+        } else {
+            m_packers.push_back(std::make_unique<SkylinePacker>(m_page_size / m_alignment, m_page_size / m_alignment));
+            position = m_packers.back()->insert(slot_width / m_alignment, slot_height / m_alignment);
+        }
+        const auto x = position->x * m_alignment;
+        const auto y = position->y * m_alignment;
+        Upload& upload = m_uploads.emplace_back();
+        upload.page = page;
+        upload.x = x;
+        upload.y = y;
+        upload.slot = make_slot(image, m_padding, slot_width, slot_height);
+        upload.mipmaps = generate_mipmaps(upload.slot);
+        upload.mipmaps.resize(std::min<std::size_t>(upload.mipmaps.size(), m_mipmap_levels));
+        m_entries.push_back(Entry{page, RectU{x + m_padding, y + m_padding, width, height}});
+        return m_entries.size() - 1;
+    }
+
+    void TextureAtlas::update() {
+        while(m_textures.size() < m_packers.size()) {
+            auto& texture = m_textures.emplace_back(std::make_unique<Texture>());
+            texture->create(m_page_size, m_page_size, m_mipmap_levels + 1);
+        }
+        for(const auto& upload : m_uploads) {
+            auto& texture = *m_textures[upload.page];
+            texture.update(upload.slot, upload.x, upload.y);
+            for(std::size_t level = 0; level < upload.mipmaps.size(); ++level) {
+                texture.update(upload.mipmaps[level], upload.x >> (level + 1), upload.y >> (level + 1),
+                        static_cast<unsigned int>(level + 1));
+            }
+        }
+        m_uploads.clear();
+    }
+
+    std::size_t TextureAtlas::page(const std::size_t id) const {
+        return m_entries.at(id).page;
+    }
+
+    RectF TextureAtlas::uv_rect(const std::size_t id) const {
+        const auto& rect = m_entries.at(id).rect;
+        const auto size = static_cast<float>(m_page_size);
+        return RectF{rect.left / size, rect.top / size, rect.width / size, rect.height / size};
+    }
+
+    RectU TextureAtlas::pixel_rect(const std::size_t id) const {
+        return m_entries.at(id).rect;
+    }
+
+    std::size_t TextureAtlas::page_count() const noexcept {
+        return m_packers.size();
+    }
+
+    const Texture& TextureAtlas::texture(const std::size_t page) const {
+        return *m_textures.at(page);
+    }
+
+}
@@ -0,0 +1,291 @@
+#include <ogf/graphics/texture_container.hxx>
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <stdexcept>
+
+#include <glad/glad.h>
+
+#include <ogf/graphics/gl_extensions.hxx>
+#include <ogf/utils/io_utils.hxx>
+
+namespace ogf {
+
+    namespace {
+
+        constexpr std::array<Uint8, 4> DDS_MAGIC{'D', 'D', 'S', ' '};
+        constexpr std::array<Uint8, 12> KTX2_MAGIC{0xAB, 'K', 'T', 'X', ' ', '2', '0', 0xBB, '\r', '\n', 0x1A, '\n'};
+
+        constexpr std::size_t DDS_HEADER_SIZE = 128;          // Including the magic.
+        constexpr std::size_t DDS_DX10_HEADER_SIZE = 20;
+        constexpr std::size_t KTX2_HEADER_SIZE = 80;          // Up to the level index.
+        constexpr std::size_t KTX2_LEVEL_ENTRY_SIZE = 24;
+
+        constexpr Uint32 DDPF_ALPHAPIXELS = 0x1;
+        constexpr Uint32 DDPF_FOURCC = 0x4;
+        constexpr Uint32 DDPF_RGB = 0x40;
+        constexpr Uint32 DDPF_LUMINANCE = 0x20000;
+        constexpr Uint32 DDSCAPS2_CUBEMAP = 0x200;
+        constexpr Uint32 DDSCAPS2_VOLUME = 0x200000;
+
+        // Format of the texture: GL tokens and the size of a pixel, or of a 4x4 block if compressed.
+        struct Format {
+            unsigned int internal_format{};
+            unsigned int format{};
+            unsigned int type{};
+            unsigned int bytes{};
+            bool         compressed{};
+        };
+
+        Format compressed(const unsigned int internal_format, const unsigned int block_bytes) {
+            return Format{internal_format, 0, 0, block_bytes, true};
+        }
+
+        Format uncompressed(const unsigned int internal_format, const unsigned int format, const unsigned int type,
+                const unsigned int pixel_bytes) {
+            return Format{internal_format, format, type, pixel_bytes, false};
+        }
+
+        template<typename T>
+        T read(const Uint8* data, const std::size_t offset) {
+            T value{};
+            std::memcpy(&value, data + offset, sizeof(T));
+            return value;
+        }
+
+        constexpr Uint32 four_cc(const char a, const char b, const char c, const char d) {
+            return static_cast<Uint32>(a) | static_cast<Uint32>(b) << 8 | static_cast<Uint32>(c) << 16
+                    | static_cast<Uint32>(d) << 24;
+        }
+
+        std::runtime_error error(const std::string_view filename, const std::string_view reason) {
+            return std::runtime_error{"Failed to load texture \"" + std::string{filename} + "\": "
+                    + std::string{reason}};
+        }
+
+        std::size_t level_size(const Format& format, const unsigned int width, const unsigned int height) {
+            if(format.compressed) {
+                return static_cast<std::size_t>((width + 3) / 4) * ((height + 3) / 4) * format.bytes;
+            }
+            return static_cast<std::size_t>(width) * height * format.bytes;
+        }
+
+        // Levels of a full mipmap chain down to 1x1, more would only repeat the last one.
+        unsigned int max_level_count(const unsigned int width, const unsigned int height) {
+            unsigned int count{1};
+            for(auto size = std::max(width, height); size > 1; size /= 2) {
+                ++count;
+            }
+            return count;
+        }
+
+        Format dxgi_format(const Uint32 dxgi, const std::string_view filename) {
+            switch(dxgi) {
+                case 2:  return uncompressed(GL_RGBA32F, GL_RGBA, GL_FLOAT, 16);
+                case 10: return uncompressed(GL_RGBA16F, GL_RGBA, GL_HALF_FLOAT, 8);
+                case 28: return uncompressed(GL_RGBA8, GL_RGBA, GL_UNSIGNED_BYTE, 4);
+                case 29: return uncompressed(GL_SRGB8_ALPHA8, GL_RGBA, GL_UNSIGNED_BYTE, 4);
+                case 49: return uncompressed(GL_RG8, GL_RG, GL_UNSIGNED_BYTE, 2);
+                case 61: return uncompressed(GL_R8, GL_RED, GL_UNSIGNED_BYTE, 1);
+                case 87: return uncompressed(GL_RGBA8, GL_BGRA, GL_UNSIGNED_BYTE, 4);
+                case 71: return compressed(GL_COMPRESSED_RGBA_S3TC_DXT1_EXT, 8);
+                case 72: return compressed(GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT1_EXT, 8);
+                case 74: return compressed(GL_COMPRESSED_RGBA_S3TC_DXT3_EXT, 16);
+                case 75: return compressed(GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT3_EXT, 16);
+                case 77: return compressed(GL_COMPRESSED_RGBA_S3TC_DXT5_EXT, 16);
+                case 78: return compressed(GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT, 16);
+                case 80: return compressed(GL_COMPRESSED_RED_RGTC1, 8);
+                case 81: return compressed(GL_COMPRESSED_SIGNED_RED_RGTC1, 8);
+                case 83: return compressed(GL_COMPRESSED_RG_RGTC2, 16);
+                case 84: return compressed(GL_COMPRESSED_SIGNED_RG_RGTC2, 16);
+                case 95: return compressed(GL_COMPRESSED_RGB_BPTC_UNSIGNED_FLOAT_ARB, 16);
+                case 96: return compressed(GL_COMPRESSED_RGB_BPTC_SIGNED_FLOAT_ARB, 16);
+                case 98: return compressed(GL_COMPRESSED_RGBA_BPTC_UNORM_ARB, 16);
+                case 99: return compressed(GL_COMPRESSED_SRGB_ALPHA_BPTC_UNORM_ARB, 16);
+                default: throw error(filename, "unsupported DXGI format " + std::to_string(dxgi) + ".");
+            }
+        }
+
+        Format vulkan_format(const Uint32 vk_format, const std::string_view filename) {
+            switch(vk_format) {
+                case 9:   return uncompressed(GL_R8, GL_RED, GL_UNSIGNED_BYTE, 1);
+                case 16:  return uncompressed(GL_RG8, GL_RG, GL_UNSIGNED_BYTE, 2);
+                case 23:  return uncompressed(GL_RGB8, GL_RGB, GL_UNSIGNED_BYTE, 3);
+                case 29:  return uncompressed(GL_SRGB8, GL_RGB, GL_UNSIGNED_BYTE, 3);
+                case 37:  return uncompressed(GL_RGBA8, GL_RGBA, GL_UNSIGNED_BYTE, 4);
+                case 43:  return uncompressed(GL_SRGB8_ALPHA8, GL_RGBA, GL_UNSIGNED_BYTE, 4);
+                case 44:  return uncompressed(GL_RGBA8, GL_BGRA, GL_UNSIGNED_BYTE, 4);
+                case 97:  return uncompressed(GL_RGBA16F, GL_RGBA, GL_HALF_FLOAT, 8);
+                case 109: return uncompressed(GL_RGBA32F, GL_RGBA, GL_FLOAT, 16);
+                case 131: return compressed(GL_COMPRESSED_RGB_S3TC_DXT1_EXT, 8);
+                case 132: return compressed(GL_COMPRESSED_SRGB_S3TC_DXT1_EXT, 8);
+                case 133: return compressed(GL_COMPRESSED_RGBA_S3TC_DXT1_EXT, 8);
+                case 134: return compressed(GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT1_EXT, 8);
+                case 135: return compressed(GL_COMPRESSED_RGBA_S3TC_DXT3_EXT, 16);
+                case 136: return compressed(GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT3_EXT, 16);
+                case 137: return compressed(GL_COMPRESSED_RGBA_S3TC_DXT5_EXT, 16);
+                case 138: return compressed(GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT, 16);
+                case 139: return compressed(GL_COMPRESSED_RED_RGTC1, 8);
+                case 140: return compressed(GL_COMPRESSED_SIGNED_RED_RGTC1, 8);
+                case 141: return compressed(GL_COMPRESSED_RG_RGTC2, 16);
+                case 142: return compressed(GL_COMPRESSED_SIGNED_RG_RGTC2, 16);
+                case 143: return compressed(GL_COMPRESSED_RGB_BPTC_UNSIGNED_FLOAT_ARB, 16);
+                case 144: return compressed(GL_COMPRESSED_RGB_BPTC_SIGNED_FLOAT_ARB, 16);
+                case 145: return compressed(GL_COMPRESSED_RGBA_BPTC_UNORM_ARB, 16);
+                case 146: return compressed(GL_COMPRESSED_SRGB_ALPHA_BPTC_UNORM_ARB, 16);
+                default: throw error(filename, "unsupported Vulkan format " + std::to_string(vk_format) + ".");
+            }
+        }
+
+        Format dds_pixel_format(const Uint8* data, const std::string_view filename) {
+            const auto flags = read<Uint32>(data, 80);
+            if(flags & DDPF_FOURCC) {
+                switch(read<Uint32>(data, 84)) {
+                    case four_cc('D', 'X', 'T', '1'): return compressed(GL_COMPRESSED_RGBA_S3TC_DXT1_EXT, 8);
+                    case four_cc('D', 'X', 'T', '3'): return compressed(GL_COMPRESSED_RGBA_S3TC_DXT3_EXT, 16);
+                    case four_cc('D', 'X', 'T', '5'): return compressed(GL_COMPRESSED_RGBA_S3TC_DXT5_EXT, 16);
+                    case four_cc('A', 'T', 'I', '1'):
+                    case four_cc('B', 'C', '4', 'U'): return compressed(GL_COMPRESSED_RED_RGTC1, 8);
+                    case four_cc('B', 'C', '4', 'S'): return compressed(GL_COMPRESSED_SIGNED_RED_RGTC1, 8);
+                    case four_cc('A', 'T', 'I', '2'):
+                    case four_cc('B', 'C', '5', 'U'): return compressed(GL_COMPRESSED_RG_RGTC2, 16);
+                    case four_cc('B', 'C', '5', 'S'): return compressed(GL_COMPRESSED_SIGNED_RG_RGTC2, 16);
+                    case 113: return uncompressed(GL_RGBA16F, GL_RGBA, GL_HALF_FLOAT, 8);
+                    case 116: return uncompressed(GL_RGBA32F, GL_RGBA, GL_FLOAT, 16);
+                    default: throw error(filename, "unsupported DDS FourCC.");
+                }
+            }
+            const auto bit_count = read<Uint32>(data, 88);
+            const auto red_mask = read<Uint32>(data, 92);
+            if((flags & DDPF_RGB) && bit_count == 32 && (flags & DDPF_ALPHAPIXELS)) {
+                if(red_mask == 0x000000ff) {
+                    return uncompressed(GL_RGBA8, GL_RGBA, GL_UNSIGNED_BYTE, 4);
+                }
+                if(red_mask == 0x00ff0000) {
+                    return uncompressed(GL_RGBA8, GL_BGRA, GL_UNSIGNED_BYTE, 4);
+                }
+            }
+            if((flags & DDPF_LUMINANCE) && bit_count == 8) {
+                return uncompressed(GL_R8, GL_RED, GL_UNSIGNED_BYTE, 1);
+            }
+            throw error(filename, "unsupported DDS pixel format.");
+        }
+
+        TextureContainer make_container(const Format& format, unsigned int width, unsigned int height,
+                const unsigned int level_count, std::size_t offset) {
+            TextureContainer container{};
+            container.internal_format = format.internal_format;
+            container.format = format.format;
+            container.type = format.type;
+            container.compressed = format.compressed;
+            container.levels.resize(level_count);
+            for(auto& level : container.levels) {
+                level.offset = offset;
+                level.width = width;
+                level.height = height;
+                level.size = level_size(format, width, height);
+                offset += level.size;
+                width = std::max(width / 2, 1u);
+                height = std::max(height / 2, 1u);
+            }
+            return container;
+        }
+
+        TextureContainer parse_dds(const Uint8* data, const std::size_t size, const std::string_view filename) {
+            if(size < DDS_HEADER_SIZE || read<Uint32>(data, 4) != 124) {
+                throw error(filename, "truncated DDS header.");
+            }
+            const auto height = read<Uint32>(data, 12);
+            const auto width = read<Uint32>(data, 16);
+            const auto depth = read<Uint32>(data, 24);
+            const auto level_count = std::max(read<Uint32>(data, 28), 1u);
+            const auto caps2 = read<Uint32>(data, 112);
+            if((caps2 & (DDSCAPS2_CUBEMAP | DDSCAPS2_VOLUME)) || depth > 1) {
+                throw error(filename, "only 2D textures are supported.");
+            }
+            if(level_count > max_level_count(width, height)) {
+                throw error(filename, "more mipmap levels than the size allows.");
+            }
+            std::size_t offset{DDS_HEADER_SIZE};
+            Format format{};
+            if((read<Uint32>(data, 80) & DDPF_FOURCC) && read<Uint32>(data, 84) == four_cc('D', 'X', '1', '0')) {
+                if(size < DDS_HEADER_SIZE + DDS_DX10_HEADER_SIZE) {
+                    throw error(filename, "truncated DDS header.");
+                }
+                if(read<Uint32>(data, DDS_HEADER_SIZE + 12) > 1) {
+                    throw error(filename, "texture arrays are not supported.");
+                }
+                format = dxgi_format(read<Uint32>(data, DDS_HEADER_SIZE), filename);
+                offset += DDS_DX10_HEADER_SIZE;
+            } else {
+                format = dds_pixel_format(data, filename);
+            }
+            return make_container(format, width, height, level_count, offset);
+        }
+
+        TextureContainer parse_ktx2(const Uint8* data, const std::size_t size, const std::string_view filename) {
+            if(size < KTX2_HEADER_SIZE) {
+                throw error(filename, "truncated KTX2 header.");
+            }
+            const auto vk_format = read<Uint32>(data, 12);
+            const auto width = read<Uint32>(data, 20);
+            const auto height = read<Uint32>(data, 24);
+            const auto depth = read<Uint32>(data, 28);
+            const auto layer_count = read<Uint32>(data, 32);
+            const auto face_count = read<Uint32>(data, 36);
+            const auto level_count = std::max(read<Uint32>(data, 40), 1u);
+            const auto supercompression = read<Uint32>(data, 44);
+            if(supercompression != 0) {
+                throw error(filename, "supercompressed KTX2 files are not supported.");
+            }
+            if(height == 0 || depth != 0 || layer_count != 0 || face_count != 1) {
+                throw error(filename, "only 2D textures are supported.");
+            }
+            if(level_count > max_level_count(width, height)) {
+                throw error(filename, "more mipmap levels than the size allows.");
+            }
+            if(size < KTX2_HEADER_SIZE + level_count * KTX2_LEVEL_ENTRY_SIZE) {
+                throw error(filename, "truncated KTX2 level index.");
+            }
+            auto container = make_container(vulkan_format(vk_format, filename), width, height, level_count, 0);
+            // KTX2 stores levels from the smallest one, but the index tells where each one is.
+            for(std::size_t i = 0; i < level_count; ++i) {
+                const auto entry = KTX2_HEADER_SIZE + i * KTX2_LEVEL_ENTRY_SIZE;
+                auto& level = container.levels[i];
+                level.offset = static_cast<std::size_t>(read<Uint64>(data, entry));
+                if(read<Uint64>(data, entry + 8) < level.size) {
+                    throw error(filename, "level " + std::to_string(i) + " is too small.");
+                }
+            }
+            return container;
+        }
+
+    }
+
+    TextureContainer parse_texture_container(const Uint8* data, const std::size_t size,
+            const std::string_view filename) {
+        TextureContainer container{};
+        if(size >= DDS_MAGIC.size() && std::equal(DDS_MAGIC.begin(), DDS_MAGIC.end(), data)) {
+            container = parse_dds(data, size, filename);
+        } else if(size >= KTX2_MAGIC.size() && std::equal(KTX2_MAGIC.begin(), KTX2_MAGIC.end(), data)) {
+            container = parse_ktx2(data, size, filename);
+        } else {
+            throw error(filename, "not a DDS or KTX2 file.");
+        }
+        if(container.levels.front().width == 0 || container.levels.front().height == 0) {
+            throw error(filename, "the texture is empty.");
+        }
+        for(const auto& level : container.levels) {
+            if(level.offset > size || level.size > size - level.offset) {
+                throw error(filename, "the file is truncated.");
+            }
+        }
+        return container;
+    }
+
+    bool has_texture_container_extension(const std::string_view filename) {
+        return has_file_extension(filename, "dds") || has_file_extension(filename, "ktx2");
+    }
+
+}
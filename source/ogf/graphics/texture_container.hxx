@@ -0,0 +1,36 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include <ogf/types.hxx>
+
+namespace ogf {
+
+    // Layout of a 2D texture stored in a DDS or KTX2 file. Formats are given as OpenGL tokens, so levels can be
+    // uploaded straight from the file contents.
+    struct TextureContainer {
+        struct Level {
+            std::size_t  offset{};   // From the beginning of the file.
+            std::size_t  size{};
+            unsigned int width{};
+            unsigned int height{};
+        };
+
+        unsigned int       internal_format{};
+        unsigned int       format{};   // Pixel format and type are only used by uncompressed textures.
+        unsigned int       type{};
+        bool               compressed{};
+        std::vector<Level> levels{};   // From the biggest one.
+    };
+
+    // Parse file contents, detecting the container from its signature. Throws if the file is malformed or holds
+    // something else than a single 2D texture in a known format. Filename is only used in error messages.
+    TextureContainer parse_texture_container(const Uint8* data, const std::size_t size,
+            const std::string_view filename);
+
+    // Check if the filename has the extension of a DDS or KTX2 file, in any case.
+    bool has_texture_container_extension(const std::string_view filename);
+
+}
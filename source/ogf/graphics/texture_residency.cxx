@@ -0,0 +1,139 @@
+#include <ogf/graphics/texture_residency.hxx>
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+namespace ogf {
+
+    TextureResidency::TextureResidency(const std::size_t budget, const unsigned int initial_size)
+            : m_budget{budget}, m_initial_size{initial_size} {
+    }
+
+    TextureResidency::Handle TextureResidency::add(std::vector<Level> levels) {
+        Texture texture{};
+        texture.levels = std::move(levels);
+        texture.resident_level = static_cast<unsigned int>(texture.levels.size() - 1);
+        while(texture.resident_level > 0 && texture.levels[texture.resident_level - 1].size <= m_initial_size) {
+            --texture.resident_level;
+        }
+        texture.wanted_level = texture.resident_level;
+        texture.last_used_frame = m_frame;
+        m_usage += levels_bytes(texture, texture.resident_level, static_cast<unsigned int>(texture.levels.size()));
+        m_textures.push_back(std::move(texture));
+        return m_textures.size() - 1;
+    }
+
+    void TextureResidency::report_usage(const Handle handle, const float screen_size) {
+        auto& texture = m_textures.at(handle);
+        const auto texture_size = static_cast<float>(texture.levels.front().size);
+        const auto last_level = static_cast<int>(texture.levels.size() - 1);
+        // Level whose size matches the screen size best, rounded towards more detail.
+        const auto level = screen_size > 0.0f ? static_cast<int>(std::floor(std::log2(texture_size / screen_size)))
+                : last_level;
+        const auto wanted_level = static_cast<unsigned int>(std::clamp(level, 0, last_level));
+        // Several reports in one frame keep the most detailed level.
+        if(texture.last_used_frame != m_frame) {
+            texture.wanted_level = wanted_level;
+        } else {
+            texture.wanted_level = std::min(texture.wanted_level, wanted_level);
+        }
+        texture.last_used_frame = m_frame;
+    }
+
+    std::vector<TextureResidency::Eviction> TextureResidency::evict() {
+        std::vector<Eviction> evictions{};
+        // First drop levels nobody needs anymore, then the most detailed levels of the least recently used textures.
+        for(Handle handle = 0; handle < m_textures.size() && m_usage > m_budget; ++handle) {
+            const auto& texture = m_textures[handle];
+            while(!texture.loading && texture.resident_level < texture.wanted_level && m_usage > m_budget) {
+                evictions.push_back(drop_level(handle));
+            }
+        }
+        while(m_usage > m_budget) {
+            auto victim = m_textures.size();
+            for(Handle handle = 0; handle < m_textures.size(); ++handle) {
+                const auto& texture = m_textures[handle];
+                const auto last_level = static_cast<unsigned int>(texture.levels.size() - 1);
+                if(texture.loading || texture.resident_level >= last_level || texture.last_used_frame == m_frame) {
+                    continue;
+                }
+                if(victim == m_textures.size() || texture.last_used_frame < m_textures[victim].last_used_frame) {
+                    victim = handle;
+                }
+            }
+            if(victim == m_textures.size()) {
+                // Everything left is in use this frame.
+                break;
+            }
+            evictions.push_back(drop_level(victim));
+        }
+        return evictions;
+    }
+
+    std::vector<TextureResidency::Request> TextureResidency::request() {
+        std::vector<Request> requests{};
+        for(Handle handle = 0; handle < m_textures.size(); ++handle) {
+            auto& texture = m_textures[handle];
+            // Textures not seen this frame keep what they have, their levels would be the first ones evicted.
+            if(texture.loading || texture.last_used_frame != m_frame
+                    || texture.wanted_level >= texture.resident_level) {
+                continue;
+            }
+            // Levels still being read count as taken, so reads started in earlier frames can't overfill the budget.
+            auto first_level = texture.resident_level;
+            while(first_level > texture.wanted_level && m_usage + m_reserved
+                    + levels_bytes(texture, first_level - 1, texture.resident_level) <= m_budget) {
+                --first_level;
+            }
+            if(first_level == texture.resident_level) {
+                continue;
+            }
+            m_reserved += levels_bytes(texture, first_level, texture.resident_level);
+            texture.loading = true;
+            requests.push_back(Request{handle, first_level, texture.resident_level});
+        }
+        return requests;
+    }
+
+    void TextureResidency::loaded(const Handle handle, const unsigned int first_level) {
+        auto& texture = m_textures.at(handle);
+        const auto bytes = levels_bytes(texture, first_level, texture.resident_level);
+        m_usage += bytes;
+        m_reserved -= bytes;
+        texture.resident_level = first_level;
+        texture.loading = false;
+    }
+
+    void TextureResidency::next_frame() noexcept {
+        ++m_frame;
+    }
+
+    unsigned int TextureResidency::resident_level(const Handle handle) const {
+        return m_textures.at(handle).resident_level;
+    }
+
+    unsigned int TextureResidency::wanted_level(const Handle handle) const {
+        return m_textures.at(handle).wanted_level;
+    }
+
+    std::size_t TextureResidency::usage() const noexcept {
+        return m_usage;
+    }
+
+    TextureResidency::Eviction TextureResidency::drop_level(const Handle handle) {
+        auto& texture = m_textures[handle];
+        m_usage -= texture.levels[texture.resident_level].bytes;
+        return Eviction{handle, texture.resident_level++};
+    }
+
+    std::size_t TextureResidency::levels_bytes(const Texture& texture, const unsigned int first,
+            const unsigned int last) const {
+        std::size_t bytes{0};
+        for(auto level = first; level < last; ++level) {
+            bytes += texture.levels[level].bytes;
+        }
+        return bytes;
+    }
+
+}
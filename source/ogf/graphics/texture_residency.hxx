@@ -0,0 +1,85 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include <ogf/types.hxx>
+
+namespace ogf {
+
+    // Decides which mipmap levels of streamed textures belong in video memory, without touching OpenGL. Levels
+    // [resident_level .. last] of each texture are resident. The level wanted for a texture follows from how big it
+    // appears on screen. When resident levels take more memory than the budget, levels nobody wants are dropped first,
+    // then the most detailed levels of the least recently used textures.
+    class TextureResidency {
+    public:
+        using Handle = std::size_t;
+
+        struct Level {
+            unsigned int size{};    // Longer side in pixels.
+            std::size_t  bytes{};
+        };
+
+        // Level to release. The texture's base level becomes the next one.
+        struct Eviction {
+            Handle       handle{};
+            unsigned int level{};
+        };
+
+        // Levels to read, from first_level up to the resident one.
+        struct Request {
+            Handle       handle{};
+            unsigned int first_level{};
+            unsigned int resident_level{};
+        };
+
+        // Textures start with levels up to initial_size pixels on their longer side.
+        TextureResidency(const std::size_t budget, const unsigned int initial_size);
+
+        // Add a texture with given levels, the most detailed first. Its initial levels count as resident.
+        Handle add(std::vector<Level> levels);
+
+        // Report that the texture covers roughly screen_size pixels on its longer side in the current frame.
+        void report_usage(const Handle handle, const float screen_size);
+
+        // Drop levels until they fit into the budget. Textures used in the current frame keep their wanted levels.
+        std::vector<Eviction> evict();
+
+        // Pick wanted levels of textures used in the current frame which fit into the budget, from the smallest ones.
+        // Textures stay loading, and aren't evicted or requested again, until loaded() is called.
+        std::vector<Request> request();
+
+        // Record that a requested read from first_level up was uploaded.
+        void loaded(const Handle handle, const unsigned int first_level);
+
+        void next_frame() noexcept;
+
+        unsigned int resident_level(const Handle handle) const;
+        unsigned int wanted_level(const Handle handle) const;
+
+        // Bytes taken by all resident levels.
+        std::size_t usage() const noexcept;
+
+    private:
+        struct Texture {
+            std::vector<Level> levels{};
+            unsigned int       resident_level{};
+            unsigned int       wanted_level{};
+            Uint64             last_used_frame{0};
+            bool               loading{false};
+        };
+
+        // Drop the most detailed resident level of a texture.
+        Eviction drop_level(const Handle handle);
+
+        std::size_t levels_bytes(const Texture& texture, const unsigned int first, const unsigned int last) const;
+
+        std::vector<Texture> m_textures{};
+        std::size_t          m_budget{};
+        std::size_t          m_usage{0};
+        std::size_t          m_reserved{0};   // Bytes of requested levels which aren't loaded yet.
+        unsigned int         m_initial_size{};
+        Uint64               m_frame{0};
+    };
+
+}
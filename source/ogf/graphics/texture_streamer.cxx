@@ -0,0 +1,204 @@
+#include <ogf/graphics/texture_streamer.hxx>
+
+#include <algorithm>
+#include <condition_variable>
+#include <mutex>
+#include <stdexcept>
+#include <vector>
+
+#include <glad/glad.h>
+
+#include <ogf/graphics/gl_extensions.hxx>
+#include <ogf/graphics/texture_container.hxx>
+#include <ogf/graphics/texture_residency.hxx>
+#include <ogf/utils/mapped_file.hxx>
+#include <ogf/utils/thread_pool.hxx>
+
+namespace ogf {
+
+    struct TextureStreamer::Impl {
+        struct Entry {
+            MappedFile       file{};
+            TextureContainer container{};
+            unsigned int     texture{0};
+        };
+
+        // Levels read by a worker, from first_level to the previously resident one.
+        struct Read {
+            Handle                          handle{};
+            unsigned int                    first_level{};
+            std::vector<std::vector<Uint8>> levels{};
+        };
+
+        Impl(const std::size_t budget, const unsigned int initial_size);
+
+        void upload_level(Entry& entry, const unsigned int level, const Uint8* data);
+        void release_level(Entry& entry, const unsigned int level);
+        void evict();
+        void request();
+
+        std::vector<Entry>      entries{};
+        TextureResidency        residency;
+        std::vector<Read>       finished{};
+        std::size_t             running{0};
+        std::mutex              mutex{};
+        std::condition_variable condition{};
+    };
+
+    TextureStreamer::Impl::Impl(const std::size_t budget, const unsigned int initial_size)
+            : residency{budget, initial_size} {
+    }
+
+    void TextureStreamer::Impl::upload_level(Entry& entry, const unsigned int level, const Uint8* data) {
+        const auto& info = entry.container.levels[level];
+        if(entry.container.compressed) {
+            glCompressedTexImage2D(GL_TEXTURE_2D, static_cast<GLint>(level), entry.container.internal_format,
+                    info.width, info.height, 0, static_cast<GLsizei>(info.size), data);
+        } else {
+            glTexImage2D(GL_TEXTURE_2D, static_cast<GLint>(level), static_cast<GLint>(entry.container.internal_format),
+                    info.width, info.height, 0, entry.container.format, entry.container.type, data);
+        }
+    }
+
+    void TextureStreamer::Impl::release_level(Entry& entry, const unsigned int level) {
+        // Respecifying a level as empty makes the driver free its storage. Levels below the base one don't take part
+        // in texture completeness, so the texture stays usable.
+        if(entry.container.compressed) {
+            glCompressedTexImage2D(GL_TEXTURE_2D, static_cast<GLint>(level), entry.container.internal_format, 0, 0, 0,
+                    0, nullptr);
+        } else {
+            glTexImage2D(GL_TEXTURE_2D, static_cast<GLint>(level), static_cast<GLint>(entry.container.internal_format),
+                    0, 0, 0, entry.container.format, entry.container.type, nullptr);
+        }
+    }
+
+    void TextureStreamer::Impl::evict() {
+        for(const auto& eviction : residency.evict()) {
+            auto& entry = entries[eviction.handle];
+            glBindTexture(GL_TEXTURE_2D, entry.texture);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_BASE_LEVEL, static_cast<GLint>(eviction.level + 1));
+            release_level(entry, eviction.level);
+        }
+    }
+
+    void TextureStreamer::Impl::request() {
+        for(const auto& request : residency.request()) {
+            const auto& entry = entries[request.handle];
+            struct Range {
+                const Uint8* data{};
+                std::size_t  size{};
+            };
+            std::vector<Range> ranges{};
+            for(auto level = request.first_level; level < request.resident_level; ++level) {
+                const auto& info = entry.container.levels[level];
+                ranges.push_back(Range{entry.file.data() + info.offset, info.size});
+            }
+            {
+                std::lock_guard<std::mutex> mutex_lock{mutex};
+                ++running;
+            }
+            // Copying out of the mapping is what actually reads the file, so it's done by the worker.
+            default_thread_pool().submit([this, handle = request.handle, first_level = request.first_level,
+                    ranges = std::move(ranges)]() {
+                Read read{};
+                read.handle = handle;
+                read.first_level = first_level;
+                for(const auto& range : ranges) {
+                    read.levels.emplace_back(range.data, range.data + range.size);
+                }
+                std::lock_guard<std::mutex> mutex_lock{mutex};
+                finished.push_back(std::move(read));
+                --running;
+                condition.notify_all();
+            });
+        }
+    }
+
+    TextureStreamer::TextureStreamer(const std::size_t memory_budget, const unsigned int initial_size) {
+        m_impl = std::make_unique<Impl>(memory_budget, initial_size);
+    }
+
+    TextureStreamer::~TextureStreamer() {
+        {
+            std::unique_lock<std::mutex> mutex_lock{m_impl->mutex};
+            m_impl->condition.wait(mutex_lock, [this]() { return m_impl->running == 0; });
+        }
+        for(auto& entry : m_impl->entries) {
+            glDeleteTextures(1, &entry.texture);
+        }
+    }
+
+    TextureStreamer::Handle TextureStreamer::add(const std::string_view filename) {
+        Impl::Entry entry{};
+        entry.file.open(filename);
+        entry.container = parse_texture_container(entry.file.data(), entry.file.size(), filename);
+        if(entry.container.compressed && !is_compressed_format_supported(entry.container.internal_format)) {
+            throw std::runtime_error{"Failed to load texture \"" + std::string{filename}
+                    + "\": the compressed format isn't supported by the OpenGL context."};
+        }
+        std::vector<TextureResidency::Level> levels{};
+        for(const auto& level : entry.container.levels) {
+            levels.push_back(TextureResidency::Level{std::max(level.width, level.height), level.size});
+        }
+        const auto last_level = static_cast<unsigned int>(levels.size() - 1);
+        const auto handle = m_impl->residency.add(std::move(levels));
+        const auto resident_level = m_impl->residency.resident_level(handle);
+
+        glGenTextures(1, &entry.texture);
+        glBindTexture(GL_TEXTURE_2D, entry.texture);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_BASE_LEVEL, static_cast<GLint>(resident_level));
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, static_cast<GLint>(last_level));
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+        for(auto level = resident_level; level <= last_level; ++level) {
+            m_impl->upload_level(entry, level, entry.file.data() + entry.container.levels[level].offset);
+        }
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+        m_impl->entries.push_back(std::move(entry));
+        return handle;
+    }
+
+    void TextureStreamer::report_usage(const Handle handle, const float screen_size) {
+        m_impl->residency.report_usage(handle, screen_size);
+    }
+
+    void TextureStreamer::update() {
+        std::vector<Impl::Read> finished{};
+        {
+            std::lock_guard<std::mutex> mutex_lock{m_impl->mutex};
+            finished.swap(m_impl->finished);
+        }
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+        for(const auto& read : finished) {
+            auto& entry = m_impl->entries[read.handle];
+            glBindTexture(GL_TEXTURE_2D, entry.texture);
+            // Upload from the smallest level, so the texture stays complete after every step.
+            for(auto i = read.levels.size(); i > 0; --i) {
+                m_impl->upload_level(entry, read.first_level + static_cast<unsigned int>(i - 1),
+                        read.levels[i - 1].data());
+            }
+            m_impl->residency.loaded(read.handle, read.first_level);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_BASE_LEVEL, static_cast<GLint>(read.first_level));
+        }
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+        m_impl->evict();
+        m_impl->request();
+        m_impl->residency.next_frame();
+    }
+
+    unsigned int TextureStreamer::resident_level(const Handle handle) const {
+        return m_impl->residency.resident_level(handle);
+    }
+
+    std::size_t TextureStreamer::memory_usage() const noexcept {
+        return m_impl->residency.usage();
+    }
+
+    unsigned int TextureStreamer::native_handle(const Handle handle) const {
+        return m_impl->entries.at(handle).texture;
+    }
+
+}
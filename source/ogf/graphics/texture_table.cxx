@@ -0,0 +1,154 @@
+#include <ogf/graphics/texture_table.hxx>
+
+#include <algorithm>
+#include <deque>
+#include <stdexcept>
+#include <tuple>
+#include <vector>
+
+#include <glad/glad.h>
+
+#include <ogf/graphics/gl_extensions.hxx>
+#include <ogf/graphics/image.hxx>
+#include <ogf/graphics/mipmaps.hxx>
+#include <ogf/graphics/shader.hxx>
+#include <ogf/graphics/texture.hxx>
+#include <ogf/graphics/texture_array.hxx>
+
+namespace ogf {
+
+    namespace {
+
+        // Handles are 64-bit, std140 layout packs two of them into every uvec4. The array size is MAX_SIZE / 2.
+        const char* const BINDLESS_GLSL_SOURCE = R"glsl(
+#extension GL_ARB_bindless_texture : require
+
+layout(std140) uniform OgfTextureTable {
+    uvec4 ogf_texture_handles[512];
+};
+
+vec4 ogf_texture_table_sample(uint index, vec2 uv) {
+    uvec4 pair = ogf_texture_handles[index >> 1u];
+    return texture(sampler2D((index & 1u) == 0u ? pair.xy : pair.zw), uv);
+}
+)glsl";
+
+        const char* const ARRAY_GLSL_SOURCE = R"glsl(
+uniform sampler2DArray ogf_texture_table;
+
+vec4 ogf_texture_table_sample(uint index, vec2 uv) {
+    return texture(ogf_texture_table, vec3(uv, float(index)));
+}
+)glsl";
+
+    }
+
+    struct TextureTable::Impl {
+        unsigned int          width{};
+        unsigned int          height{};
+        unsigned int          capacity{};
+        PixelFormat           format{};
+        SamplerDescriptor     sampler{};   // Shared samplers go away with Sampler::clear_cache(), so it's looked up.
+        unsigned int          size{0};
+
+        // Bindless path.
+        bool                  bindless{false};
+        std::deque<Texture>   textures{};
+        std::vector<GLuint64> handles{};
+        GLuint                buffer{0};
+
+        // Fallback path.
+        TextureArray          array{};
+    };
+
+    TextureTable::TextureTable(const unsigned int width, const unsigned int height, const unsigned int capacity,
+            const PixelFormat format, const SamplerDescriptor& sampler) {
+        if(width == 0 || height == 0 || capacity == 0 || capacity > MAX_SIZE) {
+            throw std::runtime_error{"Failed to create texture table: the size or capacity isn't supported."};
+        }
+        m_impl = std::make_unique<Impl>();
+        auto& impl = *m_impl;
+        impl.width = width;
+        impl.height = height;
+        impl.capacity = capacity;
+        impl.format = format;
+        impl.bindless = has_bindless_textures();
+        impl.sampler = sampler;
+        if(impl.bindless) {
+            glGenBuffers(1, &impl.buffer);
+            glBindBuffer(GL_UNIFORM_BUFFER, impl.buffer);
+            glBufferData(GL_UNIFORM_BUFFER, MAX_SIZE * sizeof(GLuint64), nullptr, GL_DYNAMIC_DRAW);
+            glBindBuffer(GL_UNIFORM_BUFFER, 0);
+        } else {
+            unsigned int levels{1};
+            while((std::max(width, height) >> levels) > 0) {
+                ++levels;
+            }
+            impl.array.create(width, height, capacity, levels, format);
+        }
+    }
+
+    TextureTable::~TextureTable() {
+        const auto& gl = gl_extension_functions();
+        for(const auto handle : m_impl->handles) {
+            gl.make_texture_handle_non_resident(handle);
+        }
+        glDeleteBuffers(1, &m_impl->buffer);
+    }
+
+    unsigned int TextureTable::add(const ImageView& image) {
+        auto& impl = *m_impl;
+        if(impl.size == impl.capacity) {
+            throw std::runtime_error{"Failed to add texture: the texture table is full."};
+        }
+        if(image.size() != std::make_tuple(impl.width, impl.height) || image.format != impl.format) {
+            throw std::runtime_error{"Failed to add texture: the image differs in size or format from the table."};
+        }
+        const auto index = impl.size;
+        if(impl.bindless) {
+            const auto& gl = gl_extension_functions();
+            auto& texture = impl.textures.emplace_back();
+            texture.load_from_image(image);
+            const auto sampler = Sampler::get(impl.sampler).native_handle();
+            const auto handle = gl.get_texture_sampler_handle(texture.native_handle(), sampler);
+            gl.make_texture_handle_resident(handle);
+            impl.handles.push_back(handle);
+            glBindBuffer(GL_UNIFORM_BUFFER, impl.buffer);
+            glBufferSubData(GL_UNIFORM_BUFFER, static_cast<GLintptr>(index * sizeof(GLuint64)), sizeof(GLuint64),
+                    &handle);
+            glBindBuffer(GL_UNIFORM_BUFFER, 0);
+        } else {
+            impl.array.update(image, index);
+            const auto mipmaps = generate_mipmaps(image);
+            for(std::size_t level = 0; level < mipmaps.size(); ++level) {
+                impl.array.update(mipmaps[level], index, 0, 0, static_cast<unsigned int>(level + 1));
+            }
+        }
+        ++impl.size;
+        return index;
+    }
+
+    const char* TextureTable::glsl_source() const noexcept {
+        return m_impl->bindless ? BINDLESS_GLSL_SOURCE : ARRAY_GLSL_SOURCE;
+    }
+
+    void TextureTable::bind(Shader& shader, const unsigned int binding) const {
+        const auto& impl = *m_impl;
+        if(impl.bindless) {
+            shader.bind_uniform_block("OgfTextureTable", binding);
+            glBindBufferBase(GL_UNIFORM_BUFFER, binding, impl.buffer);
+        } else {
+            impl.array.bind(binding, Sampler::get(impl.sampler));
+            shader.set_uniform("ogf_texture_table", static_cast<int>(binding));
+        }
+    }
+
+    bool TextureTable::is_bindless() const noexcept {
+        return m_impl->bindless;
+    }
+
+    unsigned int TextureTable::size() const noexcept {
+        return m_impl->size;
+    }
+
+}
@@ -0,0 +1,236 @@
+#include <ogf/graphics/texture_uploader.hxx>
+
+#include <algorithm>
+#include <cstring>
+#include <deque>
+#include <iterator>
+#include <stdexcept>
+
+#include <glad/glad.h>
+
+#include <ogf/graphics/gl_extensions.hxx>
+#include <ogf/graphics/gl_pixel_format.hxx>
+#include <ogf/graphics/image.hxx>
+#include <ogf/graphics/texture.hxx>
+
+namespace ogf {
+
+    namespace {
+
+        // Bands start at this alignment in the staging buffer, which keeps the driver on its fast copy path.
+        constexpr std::size_t BAND_ALIGNMENT = 64;
+
+        std::size_t align(const std::size_t value) {
+            return (value + BAND_ALIGNMENT - 1) / BAND_ALIGNMENT * BAND_ALIGNMENT;
+        }
+
+    }
+
+    struct TextureUploader::Impl {
+        // Image queued for upload, levels go one after another, each from the top row down.
+        struct Upload {
+            GLuint             texture{0};
+            std::vector<Image> levels{};
+            unsigned int       level{0};
+            unsigned int       row{0};
+        };
+
+        // Staging memory used by one frame. It's free again once the fence is signaled.
+        struct Frame {
+            GLsync      fence{nullptr};
+            std::size_t end{};
+            std::size_t bytes{};
+        };
+
+        bool allocate(const std::size_t bytes, std::size_t& offset);
+        void retire();
+
+        GLuint              buffer{0};
+        Uint8*              mapping{nullptr};   // Persistent mapping, null when bands are mapped one by one.
+        std::size_t         size{};
+        std::size_t         frame_budget{};
+        std::size_t         head{0};            // Where the next band goes.
+        std::size_t         tail{0};            // Start of the oldest band the GPU may still read.
+        std::size_t         used{0};            // Bytes between tail and head, including space skipped when wrapping.
+        std::deque<Frame>   frames{};
+        std::deque<Upload>  queue{};
+        std::size_t         pending{0};
+    };
+
+    bool TextureUploader::Impl::allocate(const std::size_t bytes, std::size_t& offset) {
+        const auto aligned = align(bytes);
+        if(used == 0) {
+            head = 0;
+            tail = 0;
+        }
+        if(head >= tail && used < size) {
+            if(size - head >= aligned) {
+                offset = head;
+            } else if(tail >= aligned) {
+                // The band can't be split, so the rest of the buffer is skipped.
+                used += size - head;
+                offset = 0;
+            } else {
+                return false;
+            }
+        } else if(head < tail && tail - head >= aligned) {
+            offset = head;
+        } else {
+            return false;
+        }
+        head = offset + aligned;
+        used += aligned;
+        return true;
+    }
+
+    void TextureUploader::Impl::retire() {
+        while(!frames.empty()) {
+            const auto& frame = frames.front();
+            if(glClientWaitSync(frame.fence, 0, 0) == GL_TIMEOUT_EXPIRED) {
+                break;
+            }
+            glDeleteSync(frame.fence);
+            used -= frame.bytes;
+            tail = frame.end;
+            frames.pop_front();
+        }
+    }
+
+    TextureUploader::TextureUploader(const std::size_t staging_size, const std::size_t frame_budget) {
+        m_impl = std::make_unique<Impl>();
+        m_impl->size = align(std::max(staging_size, BAND_ALIGNMENT));
+        m_impl->frame_budget = frame_budget;
+        glGenBuffers(1, &m_impl->buffer);
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, m_impl->buffer);
+        const auto buffer_storage = gl_extension_functions().buffer_storage;
+        if(buffer_storage != nullptr) {
+            constexpr GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+            const auto size = static_cast<GLsizeiptr>(m_impl->size);
+            buffer_storage(GL_PIXEL_UNPACK_BUFFER, size, nullptr, flags);
+            m_impl->mapping = static_cast<Uint8*>(glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, size, flags));
+        } else {
+            glBufferData(GL_PIXEL_UNPACK_BUFFER, static_cast<GLsizeiptr>(m_impl->size), nullptr, GL_STREAM_DRAW);
+        }
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+        if(buffer_storage != nullptr && m_impl->mapping == nullptr) {
+            glDeleteBuffers(1, &m_impl->buffer);
+            throw std::runtime_error{"Failed to map texture staging buffer."};
+        }
+    }
+
+    TextureUploader::~TextureUploader() {
+        for(const auto& frame : m_impl->frames) {
+            glClientWaitSync(frame.fence, GL_SYNC_FLUSH_COMMANDS_BIT, GL_TIMEOUT_IGNORED);
+            glDeleteSync(frame.fence);
+        }
+        if(m_impl->mapping != nullptr) {
+            glBindBuffer(GL_PIXEL_UNPACK_BUFFER, m_impl->buffer);
+            glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+            glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+        }
+        glDeleteBuffers(1, &m_impl->buffer);
+    }
+
+    void TextureUploader::upload(Texture& texture, Image image, std::vector<Image> mipmaps) {
+        const auto [width, height] = image.size();
+        if(width == 0 || height == 0) {
+            throw std::runtime_error{"Failed to queue texture upload: the image is empty."};
+        }
+        for(const auto& mipmap : mipmaps) {
+            if(mipmap.format() != image.format()) {
+                throw std::runtime_error{"Failed to queue texture upload: mipmaps differ in format from the image."};
+            }
+        }
+        if(image.stride() > m_impl->size) {
+            throw std::runtime_error{"Failed to queue texture upload: a row doesn't fit into the staging buffer."};
+        }
+        texture.create(width, height, static_cast<unsigned int>(mipmaps.size() + 1), image.format());
+        Impl::Upload upload{};
+        upload.texture = texture.native_handle();
+        upload.levels.reserve(mipmaps.size() + 1);
+        upload.levels.push_back(std::move(image));
+        std::move(mipmaps.begin(), mipmaps.end(), std::back_inserter(upload.levels));
+        for(const auto& level : upload.levels) {
+            m_impl->pending += level.stride() * std::get<1>(level.size());
+        }
+        m_impl->queue.push_back(std::move(upload));
+    }
+
+    void TextureUploader::update() {
+        m_impl->retire();
+        if(m_impl->queue.empty()) {
+            return;
+        }
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, m_impl->buffer);
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+        const auto used_before = m_impl->used;
+        std::size_t uploaded{0};
+        while(!m_impl->queue.empty()) {
+            auto& upload = m_impl->queue.front();
+            const auto& level = upload.levels[upload.level];
+            const auto [width, height] = level.size();
+            const auto stride = level.stride();
+            const auto row_bytes = static_cast<std::size_t>(width) * pixel_size(level.format());
+            // At least one row goes every frame, so rows bigger than the budget still make progress.
+            const auto budget = m_impl->frame_budget > uploaded ? m_impl->frame_budget - uploaded : 0;
+            auto rows = std::min<std::size_t>(height - upload.row, std::max<std::size_t>(budget / stride,
+                    uploaded == 0 ? 1 : 0));
+            std::size_t offset{};
+            while(rows > 0 && !m_impl->allocate((rows - 1) * stride + row_bytes, offset)) {
+                rows /= 2;
+            }
+            if(rows == 0) {
+                break;
+            }
+            const auto bytes = (rows - 1) * stride + row_bytes;
+            const auto source = level.pixels() + upload.row * stride;
+            if(m_impl->mapping != nullptr) {
+                std::memcpy(m_impl->mapping + offset, source, bytes);
+            } else {
+                // Fences already keep the band from being in use, so the driver doesn't need to synchronize.
+                constexpr GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT
+                        | GL_MAP_UNSYNCHRONIZED_BIT;
+                const auto target = glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, static_cast<GLintptr>(offset),
+                        static_cast<GLsizeiptr>(bytes), flags);
+                if(target != nullptr) {
+                    std::memcpy(target, source, bytes);
+                }
+                glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+            }
+            const auto format = gl_pixel_format(level.format());
+            glPixelStorei(GL_UNPACK_ROW_LENGTH, static_cast<GLint>(stride / pixel_size(level.format())));
+            if(has_direct_state_access()) {
+                gl_extension_functions().texture_sub_image_2d(upload.texture, static_cast<GLint>(upload.level), 0,
+                        static_cast<GLint>(upload.row), static_cast<GLsizei>(width), static_cast<GLsizei>(rows),
+                        format.format, format.type, reinterpret_cast<const void*>(offset));
+            } else {
+                glBindTexture(GL_TEXTURE_2D, upload.texture);
+                glTexSubImage2D(GL_TEXTURE_2D, static_cast<GLint>(upload.level), 0, static_cast<GLint>(upload.row),
+                        static_cast<GLsizei>(width), static_cast<GLsizei>(rows), format.format, format.type,
+                        reinterpret_cast<const void*>(offset));
+            }
+            uploaded += rows * stride;
+            m_impl->pending -= rows * stride;
+            upload.row += static_cast<unsigned int>(rows);
+            if(upload.row == height) {
+                upload.row = 0;
+                ++upload.level;
+                if(upload.level == upload.levels.size()) {
+                    m_impl->queue.pop_front();
+                }
+            }
+        }
+        glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+        if(m_impl->used != used_before) {
+            const auto fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+            m_impl->frames.push_back(Impl::Frame{fence, m_impl->head, m_impl->used - used_before});
+        }
+    }
+
+    std::size_t TextureUploader::pending_bytes() const noexcept {
+        return m_impl->pending;
+    }
+
+}
@@ -0,0 +1,253 @@
+#include <ogf/graphics/tiled_image.hxx>
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <fstream>
+#include <list>
+#include <mutex>
+#include <stdexcept>
+#include <unordered_map>
+#include <vector>
+
+#include <ogf/graphics/image_decoder.hxx>
+#include <ogf/types.hxx>
+#include <ogf/utils/mapped_file.hxx>
+
+namespace ogf {
+
+    namespace {
+
+        // The header is followed by rows of tiles from the top, each tile stored row by row without padding.
+        constexpr std::array<char, 8> CACHE_MAGIC{'O', 'G', 'F', 'T', 'I', '0', '0', '1'};
+        constexpr std::size_t HEADER_SIZE = 24;
+
+        template<typename T>
+        void write_value(std::ofstream& file, const T value) {
+            file.write(reinterpret_cast<const char*>(&value), sizeof(value));
+        }
+
+        Uint32 read_u32(const Uint8* data) {
+            Uint32 value{};
+            std::memcpy(&value, data, sizeof(value));
+            return value;
+        }
+
+    }
+
+    struct TiledImage::Impl {
+        struct Tile {
+            std::shared_ptr<const Image> image{};
+            std::list<Uint64>::iterator  position{};
+            std::size_t                  bytes{};
+        };
+
+        // Size of the tile, cut to the image.
+        std::tuple<unsigned int, unsigned int> tile_extent(const unsigned int tile_x, const unsigned int tile_y) const;
+
+        // Drop the least recently used tiles except the most recent one until the tiles fit into the budget. Must be
+        // called with the mutex locked.
+        void evict();
+
+        MappedFile   file{};
+        unsigned int width{};
+        unsigned int height{};
+        unsigned int tile_size{};
+        unsigned int tiles_x{};
+        unsigned int tiles_y{};
+        PixelFormat  format{PixelFormat::RGBA8};
+        std::size_t  budget{};
+        std::size_t  usage{};
+        std::list<Uint64>                order{};   // Keys of the tiles in memory, most recently used first.
+        std::unordered_map<Uint64, Tile> tiles{};
+        mutable std::mutex               mutex{};
+    };
+
+    std::tuple<unsigned int, unsigned int> TiledImage::Impl::tile_extent(const unsigned int tile_x,
+            const unsigned int tile_y) const {
+        return std::make_tuple(std::min(tile_size, width - tile_x * tile_size),
+                std::min(tile_size, height - tile_y * tile_size));
+    }
+
+    void TiledImage::Impl::evict() {
+        while(usage > budget && order.size() > 1) {
+            const auto tile = tiles.find(order.back());
+            usage -= tile->second.bytes;
+            tiles.erase(tile);
+            order.pop_back();
+        }
+    }
+
+    void TiledImage::build_tile_cache(const std::string_view image_filename, const std::string_view cache_filename,
+            const unsigned int tile_size) {
+        if(tile_size == 0) {
+            throw std::runtime_error{"Failed to build tile cache \"" + std::string{cache_filename}
+                    + "\": the tile size is zero."};
+        }
+        ImageRowDecoder decoder{};
+        decoder.open(image_filename);
+        const auto width = decoder.width();
+        const auto height = decoder.height();
+        const auto format = decoder.format();
+        std::ofstream file{std::string{cache_filename}, std::ios::binary};
+        if(!file.good()) {
+            throw std::runtime_error{"Failed to open tile cache \"" + std::string{cache_filename} + "\" for writing."};
+        }
+        file.write(CACHE_MAGIC.data(), CACHE_MAGIC.size());
+        write_value(file, static_cast<Uint32>(width));
+        write_value(file, static_cast<Uint32>(height));
+        write_value(file, static_cast<Uint32>(format));
+        write_value(file, static_cast<Uint32>(tile_size));
+        // A band of whole rows as tall as a tile is decoded at once, then split into tiles.
+        const auto bytes_per_pixel = pixel_size(format);
+        const auto row_bytes = static_cast<std::size_t>(width) * bytes_per_pixel;
+        std::vector<Uint8> band(row_bytes * std::min(tile_size, height));
+        const auto tiles_x = (width + tile_size - 1) / tile_size;
+        const auto tiles_y = (height + tile_size - 1) / tile_size;
+        for(unsigned int tile_y = 0; tile_y < tiles_y; ++tile_y) {
+            const auto rows = std::min(tile_size, height - tile_y * tile_size);
+            decoder.read_rows(band.data(), row_bytes, rows);
+            for(unsigned int tile_x = 0; tile_x < tiles_x; ++tile_x) {
+                const auto first = band.data() + static_cast<std::size_t>(tile_x) * tile_size * bytes_per_pixel;
+                const auto tile_bytes = std::min(tile_size, width - tile_x * tile_size) * bytes_per_pixel;
+                for(unsigned int row = 0; row < rows; ++row) {
+                    file.write(reinterpret_cast<const char*>(first + row * row_bytes), tile_bytes);
+                }
+            }
+        }
+        if(!file.good()) {
+            throw std::runtime_error{"Failed to write tile cache \"" + std::string{cache_filename} + "\"."};
+        }
+    }
+
+    TiledImage::TiledImage(const std::size_t memory_budget) {
+        m_impl = std::make_unique<Impl>();
+        m_impl->budget = memory_budget;
+    }
+
+    TiledImage::~TiledImage() = default;
+
+    void TiledImage::open(const std::string_view cache_filename) {
+        auto& impl = *m_impl;
+        std::lock_guard<std::mutex> mutex_lock{impl.mutex};
+        impl.tiles.clear();
+        impl.order.clear();
+        impl.usage = 0;
+        impl.file.open(cache_filename);
+        const auto data = impl.file.data();
+        const auto corrupted = [&]() {
+            impl.file.close();
+            return std::runtime_error{"Tile cache \"" + std::string{cache_filename} + "\" is corrupted."};
+        };
+        if(impl.file.size() < HEADER_SIZE || std::memcmp(data, CACHE_MAGIC.data(), CACHE_MAGIC.size()) != 0) {
+            throw corrupted();
+        }
+        const auto width = read_u32(data + 8);
+        const auto height = read_u32(data + 12);
+        const auto format = read_u32(data + 16);
+        const auto tile_size = read_u32(data + 20);
+        if(format > static_cast<Uint32>(PixelFormat::RGBA32F) || tile_size == 0 || impl.file.size() - HEADER_SIZE
+                != static_cast<std::size_t>(width) * height * pixel_size(static_cast<PixelFormat>(format))) {
+            throw corrupted();
+        }
+        impl.width = width;
+        impl.height = height;
+        impl.format = static_cast<PixelFormat>(format);
+        impl.tile_size = tile_size;
+        impl.tiles_x = (width + tile_size - 1) / tile_size;
+        impl.tiles_y = (height + tile_size - 1) / tile_size;
+    }
+
+    std::shared_ptr<const Image> TiledImage::tile(const unsigned int tile_x, const unsigned int tile_y) {
+        auto& impl = *m_impl;
+        if(tile_x >= impl.tiles_x || tile_y >= impl.tiles_y) {
+            throw std::out_of_range{"Tile is outside of the image."};
+        }
+        const auto key = Uint64{tile_y} << 32 | tile_x;
+        {
+            std::lock_guard<std::mutex> mutex_lock{impl.mutex};
+            if(const auto tile = impl.tiles.find(key); tile != impl.tiles.end()) {
+                impl.order.splice(impl.order.begin(), impl.order, tile->second.position);
+                return tile->second.image;
+            }
+        }
+        // Other threads may read tiles meanwhile, reading from the file can take long.
+        const auto [width, height] = impl.tile_extent(tile_x, tile_y);
+        const auto bytes_per_pixel = pixel_size(impl.format);
+        const auto offset = HEADER_SIZE + (static_cast<std::size_t>(tile_y) * impl.tile_size * impl.width
+                + static_cast<std::size_t>(tile_x) * impl.tile_size * height) * bytes_per_pixel;
+        auto image = std::make_shared<Image>();
+        image->create(ImageView{impl.file.data() + offset, width, height, width * bytes_per_pixel, impl.format});
+        std::lock_guard<std::mutex> mutex_lock{impl.mutex};
+        auto [tile, inserted] = impl.tiles.try_emplace(key);
+        if(inserted) {
+            impl.order.push_front(key);
+            tile->second.image = std::move(image);
+            tile->second.position = impl.order.begin();
+            tile->second.bytes = tile->second.image->stride() * height;
+            impl.usage += tile->second.bytes;
+        } else {
+            impl.order.splice(impl.order.begin(), impl.order, tile->second.position);
+        }
+        auto result = tile->second.image;
+        impl.evict();
+        return result;
+    }
+
+    Image TiledImage::read(const RectU& area) {
+        const auto& impl = *m_impl;
+        if(area.left > impl.width || area.width > impl.width - area.left || area.top > impl.height
+                || area.height > impl.height - area.top) {
+            throw std::out_of_range{"Area is outside of the image."};
+        }
+        Image image{};
+        image.create(area.width, area.height, Color::BLACK, impl.format);
+        if(area.width == 0 || area.height == 0) {
+            return image;
+        }
+        const auto size = impl.tile_size;
+        for(auto tile_y = area.top / size; tile_y <= (area.top + area.height - 1) / size; ++tile_y) {
+            for(auto tile_x = area.left / size; tile_x <= (area.left + area.width - 1) / size; ++tile_x) {
+                const auto source = tile(tile_x, tile_y);
+                // Part of the area covered by the tile.
+                const auto left = std::max(area.left, tile_x * size);
+                const auto top = std::max(area.top, tile_y * size);
+                const auto right = std::min(area.left + area.width, (tile_x + 1) * size);
+                const auto bottom = std::min(area.top + area.height, (tile_y + 1) * size);
+                image.blit(source->view(RectU{left - tile_x * size, top - tile_y * size, right - left, bottom - top}),
+                        static_cast<int>(left - area.left), static_cast<int>(top - area.top));
+            }
+        }
+        return image;
+    }
+
+    Color TiledImage::pixel(const unsigned int x, const unsigned int y) {
+        if(x >= m_impl->width || y >= m_impl->height) {
+            throw std::out_of_range{"Pixel is outside of the image."};
+        }
+        const auto size = m_impl->tile_size;
+        return tile(x / size, y / size)->pixel(x % size, y % size);
+    }
+
+    std::tuple<unsigned int, unsigned int> TiledImage::size() const noexcept {
+        return std::make_tuple(m_impl->width, m_impl->height);
+    }
+
+    std::tuple<unsigned int, unsigned int> TiledImage::tile_count() const noexcept {
+        return std::make_tuple(m_impl->tiles_x, m_impl->tiles_y);
+    }
+
+    unsigned int TiledImage::tile_size() const noexcept {
+        return m_impl->tile_size;
+    }
+
+    PixelFormat TiledImage::format() const noexcept {
+        return m_impl->format;
+    }
+
+    std::size_t TiledImage::memory_usage() const {
+        std::lock_guard<std::mutex> mutex_lock{m_impl->mutex};
+        return m_impl->usage;
+    }
+
+}
@@ -0,0 +1,790 @@
+#include <ogf/graphics/virtual_texture.hxx>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <condition_variable>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <iterator>
+#include <mutex>
+#include <stdexcept>
+#include <vector>
+
+#include <glad/glad.h>
+
+#include <ogf/graphics/image.hxx>
+#include <ogf/graphics/pixel_conversion.hxx>
+#include <ogf/graphics/shader.hxx>
+#include <ogf/graphics/tiled_image.hxx>
+#include <ogf/utils/mapped_file.hxx>
+#include <ogf/utils/thread_pool.hxx>
+
+namespace ogf {
+
+    namespace {
+
+        constexpr std::array<char, 8> STORE_MAGIC{'O', 'G', 'F', 'V', 'T', '0', '0', '1'};
+
+        // Magic followed by width, height, tile size, border, level count and tile counts on level 0.
+        constexpr std::size_t STORE_HEADER_SIZE = STORE_MAGIC.size() + 7 * sizeof(Uint32);
+
+        // Page coordinates are written into the feedback buffer with 12 bits each.
+        constexpr unsigned int MAX_TILES = 4096;
+
+        // Readbacks in flight. The feedback lags this many frames behind at most.
+        constexpr std::size_t FEEDBACK_BUFFERS = 3;
+
+        // Tile reads in flight on the thread pool.
+        constexpr std::size_t MAX_READS = 32;
+
+        constexpr Uint32 TILE_MISSING = 0xFFFFFFFF;
+        constexpr Uint32 TILE_LOADING = 0xFFFFFFFE;
+
+        unsigned int next_power_of_two(const unsigned int value) {
+            unsigned int result{1};
+            while(result < value) {
+                result *= 2;
+            }
+            return result;
+        }
+
+        unsigned int floor_log2(unsigned int value) {
+            unsigned int result{0};
+            while(value > 1) {
+                value /= 2;
+                ++result;
+            }
+            return result;
+        }
+
+        template<typename T>
+        void write_value(std::ofstream& file, const T value) {
+            file.write(reinterpret_cast<const char*>(&value), sizeof(value));
+        }
+
+        Uint32 read_u32(const Uint8* data) {
+            Uint32 value{};
+            std::memcpy(&value, data, sizeof(value));
+            return value;
+        }
+
+        // Writes the tiles of one level of a tile store as its rows come in, from the top. Only the rows of the band of
+        // tiles being filled and their borders are kept. Pairs of rows are averaged into rows of the next level in
+        // linear light with premultiplied alpha, so transparent pixels don't bleed into their neighbours.
+        class LevelBuilder {
+        public:
+            LevelBuilder(std::ofstream& file, const std::streamoff offset, const unsigned int width,
+                    const unsigned int height, const unsigned int tile_size, const unsigned int border,
+                    LevelBuilder* next)
+                    : m_file{file}, m_offset{offset}, m_width{width}, m_height{height}, m_tile_size{tile_size},
+                    m_border{border}, m_capacity{tile_size + 2 * border}, m_next{next} {
+                const auto padded = static_cast<std::size_t>(tile_size + 2 * border);
+                m_rows.resize(m_capacity * static_cast<std::size_t>(width) * 4);
+                m_tile.resize(padded * padded * 4);
+                if(m_next != nullptr) {
+                    m_pairs.resize(static_cast<std::size_t>(width / 2) * 4);
+                    m_linear.resize(m_pairs.size());
+                    m_encoded.resize(m_pairs.size());
+                }
+            }
+
+            // Add the next row as RGBA8 pixels and linear premultiplied RGBA floats.
+            void push(const Uint8* pixels, const float* linear) {
+                std::memcpy(row(m_row), pixels, static_cast<std::size_t>(m_width) * 4);
+                if(m_next != nullptr) {
+                    downsample(linear);
+                }
+                // A band is complete once the last row of its bottom border is in.
+                while(m_band * m_tile_size < m_height
+                        && m_row == std::min((m_band + 1) * m_tile_size + m_border - 1, m_height - 1)) {
+                    write_band();
+                    ++m_band;
+                }
+                ++m_row;
+            }
+
+        private:
+            Uint8* row(const unsigned int y) {
+                return m_rows.data() + static_cast<std::size_t>(y % m_capacity) * m_width * 4;
+            }
+
+            void downsample(const float* linear) {
+                const auto width = m_width / 2;
+                for(std::size_t i = 0; i < static_cast<std::size_t>(width) * 4; ++i) {
+                    const auto sum = linear[i / 4 * 8 + i % 4] + linear[i / 4 * 8 + 4 + i % 4];
+                    m_pairs[i] = m_row % 2 == 0 ? sum : (m_pairs[i] + sum) * 0.25f;
+                }
+                if(m_row % 2 == 0) {
+                    return;
+                }
+                for(std::size_t i = 0; i < m_linear.size(); i += 4) {
+                    const auto alpha = m_pairs[i + 3];
+                    const auto scale = alpha > 0.0f ? 1.0f / alpha : 0.0f;
+                    m_linear[i] = m_pairs[i] * scale;
+                    m_linear[i + 1] = m_pairs[i + 1] * scale;
+                    m_linear[i + 2] = m_pairs[i + 2] * scale;
+                    m_linear[i + 3] = alpha;
+                }
+                encode_srgb_pixels(m_linear.data(), m_encoded.data(), PixelFormat::RGBA8, width);
+                m_next->push(m_encoded.data(), m_pairs.data());
+            }
+
+            // Copy the tiles of the current band with their borders, clamping coordinates at the level edges.
+            void write_band() {
+                const auto padded = m_tile_size + 2 * m_border;
+                const auto tiles_x = m_width / m_tile_size;
+                for(unsigned int tile_x = 0; tile_x < tiles_x; ++tile_x) {
+                    auto* out = m_tile.data();
+                    for(unsigned int tile_row = 0; tile_row < padded; ++tile_row) {
+                        const auto y = std::clamp(static_cast<int>(m_band * m_tile_size + tile_row)
+                                - static_cast<int>(m_border), 0, static_cast<int>(m_height) - 1);
+                        const auto* source = row(static_cast<unsigned int>(y));
+                        for(unsigned int column = 0; column < padded; ++column) {
+                            const auto x = std::clamp(static_cast<int>(tile_x * m_tile_size + column)
+                                    - static_cast<int>(m_border), 0, static_cast<int>(m_width) - 1);
+                            std::memcpy(out, source + static_cast<std::size_t>(x) * 4, 4);
+                            out += 4;
+                        }
+                    }
+                    const auto index = static_cast<std::streamoff>(m_band) * tiles_x + tile_x;
+                    m_file.seekp(m_offset + index * static_cast<std::streamoff>(m_tile.size()));
+                    m_file.write(reinterpret_cast<const char*>(m_tile.data()),
+                            static_cast<std::streamsize>(m_tile.size()));
+                }
+            }
+
+            std::ofstream&     m_file;
+            std::streamoff     m_offset;
+            unsigned int       m_width;
+            unsigned int       m_height;
+            unsigned int       m_tile_size;
+            unsigned int       m_border;
+            unsigned int       m_capacity;     // Rows kept, each in slot y % m_capacity.
+            LevelBuilder*      m_next;
+            std::vector<Uint8> m_rows{};
+            std::vector<Uint8> m_tile{};
+            std::vector<float> m_pairs{};      // Sums of pixel pairs of an even row, then the averaged row.
+            std::vector<float> m_linear{};
+            std::vector<Uint8> m_encoded{};
+            unsigned int       m_row{0};
+            unsigned int       m_band{0};
+        };
+
+        // Build a tile store from an image read in bands of rows.
+        void build_store(const unsigned int width, const unsigned int height, const std::string_view filename,
+                const unsigned int tile_size, const unsigned int border, const unsigned int band_height,
+                const std::function<ImageView(const unsigned int first, const unsigned int count)>& read_rows) {
+            if(width == 0 || height == 0 || tile_size == 0) {
+                throw std::runtime_error{"Failed to build tile store \"" + std::string{filename} + "\": empty image."};
+            }
+            // Tile counts are padded to powers of two, so every level splits into exactly half as many tiles.
+            const auto tiles_x = next_power_of_two((width + tile_size - 1) / tile_size);
+            const auto tiles_y = next_power_of_two((height + tile_size - 1) / tile_size);
+            if(tiles_x > MAX_TILES || tiles_y > MAX_TILES) {
+                throw std::runtime_error{"Failed to build tile store \"" + std::string{filename}
+                        + "\": the image is too big for given tile size."};
+            }
+            const auto level_count = std::min(floor_log2(tiles_x), floor_log2(tiles_y)) + 1;
+
+            std::ofstream file{std::string{filename}, std::ios::binary};
+            if(!file.good()) {
+                throw std::runtime_error{"Failed to open tile store \"" + std::string{filename} + "\" for writing."};
+            }
+            file.write(STORE_MAGIC.data(), STORE_MAGIC.size());
+            write_value(file, static_cast<Uint32>(width));
+            write_value(file, static_cast<Uint32>(height));
+            write_value(file, static_cast<Uint32>(tile_size));
+            write_value(file, static_cast<Uint32>(border));
+            write_value(file, static_cast<Uint32>(level_count));
+            write_value(file, static_cast<Uint32>(tiles_x));
+            write_value(file, static_cast<Uint32>(tiles_y));
+
+            // Levels are written side by side as the rows pass through them, each into its own part of the file.
+            const auto tile_bytes = static_cast<std::streamoff>(tile_size + 2 * border) * (tile_size + 2 * border) * 4;
+            std::vector<std::streamoff> offsets{static_cast<std::streamoff>(STORE_HEADER_SIZE)};
+            for(unsigned int level = 1; level < level_count; ++level) {
+                offsets.push_back(offsets.back()
+                        + static_cast<std::streamoff>(tiles_x >> (level - 1)) * (tiles_y >> (level - 1)) * tile_bytes);
+            }
+            std::vector<LevelBuilder> levels{};
+            levels.reserve(level_count);
+            for(auto level = level_count; level-- > 0;) {
+                levels.emplace_back(file, offsets[level], (tiles_x >> level) * tile_size,
+                        (tiles_y >> level) * tile_size, tile_size, border, levels.empty() ? nullptr : &levels.back());
+            }
+            auto& first_level = levels.back();
+
+            // The padding repeats the edge pixels, so filtering near the edges isn't darkened.
+            const auto padded_width = tiles_x * tile_size;
+            const auto padded_height = tiles_y * tile_size;
+            std::vector<Uint8> pixels(static_cast<std::size_t>(padded_width) * 4);
+            std::vector<float> linear(pixels.size());
+            const auto push = [&]() {
+                first_level.push(pixels.data(), linear.data());
+            };
+            for(unsigned int first = 0; first < height; first += band_height) {
+                const auto rows = read_rows(first, std::min(band_height, height - first));
+                for(unsigned int y = 0; y < rows.height; ++y) {
+                    convert_pixels(rows.row(y), rows.format, pixels.data(), PixelFormat::RGBA8, width);
+                    for(auto x = width; x < padded_width; ++x) {
+                        std::memcpy(pixels.data() + static_cast<std::size_t>(x) * 4, pixels.data() + (width - 1) * 4,
+                                4);
+                    }
+                    decode_srgb_pixels(pixels.data(), PixelFormat::RGBA8, linear.data(), padded_width);
+                    for(std::size_t i = 0; i < linear.size(); i += 4) {
+                        linear[i] *= linear[i + 3];
+                        linear[i + 1] *= linear[i + 3];
+                        linear[i + 2] *= linear[i + 3];
+                    }
+                    push();
+                }
+            }
+            for(auto y = height; y < padded_height; ++y) {
+                push();
+            }
+            if(!file.good()) {
+                throw std::runtime_error{"Failed to write tile store \"" + std::string{filename} + "\"."};
+            }
+        }
+
+    }
+
+    const char* const VirtualTexture::GLSL_SOURCE = R"glsl(
+uniform sampler2D ogf_vt_indirection;
+uniform sampler2D ogf_vt_cache;
+uniform vec4 ogf_vt_size;      // xy: tiles on level 0, zw: part of the tiles covered by the texture
+uniform vec4 ogf_vt_tile;      // x: tile size, y: border, z: cache texture size, w: last level
+uniform float ogf_vt_feedback_bias;
+
+float ogf_vt_level(vec2 uv, float bias) {
+    vec2 texel = uv * ogf_vt_size.xy * ogf_vt_tile.x;
+    vec2 dx = dFdx(texel);
+    vec2 dy = dFdy(texel);
+    return clamp(0.5 * log2(max(dot(dx, dx), dot(dy, dy))) + bias, 0.0, ogf_vt_tile.w);
+}
+
+vec2 ogf_vt_tiles(float level) {
+    return max(floor(ogf_vt_size.xy / exp2(level)), 1.0);
+}
+
+vec4 ogf_vt_sample(vec2 uv) {
+    uv = clamp(uv, 0.0, 1.0) * ogf_vt_size.zw;
+    float level = floor(ogf_vt_level(uv, 0.0));
+    vec2 tiles = ogf_vt_tiles(level);
+    vec4 entry = floor(texelFetch(ogf_vt_indirection, ivec2(min(uv * tiles, tiles - 1.0)), int(level)) * 255.0 + 0.5);
+    // The entry points to the tile itself or to the closest coarser one in the cache.
+    vec2 resident_tiles = ogf_vt_tiles(entry.z);
+    vec2 in_tile = uv * resident_tiles - min(floor(uv * resident_tiles), resident_tiles - 1.0);
+    vec2 texel = entry.xy * (ogf_vt_tile.x + 2.0 * ogf_vt_tile.y) + ogf_vt_tile.y + in_tile * ogf_vt_tile.x;
+    return textureLod(ogf_vt_cache, texel / ogf_vt_tile.z, 0.0);
+}
+
+vec4 ogf_vt_feedback(vec2 uv) {
+    uv = clamp(uv, 0.0, 1.0) * ogf_vt_size.zw;
+    float level = floor(ogf_vt_level(uv, ogf_vt_feedback_bias));
+    vec2 tiles = ogf_vt_tiles(level);
+    vec2 page = min(floor(uv * tiles), tiles - 1.0);
+    vec2 high = floor(page / 256.0);
+    return vec4(page - high * 256.0, high.x + high.y * 16.0, level) / 255.0;
+}
+)glsl";
+
+    struct VirtualTextureFeedback::Impl {
+        unsigned int                              width{};
+        unsigned int                              height{};
+        unsigned int                              framebuffer{0};
+        unsigned int                              color{0};
+        unsigned int                              depth{0};
+        std::array<unsigned int, FEEDBACK_BUFFERS> buffers{};
+        std::array<GLsync, FEEDBACK_BUFFERS>       fences{};
+        std::size_t                               oldest{0};
+        std::size_t                               pending{0};
+        std::vector<Uint8>                        pixels{};
+        GLint                                     previous_framebuffer{0};
+        std::array<GLint, 4>                      previous_viewport{};
+    };
+
+    VirtualTextureFeedback::VirtualTextureFeedback(const unsigned int width, const unsigned int height) {
+        m_impl = std::make_unique<Impl>();
+        m_impl->width = width;
+        m_impl->height = height;
+        m_impl->pixels.resize(static_cast<std::size_t>(width) * height * 4);
+
+        glGenTextures(1, &m_impl->color);
+        glBindTexture(GL_TEXTURE_2D, m_impl->color);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+        glGenRenderbuffers(1, &m_impl->depth);
+        glBindRenderbuffer(GL_RENDERBUFFER, m_impl->depth);
+        glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT24, width, height);
+        glGenFramebuffers(1, &m_impl->framebuffer);
+        glBindFramebuffer(GL_FRAMEBUFFER, m_impl->framebuffer);
+        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, m_impl->color, 0);
+        glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, m_impl->depth);
+        const auto status = glCheckFramebufferStatus(GL_FRAMEBUFFER);
+        glBindFramebuffer(GL_FRAMEBUFFER, 0);
+        if(status != GL_FRAMEBUFFER_COMPLETE) {
+            glDeleteFramebuffers(1, &m_impl->framebuffer);
+            glDeleteRenderbuffers(1, &m_impl->depth);
+            glDeleteTextures(1, &m_impl->color);
+            throw std::runtime_error{"Failed to create virtual texture feedback buffer."};
+        }
+
+        glGenBuffers(static_cast<GLsizei>(m_impl->buffers.size()), m_impl->buffers.data());
+        for(const auto buffer : m_impl->buffers) {
+            glBindBuffer(GL_PIXEL_PACK_BUFFER, buffer);
+            glBufferData(GL_PIXEL_PACK_BUFFER, static_cast<GLsizeiptr>(m_impl->pixels.size()), nullptr,
+                    GL_STREAM_READ);
+        }
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+    }
+
+    VirtualTextureFeedback::~VirtualTextureFeedback() {
+        for(const auto fence : m_impl->fences) {
+            if(fence != nullptr) {
+                glDeleteSync(fence);
+            }
+        }
+        glDeleteBuffers(static_cast<GLsizei>(m_impl->buffers.size()), m_impl->buffers.data());
+        glDeleteFramebuffers(1, &m_impl->framebuffer);
+        glDeleteRenderbuffers(1, &m_impl->depth);
+        glDeleteTextures(1, &m_impl->color);
+    }
+
+    void VirtualTextureFeedback::begin() {
+        glGetIntegerv(GL_DRAW_FRAMEBUFFER_BINDING, &m_impl->previous_framebuffer);
+        glGetIntegerv(GL_VIEWPORT, m_impl->previous_viewport.data());
+        glBindFramebuffer(GL_FRAMEBUFFER, m_impl->framebuffer);
+        glViewport(0, 0, m_impl->width, m_impl->height);
+        // Alpha holds the requested level, 255 marks pixels without any virtual texture.
+        glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
+        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+    }
+
+    void VirtualTextureFeedback::end() {
+        // When all buffers are still in flight the frame is skipped rather than waited for.
+        if(m_impl->pending < m_impl->buffers.size()) {
+            const auto index = (m_impl->oldest + m_impl->pending) % m_impl->buffers.size();
+            glBindBuffer(GL_PIXEL_PACK_BUFFER, m_impl->buffers[index]);
+            glReadPixels(0, 0, m_impl->width, m_impl->height, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+            glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+            m_impl->fences[index] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+            ++m_impl->pending;
+        }
+        glBindFramebuffer(GL_FRAMEBUFFER, static_cast<GLuint>(m_impl->previous_framebuffer));
+        glViewport(m_impl->previous_viewport[0], m_impl->previous_viewport[1], m_impl->previous_viewport[2],
+                m_impl->previous_viewport[3]);
+    }
+
+    bool VirtualTextureFeedback::read(const Uint8*& pixels, std::size_t& count) {
+        bool ready{false};
+        while(m_impl->pending > 0) {
+            auto& fence = m_impl->fences[m_impl->oldest];
+            const auto status = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 0);
+            if(status == GL_TIMEOUT_EXPIRED) {
+                break;
+            }
+            glDeleteSync(fence);
+            fence = nullptr;
+            if(status != GL_WAIT_FAILED) {
+                glBindBuffer(GL_PIXEL_PACK_BUFFER, m_impl->buffers[m_impl->oldest]);
+                const auto* mapped = glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0,
+                        static_cast<GLsizeiptr>(m_impl->pixels.size()), GL_MAP_READ_BIT);
+                if(mapped != nullptr) {
+                    std::memcpy(m_impl->pixels.data(), mapped, m_impl->pixels.size());
+                    glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+                    ready = true;
+                }
+                glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+            }
+            m_impl->oldest = (m_impl->oldest + 1) % m_impl->buffers.size();
+            --m_impl->pending;
+        }
+        pixels = m_impl->pixels.data();
+        count = m_impl->pixels.size() / 4;
+        return ready;
+    }
+
+    struct VirtualTexture::Impl {
+        struct Slot {
+            Uint32 level{};
+            Uint32 x{};
+            Uint32 y{};
+            Uint64 last_used_frame{0};
+            bool   occupied{false};
+            bool   pinned{false};
+        };
+
+        struct Read {
+            unsigned int       level{};
+            unsigned int       x{};
+            unsigned int       y{};
+            std::vector<Uint8> data{};
+        };
+
+        unsigned int tiles_x(const unsigned int level) const noexcept { return std::max(level_tiles_x >> level, 1u); }
+        unsigned int tiles_y(const unsigned int level) const noexcept { return std::max(level_tiles_y >> level, 1u); }
+        const Uint8* tile_data(const unsigned int level, const unsigned int x, const unsigned int y) const;
+        Uint32& tile_state(const unsigned int level, const unsigned int x, const unsigned int y);
+        void upload(const Uint32 slot, const Uint8* data);
+        bool place(const Read& read);
+        void request(const Uint8* pixels, const std::size_t count);
+        void rebuild_indirection();
+
+        MappedFile                      file{};
+        unsigned int                    width{};
+        unsigned int                    height{};
+        unsigned int                    tile_size{};
+        unsigned int                    border{};
+        unsigned int                    level_count{};
+        unsigned int                    level_tiles_x{};
+        unsigned int                    level_tiles_y{};
+        std::vector<std::size_t>        level_offsets{};   // Index of the first tile of each level.
+        std::size_t                     tile_bytes{};
+
+        unsigned int                    cache_size{};
+        unsigned int                    cache_texture{0};
+        unsigned int                    indirection_texture{0};
+        std::vector<Slot>               slots{};
+        std::vector<std::vector<Uint32>> states{};         // Slot of each tile, TILE_MISSING or TILE_LOADING.
+        std::vector<std::vector<Uint8>>  indirection{};
+        bool                            indirection_dirty{false};
+        Uint64                          frame{0};
+
+        std::vector<Read>               ready{};
+        std::vector<Read>               finished{};
+        std::size_t                     running{0};
+        std::mutex                      mutex{};
+        std::condition_variable         condition{};
+    };
+
+    const Uint8* VirtualTexture::Impl::tile_data(const unsigned int level, const unsigned int x,
+            const unsigned int y) const {
+        const auto index = level_offsets[level] + static_cast<std::size_t>(y) * tiles_x(level) + x;
+        return file.data() + STORE_HEADER_SIZE + index * tile_bytes;
+    }
+
+    Uint32& VirtualTexture::Impl::tile_state(const unsigned int level, const unsigned int x, const unsigned int y) {
+        return states[level][static_cast<std::size_t>(y) * tiles_x(level) + x];
+    }
+
+    void VirtualTexture::Impl::upload(const Uint32 slot, const Uint8* data) {
+        const auto padded = tile_size + 2 * border;
+        glBindTexture(GL_TEXTURE_2D, cache_texture);
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+        glTexSubImage2D(GL_TEXTURE_2D, 0, static_cast<GLint>(slot % cache_size * padded),
+                static_cast<GLint>(slot / cache_size * padded), padded, padded, GL_RGBA, GL_UNSIGNED_BYTE, data);
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+    }
+
+    bool VirtualTexture::Impl::place(const Read& read) {
+        // Take a free slot, or the least recently used one which wasn't requested in this frame.
+        Slot* victim{nullptr};
+        for(auto& slot : slots) {
+            if(!slot.occupied) {
+                victim = &slot;
+                break;
+            }
+            if(!slot.pinned && slot.last_used_frame < frame
+                    && (victim == nullptr || slot.last_used_frame < victim->last_used_frame)) {
+                victim = &slot;
+            }
+        }
+        if(victim == nullptr) {
+            return false;
+        }
+        if(victim->occupied) {
+            tile_state(victim->level, victim->x, victim->y) = TILE_MISSING;
+        }
+        const auto index = static_cast<Uint32>(victim - slots.data());
+        *victim = Slot{read.level, read.x, read.y, frame, true, false};
+        tile_state(read.level, read.x, read.y) = index;
+        upload(index, read.data.data());
+        indirection_dirty = true;
+        return true;
+    }
+
+    void VirtualTexture::Impl::request(const Uint8* pixels, const std::size_t count) {
+        struct Request {
+            unsigned int level{};
+            unsigned int x{};
+            unsigned int y{};
+        };
+        std::vector<Request> requests{};
+        Uint32 previous{0xFFFFFFFF};
+        for(std::size_t i = 0; i < count; ++i) {
+            const auto* pixel = pixels + i * 4;
+            const Uint32 packed = read_u32(pixel);
+            // Neighbouring pixels mostly ask for the same tile.
+            if(packed == previous || pixel[3] >= level_count) {
+                continue;
+            }
+            previous = packed;
+            auto level = static_cast<unsigned int>(pixel[3]);
+            auto x = pixel[0] | (pixel[2] & 0x0Fu) << 8;
+            auto y = pixel[1] | (pixel[2] & 0xF0u) << 4;
+            if(x >= tiles_x(level) || y >= tiles_y(level)) {
+                continue;
+            }
+            // Coarser tiles of the same area are the fallback until this one is loaded, so keep them too.
+            for(; level < level_count; ++level, x /= 2, y /= 2) {
+                auto& state = tile_state(level, x, y);
+                if(state == TILE_LOADING) {
+                    continue;
+                }
+                if(state == TILE_MISSING) {
+                    requests.push_back(Request{level, x, y});
+                    state = TILE_LOADING;
+                } else if(slots[state].last_used_frame == frame) {
+                    break;
+                } else {
+                    slots[state].last_used_frame = frame;
+                }
+            }
+        }
+        // Coarse tiles cover more of the screen, so they are read first.
+        std::stable_sort(requests.begin(), requests.end(), [](const Request& a, const Request& b) {
+            return a.level > b.level;
+        });
+        std::lock_guard<std::mutex> mutex_lock{mutex};
+        for(const auto& request : requests) {
+            if(running + ready.size() >= MAX_READS) {
+                tile_state(request.level, request.x, request.y) = TILE_MISSING;
+                continue;
+            }
+            ++running;
+            const auto* data = tile_data(request.level, request.x, request.y);
+            default_thread_pool().submit([this, request, data]() {
+                Read read{request.level, request.x, request.y, std::vector<Uint8>(data, data + tile_bytes)};
+                std::lock_guard<std::mutex> mutex_lock{mutex};
+                finished.push_back(std::move(read));
+                --running;
+                condition.notify_all();
+            });
+        }
+    }
+
+    void VirtualTexture::Impl::rebuild_indirection() {
+        // Every entry points to the tile itself if it's in the cache, otherwise it copies the entry of the parent.
+        // The last level is pinned, so the chain always ends in a resident tile.
+        glBindTexture(GL_TEXTURE_2D, indirection_texture);
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+        for(auto level = level_count; level-- > 0;) {
+            const auto columns = tiles_x(level);
+            const auto rows = tiles_y(level);
+            auto& entries = indirection[level];
+            for(unsigned int y = 0; y < rows; ++y) {
+                for(unsigned int x = 0; x < columns; ++x) {
+                    auto* entry = entries.data() + (static_cast<std::size_t>(y) * columns + x) * 4;
+                    const auto state = tile_state(level, x, y);
+                    if(state < TILE_LOADING) {
+                        entry[0] = static_cast<Uint8>(state % cache_size);
+                        entry[1] = static_cast<Uint8>(state / cache_size);
+                        entry[2] = static_cast<Uint8>(level);
+                        entry[3] = 255;
+                    } else {
+                        const auto* parent = indirection[level + 1].data()
+                                + (static_cast<std::size_t>(y / 2) * tiles_x(level + 1) + x / 2) * 4;
+                        std::memcpy(entry, parent, 4);
+                    }
+                }
+            }
+            glTexSubImage2D(GL_TEXTURE_2D, static_cast<GLint>(level), 0, 0, columns, rows, GL_RGBA,
+                    GL_UNSIGNED_BYTE, entries.data());
+        }
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+        indirection_dirty = false;
+    }
+
+    void VirtualTexture::build_tile_store(const ImageView& image, const std::string_view filename,
+            const unsigned int tile_size, const unsigned int border) {
+        build_store(image.width, image.height, filename, tile_size, border, tile_size,
+                [&](const unsigned int first, const unsigned int count) {
+                    return image.subview(RectU{0, first, image.width, count});
+                });
+    }
+
+    void VirtualTexture::build_tile_store(TiledImage& image, const std::string_view filename,
+            const unsigned int tile_size, const unsigned int border) {
+        const auto [width, height] = image.size();
+        // Bands follow the tiles of the image, so each of them is read once.
+        Image band{};
+        build_store(width, height, filename, tile_size, border, image.tile_size(),
+                [&, width = width](const unsigned int first, const unsigned int count) {
+                    band = image.read(RectU{0, first, width, count});
+                    return band.view();
+                });
+    }
+
+    VirtualTexture::VirtualTexture() noexcept = default;
+
+    VirtualTexture::~VirtualTexture() {
+        close();
+    }
+
+    void VirtualTexture::open(const std::string_view filename, const unsigned int cache_size) {
+        close();
+        if(cache_size == 0 || cache_size > 255) {
+            throw std::runtime_error{"Failed to open tile store \"" + std::string{filename}
+                    + "\": cache size must be between 1 and 255 tiles."};
+        }
+        m_impl = std::make_unique<Impl>();
+        auto& impl = *m_impl;
+        try {
+            impl.file.open(filename);
+            const auto* data = impl.file.data();
+            if(impl.file.size() < STORE_HEADER_SIZE || std::memcmp(data, STORE_MAGIC.data(), STORE_MAGIC.size()) != 0) {
+                throw std::runtime_error{"Failed to open tile store \"" + std::string{filename} + "\"."};
+            }
+            data += STORE_MAGIC.size();
+            impl.width = read_u32(data);
+            impl.height = read_u32(data + 4);
+            impl.tile_size = read_u32(data + 8);
+            impl.border = read_u32(data + 12);
+            impl.level_count = read_u32(data + 16);
+            impl.level_tiles_x = read_u32(data + 20);
+            impl.level_tiles_y = read_u32(data + 24);
+            const auto tiles_valid = impl.level_tiles_x > 0 && impl.level_tiles_x <= MAX_TILES
+                    && impl.level_tiles_y > 0 && impl.level_tiles_y <= MAX_TILES
+                    && (impl.level_tiles_x & (impl.level_tiles_x - 1)) == 0
+                    && (impl.level_tiles_y & (impl.level_tiles_y - 1)) == 0;
+            if(!tiles_valid || impl.tile_size == 0 || impl.tile_size > 4096 || impl.border > impl.tile_size
+                    || impl.level_count
+                            != std::min(floor_log2(impl.level_tiles_x), floor_log2(impl.level_tiles_y)) + 1) {
+                throw std::runtime_error{"Tile store \"" + std::string{filename} + "\" is corrupted."};
+            }
+            const auto padded = impl.tile_size + 2 * impl.border;
+            impl.tile_bytes = static_cast<std::size_t>(padded) * padded * 4;
+            std::size_t tile_count{0};
+            for(unsigned int level = 0; level < impl.level_count; ++level) {
+                impl.level_offsets.push_back(tile_count);
+                const auto level_tiles = static_cast<std::size_t>(impl.tiles_x(level)) * impl.tiles_y(level);
+                impl.states.emplace_back(level_tiles, TILE_MISSING);
+                impl.indirection.emplace_back(level_tiles * 4);
+                tile_count += level_tiles;
+            }
+            if(impl.file.size() < STORE_HEADER_SIZE + tile_count * impl.tile_bytes) {
+                throw std::runtime_error{"Tile store \"" + std::string{filename} + "\" is corrupted."};
+            }
+            const auto last_level = impl.level_count - 1;
+            const auto pinned = impl.tiles_x(last_level) * impl.tiles_y(last_level);
+            // Half of the cache is left for the streamed tiles at least.
+            if(pinned > cache_size * cache_size / 2) {
+                throw std::runtime_error{"Failed to open tile store \"" + std::string{filename}
+                        + "\": the cache is too small for its aspect ratio."};
+            }
+
+            impl.cache_size = cache_size;
+            impl.slots.resize(static_cast<std::size_t>(cache_size) * cache_size);
+            glGenTextures(1, &impl.cache_texture);
+            glBindTexture(GL_TEXTURE_2D, impl.cache_texture);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+            glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, cache_size * padded, cache_size * padded, 0, GL_RGBA,
+                    GL_UNSIGNED_BYTE, nullptr);
+
+            glGenTextures(1, &impl.indirection_texture);
+            glBindTexture(GL_TEXTURE_2D, impl.indirection_texture);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST_MIPMAP_NEAREST);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, static_cast<GLint>(last_level));
+            for(unsigned int level = 0; level < impl.level_count; ++level) {
+                glTexImage2D(GL_TEXTURE_2D, static_cast<GLint>(level), GL_RGBA8, impl.tiles_x(level),
+                        impl.tiles_y(level), 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+            }
+
+            for(unsigned int y = 0; y < impl.tiles_y(last_level); ++y) {
+                for(unsigned int x = 0; x < impl.tiles_x(last_level); ++x) {
+                    const auto* tile = impl.tile_data(last_level, x, y);
+                    impl.place(Impl::Read{last_level, x, y, std::vector<Uint8>(tile, tile + impl.tile_bytes)});
+                    impl.slots[impl.tile_state(last_level, x, y)].pinned = true;
+                }
+            }
+            impl.rebuild_indirection();
+        } catch(...) {
+            close();
+            throw;
+        }
+    }
+
+    void VirtualTexture::close() {
+        if(m_impl == nullptr) {
+            return;
+        }
+        {
+            std::unique_lock<std::mutex> mutex_lock{m_impl->mutex};
+            m_impl->condition.wait(mutex_lock, [this]() { return m_impl->running == 0; });
+        }
+        glDeleteTextures(1, &m_impl->cache_texture);
+        glDeleteTextures(1, &m_impl->indirection_texture);
+        m_impl.reset();
+    }
+
+    void VirtualTexture::update(VirtualTextureFeedback& feedback, const unsigned int max_uploads) {
+        if(m_impl == nullptr) {
+            return;
+        }
+        auto& impl = *m_impl;
+        {
+            std::lock_guard<std::mutex> mutex_lock{impl.mutex};
+            std::move(impl.finished.begin(), impl.finished.end(), std::back_inserter(impl.ready));
+            impl.finished.clear();
+        }
+        // Tiles over the upload limit wait for the next frames.
+        const auto uploads = std::min<std::size_t>(impl.ready.size(), max_uploads);
+        for(std::size_t i = 0; i < uploads; ++i) {
+            const auto& read = impl.ready[i];
+            if(!impl.place(read)) {
+                impl.tile_state(read.level, read.x, read.y) = TILE_MISSING;
+            }
+        }
+        {
+            std::lock_guard<std::mutex> mutex_lock{impl.mutex};
+            impl.ready.erase(impl.ready.begin(), impl.ready.begin() + static_cast<std::ptrdiff_t>(uploads));
+        }
+
+        const Uint8* pixels{nullptr};
+        std::size_t count{0};
+        if(feedback.read(pixels, count)) {
+            ++impl.frame;
+            impl.request(pixels, count);
+        }
+        if(impl.indirection_dirty) {
+            impl.rebuild_indirection();
+        }
+    }
+
+    void VirtualTexture::bind(Shader& shader, const unsigned int indirection_unit, const unsigned int cache_unit,
+            const float feedback_scale) const {
+        if(m_impl == nullptr) {
+            return;
+        }
+        const auto& impl = *m_impl;
+        glActiveTexture(GL_TEXTURE0 + indirection_unit);
+        glBindTexture(GL_TEXTURE_2D, impl.indirection_texture);
+        glActiveTexture(GL_TEXTURE0 + cache_unit);
+        glBindTexture(GL_TEXTURE_2D, impl.cache_texture);
+        glActiveTexture(GL_TEXTURE0);
+
+        const auto tiles_x = static_cast<float>(impl.level_tiles_x);
+        const auto tiles_y = static_cast<float>(impl.level_tiles_y);
+        const auto tile_size = static_cast<float>(impl.tile_size);
+        const auto cache_pixels = static_cast<float>(impl.cache_size * (impl.tile_size + 2 * impl.border));
+        shader.set_uniform("ogf_vt_indirection", static_cast<int>(indirection_unit));
+        shader.set_uniform("ogf_vt_cache", static_cast<int>(cache_unit));
+        // Color is the vec4 setter, the components are just the packed parameters.
+        shader.set_uniform("ogf_vt_size", Color{tiles_x, tiles_y,
+                static_cast<float>(impl.width) / (tiles_x * tile_size),
+                static_cast<float>(impl.height) / (tiles_y * tile_size)});
+        shader.set_uniform("ogf_vt_tile", Color{tile_size, static_cast<float>(impl.border), cache_pixels,
+                static_cast<float>(impl.level_count - 1)});
+        // A smaller feedback buffer sees bigger derivatives, which is compensated here.
+        shader.set_uniform("ogf_vt_feedback_bias", feedback_scale > 0.0f ? std::log2(feedback_scale) : 0.0f);
+    }
+
+}
@@ -5,6 +5,7 @@
 #include <SDL2/SDL.h>
 
 #include <ogf/graphics/drawable.hxx>
+#include <ogf/graphics/gl_extensions.hxx>
 #include <ogf/system/event.hxx>
 
 namespace ogf {
@@ -44,6 +45,7 @@ namespace ogf {
         if(!gladLoadGL()) {
             throw std::runtime_error{"Failed to initialize glad."};
         }
+        load_gl_extensions(SDL_GL_GetProcAddress);
         glEnable(GL_DEPTH_TEST);
         return *this;
     }
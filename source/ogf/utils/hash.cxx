@@ -0,0 +1,65 @@
+#include <ogf/utils/hash.hxx>
+
+#include <cstring>
+
+namespace ogf {
+
+    namespace {
+
+        constexpr Uint64 PRIME_1 = 0x9e3779b185ebca87ull;
+        constexpr Uint64 PRIME_2 = 0xc2b2ae3d27d4eb4full;
+        constexpr Uint64 PRIME_3 = 0x165667b19e3779f9ull;
+
+        Uint64 rotate_left(const Uint64 value, const int bits) noexcept {
+            return (value << bits) | (value >> (64 - bits));
+        }
+
+        Uint64 read_word(const Uint8* data) noexcept {
+            Uint64 word{};
+            std::memcpy(&word, data, sizeof(word));
+            return word;
+        }
+
+        Uint64 round(const Uint64 lane, const Uint64 word) noexcept {
+            return rotate_left(lane + word * PRIME_2, 31) * PRIME_1;
+        }
+
+        // Spread every input bit over the whole result.
+        Uint64 finalize(Uint64 hash) noexcept {
+            hash ^= hash >> 33;
+            hash *= PRIME_2;
+            hash ^= hash >> 29;
+            hash *= PRIME_3;
+            hash ^= hash >> 32;
+            return hash;
+        }
+
+    }
+
+    Uint64 hash_bytes(const void* data, const std::size_t size, const Uint64 seed) noexcept {
+        auto bytes = static_cast<const Uint8*>(data);
+        const auto end = bytes + size;
+        Uint64 hash{seed + PRIME_3 + static_cast<Uint64>(size)};
+        if(size >= 32) {
+            Uint64 lanes[4] = {seed + PRIME_1 + PRIME_2, seed + PRIME_2, seed, seed - PRIME_1};
+            for(; end - bytes >= 32; bytes += 32) {
+                for(int lane = 0; lane < 4; ++lane) {
+                    lanes[lane] = round(lanes[lane], read_word(bytes + 8 * lane));
+                }
+            }
+            hash = rotate_left(lanes[0], 1) + rotate_left(lanes[1], 7) + rotate_left(lanes[2], 12)
+                    + rotate_left(lanes[3], 18) + static_cast<Uint64>(size);
+            for(const auto lane : lanes) {
+                hash = (hash ^ round(0, lane)) * PRIME_1 + PRIME_3;
+            }
+        }
+        for(; end - bytes >= 8; bytes += 8) {
+            hash = rotate_left(hash ^ round(0, read_word(bytes)), 27) * PRIME_1 + PRIME_3;
+        }
+        for(; bytes != end; ++bytes) {
+            hash = rotate_left(hash ^ (*bytes * PRIME_3), 11) * PRIME_1;
+        }
+        return finalize(hash);
+    }
+
+}
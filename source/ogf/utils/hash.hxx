@@ -0,0 +1,13 @@
+#pragma once
+
+#include <cstddef>
+
+#include <ogf/types.hxx>
+
+namespace ogf {
+
+    // Fast non-cryptographic 64-bit hash of the bytes, for keying caches by content. Different seeds give independent
+    // hashes. Reads 32 bytes per step in four independent lanes, so it's bound by memory bandwidth on large inputs.
+    Uint64 hash_bytes(const void* data, const std::size_t size, const Uint64 seed = 0) noexcept;
+
+}
@@ -1,5 +1,7 @@
 #include <ogf/utils/io_utils.hxx>
 
+#include <algorithm>
+#include <cctype>
 #include <fstream>
 #include <sstream>
 #include <stdexcept>
@@ -24,4 +26,14 @@ namespace ogf {
         return std::string{filename.substr(filename.find_last_of('.') + 1)};
     }
 
+    bool has_file_extension(const std::string_view filename, const std::string_view extension) {
+        const auto dot = filename.find_last_of('.');
+        if(dot == std::string_view::npos) {
+            return false;
+        }
+        const auto file_extension = filename.substr(dot + 1);
+        return std::equal(file_extension.begin(), file_extension.end(), extension.begin(), extension.end(),
+                [](const unsigned char a, const unsigned char b) { return std::tolower(a) == std::tolower(b); });
+    }
+
 }
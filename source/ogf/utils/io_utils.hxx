@@ -7,4 +7,7 @@ namespace ogf {
     std::stringstream get_file_content_as_sstream(const std::string_view filename);
     std::string get_file_extension(const std::string_view filename);
 
+    // Check if the file has given extension, ignoring case, e.g. "a.DDS" has the extension "dds".
+    bool has_file_extension(const std::string_view filename, const std::string_view extension);
+
 }
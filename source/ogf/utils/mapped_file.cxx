@@ -0,0 +1,122 @@
+#include <ogf/utils/mapped_file.hxx>
+
+#include <stdexcept>
+#include <utility>
+
+#if defined(_WIN32)
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN 1
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX 1
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace ogf {
+
+    MappedFile::~MappedFile() {
+        close();
+    }
+
+    MappedFile::MappedFile(MappedFile&& other) noexcept {
+        *this = std::move(other);
+    }
+
+    MappedFile& MappedFile::operator=(MappedFile&& other) noexcept {
+        if(this != &other) {
+            close();
+            std::swap(m_data, other.m_data);
+            std::swap(m_size, other.m_size);
+#if defined(_WIN32)
+            std::swap(m_file, other.m_file);
+            std::swap(m_mapping, other.m_mapping);
+#endif
+        }
+        return *this;
+    }
+
+    void MappedFile::open(const std::string_view filename) {
+        close();
+        const auto error = std::runtime_error{"Failed to map file \"" + std::string{filename} + "\"."};
+#if defined(_WIN32)
+        m_file = CreateFileA(std::string{filename}.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                FILE_ATTRIBUTE_NORMAL, nullptr);
+        if(m_file == INVALID_HANDLE_VALUE) {
+            m_file = nullptr;
+            throw error;
+        }
+        LARGE_INTEGER size{};
+        if(!GetFileSizeEx(m_file, &size) || size.QuadPart == 0) {
+            close();
+            throw error;
+        }
+        m_mapping = CreateFileMappingA(m_file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if(m_mapping == nullptr) {
+            close();
+            throw error;
+        }
+        m_data = static_cast<const Uint8*>(MapViewOfFile(m_mapping, FILE_MAP_READ, 0, 0, 0));
+        if(m_data == nullptr) {
+            close();
+            throw error;
+        }
+        m_size = static_cast<std::size_t>(size.QuadPart);
+#else
+        const auto file = ::open(std::string{filename}.c_str(), O_RDONLY);
+        if(file < 0) {
+            throw error;
+        }
+        struct stat status{};
+        if(fstat(file, &status) != 0 || status.st_size == 0) {
+            ::close(file);
+            throw error;
+        }
+        const auto size = static_cast<std::size_t>(status.st_size);
+        auto data = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, file, 0);
+        // The mapping keeps its own reference to the file.
+        ::close(file);
+        if(data == MAP_FAILED) {
+            throw error;
+        }
+        m_data = static_cast<const Uint8*>(data);
+        m_size = size;
+#endif
+    }
+
+    void MappedFile::close() noexcept {
+#if defined(_WIN32)
+        if(m_data != nullptr) {
+            UnmapViewOfFile(m_data);
+        }
+        if(m_mapping != nullptr) {
+            CloseHandle(m_mapping);
+        }
+        if(m_file != nullptr) {
+            CloseHandle(m_file);
+        }
+        m_mapping = nullptr;
+        m_file = nullptr;
+#else
+        if(m_data != nullptr) {
+            munmap(const_cast<Uint8*>(m_data), m_size);
+        }
+#endif
+        m_data = nullptr;
+        m_size = 0;
+    }
+
+    const Uint8* MappedFile::data() const noexcept {
+        return m_data;
+    }
+
+    std::size_t MappedFile::size() const noexcept {
+        return m_size;
+    }
+
+}
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+#include <ogf/types.hxx>
+
+namespace ogf {
+
+    // Read-only memory mapping of a whole file.
+    class MappedFile {
+    public:
+        MappedFile() noexcept = default;
+        ~MappedFile();
+
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+
+        MappedFile(MappedFile&& other) noexcept;
+        MappedFile& operator=(MappedFile&& other) noexcept;
+
+        // Map the file, unmapping the previous one first. Throws if the file can't be opened or mapped.
+        void open(const std::string_view filename);
+
+        // Unmap the file. Does nothing if no file is mapped.
+        void close() noexcept;
+
+        const Uint8* data() const noexcept;
+        std::size_t size() const noexcept;
+
+    private:
+        const Uint8* m_data{nullptr};
+        std::size_t  m_size{0};
+#if defined(_WIN32)
+        void*        m_file{nullptr};
+        void*        m_mapping{nullptr};
+#endif
+    };
+
+}
@@ -0,0 +1,108 @@
+#include <ogf/utils/thread_pool.hxx>
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+
+namespace ogf {
+
+    ThreadPool::ThreadPool(unsigned int thread_count) {
+        if(thread_count == 0) {
+            thread_count = std::max(std::thread::hardware_concurrency(), 1u);
+        }
+        m_threads.reserve(thread_count);
+        for(unsigned int i = 0; i < thread_count; ++i) {
+            m_threads.emplace_back(&ThreadPool::worker_loop, this);
+        }
+    }
+
+    ThreadPool::~ThreadPool() {
+        {
+            std::lock_guard<std::mutex> mutex_lock{m_mutex};
+            m_stopping = true;
+        }
+        m_condition.notify_all();
+        for(auto& thread : m_threads) {
+            thread.join();
+        }
+    }
+
+    unsigned int ThreadPool::thread_count() const noexcept {
+        return static_cast<unsigned int>(m_threads.size());
+    }
+
+    void ThreadPool::worker_loop() {
+        while(true) {
+            std::function<void()> task{};
+            {
+                std::unique_lock<std::mutex> mutex_lock{m_mutex};
+                m_condition.wait(mutex_lock, [this]() { return m_stopping || !m_tasks.empty(); });
+                if(m_tasks.empty()) {
+                    return;
+                }
+                task = std::move(m_tasks.front());
+                m_tasks.pop();
+            }
+            task();
+        }
+    }
+
+    ThreadPool& default_thread_pool() {
+        static ThreadPool pool{};
+        return pool;
+    }
+
+    void parallel_for(const std::size_t count, const std::function<void(std::size_t)>& body) {
+        if(count == 0) {
+            return;
+        }
+        if(count == 1) {
+            body(0);
+            return;
+        }
+        // Helpers may start after all indices were claimed and the caller returned, so the state is shared with them
+        // and the body is only touched after a valid index was claimed.
+        struct State {
+            const std::function<void(std::size_t)>* body{nullptr};
+            std::size_t                             count{};
+            std::atomic<std::size_t>                next{0};
+            std::size_t                             done{0};
+            std::exception_ptr                      error{};
+            std::mutex                              mutex{};
+            std::condition_variable                 condition{};
+        };
+        auto state = std::make_shared<State>();
+        state->body = &body;
+        state->count = count;
+        const auto run = [](State& state) {
+            std::size_t index{};
+            while((index = state.next.fetch_add(1)) < state.count) {
+                std::exception_ptr error{};
+                try {
+                    (*state.body)(index);
+                } catch(...) {
+                    error = std::current_exception();
+                }
+                std::lock_guard<std::mutex> mutex_lock{state.mutex};
+                if(error && !state.error) {
+                    state.error = error;
+                }
+                if(++state.done == state.count) {
+                    state.condition.notify_all();
+                }
+            }
+        };
+        auto& pool = default_thread_pool();
+        const auto helper_count = std::min<std::size_t>(pool.thread_count(), count - 1);
+        for(std::size_t i = 0; i < helper_count; ++i) {
+            pool.submit([state, run]() { run(*state); });
+        }
+        run(*state);
+        std::unique_lock<std::mutex> mutex_lock{state->mutex};
+        state->condition.wait(mutex_lock, [&state]() { return state->done == state->count; });
+        if(state->error) {
+            std::rethrow_exception(state->error);
+        }
+    }
+
+}
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace ogf {
+
+    // Fixed-size pool of worker threads executing tasks in FIFO order.
+    class ThreadPool {
+    public:
+        // Create a pool with given number of threads. Zero means one thread per hardware thread.
+        explicit ThreadPool(unsigned int thread_count = 0);
+
+        // Finish all queued tasks and join the workers.
+        ~ThreadPool();
+
+        ThreadPool(const ThreadPool&) = delete;
+        ThreadPool& operator=(const ThreadPool&) = delete;
+
+        // Queue a task for execution. Exceptions thrown by the task are stored in the returned future.
+        template<typename F>
+        std::future<std::invoke_result_t<F>> submit(F&& task);
+
+        unsigned int thread_count() const noexcept;
+
+    private:
+        void worker_loop();
+
+        std::vector<std::thread>          m_threads{};
+        std::queue<std::function<void()>> m_tasks{};
+        std::mutex                        m_mutex{};
+        std::condition_variable           m_condition{};
+        bool                              m_stopping{false};
+    };
+
+    // Get the pool shared by all asynchronous operations of the library.
+    ThreadPool& default_thread_pool();
+
+    // Call body(i) for every i in [0 .. count) using the default pool and return when all calls are done. The calling
+    // thread takes part in the work, so it's safe to call this from inside a pool task. The first exception thrown by
+    // the body is rethrown.
+    void parallel_for(const std::size_t count, const std::function<void(std::size_t)>& body);
+
+    // Implementation.
+
+    template<typename F>
+    std::future<std::invoke_result_t<F>> ThreadPool::submit(F&& task) {
+        using Result = std::invoke_result_t<F>;
+        // std::function requires a copyable target, hence the shared_ptr around the move-only packaged_task.
+        auto packaged_task = std::make_shared<std::packaged_task<Result()>>(std::forward<F>(task));
+        auto future = packaged_task->get_future();
+        {
+            std::lock_guard<std::mutex> mutex_lock{m_mutex};
+            m_tasks.emplace([packaged_task]() { (*packaged_task)(); });
+        }
+        m_condition.notify_one();
+        return future;
+    }
+
+}
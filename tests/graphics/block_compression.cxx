@@ -0,0 +1,189 @@
+#include <gtest/gtest.h>
+
+#include <array>
+#include <cstdlib>
+
+#include <ogf/graphics/block_compression.hxx>
+
+namespace {
+
+    using Block = std::array<ogf::Uint8, 64>;
+
+    Block gradient_block() {
+        Block block{};
+        for(int i = 0; i < 16; ++i) {
+            block[i * 4] = static_cast<ogf::Uint8>(40 + i * 10);
+            block[i * 4 + 1] = static_cast<ogf::Uint8>(200 - i * 8);
+            block[i * 4 + 2] = static_cast<ogf::Uint8>(90 + i * 3);
+            block[i * 4 + 3] = static_cast<ogf::Uint8>(255 - i * 12);
+        }
+        return block;
+    }
+
+    std::array<int, 3> unpack_565(const int color) {
+        const auto r = (color >> 11) & 31;
+        const auto g = (color >> 5) & 63;
+        const auto b = color & 31;
+        return {r << 3 | r >> 2, g << 2 | g >> 4, b << 3 | b >> 2};
+    }
+
+    Block decode_bc1(const ogf::Uint8* data) {
+        const auto color0 = data[0] | data[1] << 8;
+        const auto color1 = data[2] | data[3] << 8;
+        const auto c0 = unpack_565(color0);
+        const auto c1 = unpack_565(color1);
+        std::array<std::array<int, 4>, 4> palette{};
+        for(int c = 0; c < 3; ++c) {
+            palette[0][c] = c0[c];
+            palette[1][c] = c1[c];
+            palette[2][c] = color0 > color1 ? (2 * c0[c] + c1[c]) / 3 : (c0[c] + c1[c]) / 2;
+            palette[3][c] = color0 > color1 ? (c0[c] + 2 * c1[c]) / 3 : 0;
+        }
+        palette[0][3] = palette[1][3] = palette[2][3] = 255;
+        palette[3][3] = color0 > color1 ? 255 : 0;
+        const auto bits = static_cast<ogf::Uint32>(data[4] | data[5] << 8 | data[6] << 16 | data[7] << 24);
+        Block block{};
+        for(int i = 0; i < 16; ++i) {
+            for(int c = 0; c < 4; ++c) {
+                block[i * 4 + c] = static_cast<ogf::Uint8>(palette[bits >> (i * 2) & 3][c]);
+            }
+        }
+        return block;
+    }
+
+    std::array<int, 16> decode_bc4(const ogf::Uint8* data) {
+        const int value0 = data[0];
+        const int value1 = data[1];
+        std::array<int, 8> palette{value0, value1};
+        for(int i = 1; i < 7; ++i) {
+            palette[i + 1] = value0 > value1 ? ((7 - i) * value0 + i * value1) / 7 : 0;
+        }
+        if(value0 <= value1) {
+            for(int i = 1; i < 5; ++i) {
+                palette[i + 1] = ((5 - i) * value0 + i * value1) / 5;
+            }
+            palette[6] = 0;
+            palette[7] = 255;
+        }
+        ogf::Uint64 bits{0};
+        for(int i = 0; i < 6; ++i) {
+            bits |= static_cast<ogf::Uint64>(data[2 + i]) << (i * 8);
+        }
+        std::array<int, 16> values{};
+        for(int i = 0; i < 16; ++i) {
+            values[i] = palette[bits >> (i * 3) & 7];
+        }
+        return values;
+    }
+
+    Block decode_bc7_mode6(const ogf::Uint8* data) {
+        int position{0};
+        const auto read = [&](const int bits) {
+            int value{0};
+            for(int i = 0; i < bits; ++i, ++position) {
+                value |= (data[position / 8] >> (position % 8) & 1) << i;
+            }
+            return value;
+        };
+        EXPECT_EQ(read(7), 1 << 6);
+        std::array<std::array<int, 2>, 4> endpoints{};
+        for(auto& channel : endpoints) {
+            channel[0] = read(7);
+            channel[1] = read(7);
+        }
+        const auto pbit0 = read(1);
+        const auto pbit1 = read(1);
+        constexpr std::array<int, 16> weights{0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64};
+        Block block{};
+        for(int i = 0; i < 16; ++i) {
+            const auto index = read(i == 0 ? 3 : 4);
+            for(int c = 0; c < 4; ++c) {
+                const auto start = endpoints[c][0] << 1 | pbit0;
+                const auto end = endpoints[c][1] << 1 | pbit1;
+                const auto value = ((64 - weights[index]) * start + weights[index] * end + 32) >> 6;
+                block[i * 4 + c] = static_cast<ogf::Uint8>(value);
+            }
+        }
+        return block;
+    }
+
+    int max_error(const Block& expected, const Block& actual, const int channels) {
+        int error{0};
+        for(int i = 0; i < 16; ++i) {
+            for(int c = 0; c < channels; ++c) {
+                error = std::max(error, std::abs(expected[i * 4 + c] - actual[i * 4 + c]));
+            }
+        }
+        return error;
+    }
+
+}
+
+TEST(block_compression, bc1_uniform_block_is_exact) {
+    Block block{};
+    for(int i = 0; i < 16; ++i) {
+        block[i * 4] = 255;
+        block[i * 4 + 1] = 0;
+        block[i * 4 + 2] = 255;
+        block[i * 4 + 3] = 255;
+    }
+    std::array<ogf::Uint8, 8> output{};
+    ogf::encode_bc1_block(block.data(), output.data(), ogf::CompressionQuality::NORMAL);
+    ASSERT_EQ(max_error(block, decode_bc1(output.data()), 4), 0);
+}
+
+TEST(block_compression, bc1_gradient_within_tolerance) {
+    const auto block = gradient_block();
+    for(const auto quality : {ogf::CompressionQuality::FAST, ogf::CompressionQuality::NORMAL,
+            ogf::CompressionQuality::HIGH}) {
+        std::array<ogf::Uint8, 16> output{};
+        ogf::encode_bc3_block(block.data(), output.data(), quality);
+        // Four colors over a range of 150 can't do better than 25.
+        ASSERT_LE(max_error(block, decode_bc1(output.data() + 8), 3), 25);
+    }
+}
+
+TEST(block_compression, bc1_punch_through_alpha) {
+    auto block = gradient_block();
+    block[3] = 0;
+    std::array<ogf::Uint8, 8> output{};
+    ogf::encode_bc1_block(block.data(), output.data(), ogf::CompressionQuality::NORMAL);
+    const auto decoded = decode_bc1(output.data());
+    ASSERT_EQ(decoded[3], 0);
+    ASSERT_EQ(decoded[7], 255);
+}
+
+TEST(block_compression, bc4_gradient_within_tolerance) {
+    const auto block = gradient_block();
+    std::array<ogf::Uint8, 8> output{};
+    ogf::encode_bc4_block(block.data(), output.data(), ogf::CompressionQuality::HIGH);
+    const auto decoded = decode_bc4(output.data());
+    for(int i = 0; i < 16; ++i) {
+        ASSERT_NEAR(decoded[i], block[i * 4], 12);
+    }
+}
+
+TEST(block_compression, bc5_channels_within_tolerance) {
+    // Red rises and green falls, so swapped or repeated channels don't pass.
+    const auto block = gradient_block();
+    for(const auto quality : {ogf::CompressionQuality::FAST, ogf::CompressionQuality::NORMAL,
+            ogf::CompressionQuality::HIGH}) {
+        std::array<ogf::Uint8, 16> output{};
+        ogf::encode_bc5_block(block.data(), output.data(), quality);
+        const auto red = decode_bc4(output.data());
+        const auto green = decode_bc4(output.data() + 8);
+        for(int i = 0; i < 16; ++i) {
+            ASSERT_NEAR(red[i], block[i * 4], 12);
+            ASSERT_NEAR(green[i], block[i * 4 + 1], 12);
+        }
+    }
+}
+
+TEST(block_compression, bc7_gradient_within_tolerance) {
+    const auto block = gradient_block();
+    std::array<ogf::Uint8, 16> output{};
+    ogf::encode_bc7_block(block.data(), output.data(), ogf::CompressionQuality::FAST);
+    ASSERT_LE(max_error(block, decode_bc7_mode6(output.data()), 4), 12);
+    ogf::encode_bc7_block(block.data(), output.data(), ogf::CompressionQuality::HIGH);
+    ASSERT_LE(max_error(block, decode_bc7_mode6(output.data()), 4), 4);
+}
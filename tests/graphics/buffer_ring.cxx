@@ -0,0 +1,36 @@
+#include <gtest/gtest.h>
+
+#include <cstring>
+
+#include <glad/glad.h>
+
+#include <ogf/graphics/buffer_ring.hxx>
+
+#include "gl_context.hxx"
+
+TEST(buffer_ring, staged_allocations_upload_when_bound) {
+    if(!make_test_gl_context_current(3, 3)) {
+        GTEST_SKIP() << "No OpenGL 3.3 context.";
+    }
+    // Without buffer storage the data is staged and uploaded by bind_uniform().
+    reload_test_gl_extensions("glBufferStorage");
+    {
+        ogf::BufferRing ring{1024, 2};
+        // Both allocations are made before either is written, as when reserving per-draw blocks up front.
+        const auto first = ring.allocate(sizeof(float));
+        const auto second = ring.allocate(sizeof(float));
+        const float first_value{1.0f}, second_value{2.0f};
+        std::memcpy(first.data, &first_value, sizeof(float));
+        ring.bind_uniform(0, first);
+        std::memcpy(second.data, &second_value, sizeof(float));
+        ring.bind_uniform(1, second);
+        float values[2]{};
+        glBindBuffer(GL_UNIFORM_BUFFER, ring.native_handle());
+        glGetBufferSubData(GL_UNIFORM_BUFFER, static_cast<GLintptr>(first.offset), sizeof(float), &values[0]);
+        glGetBufferSubData(GL_UNIFORM_BUFFER, static_cast<GLintptr>(second.offset), sizeof(float), &values[1]);
+        glBindBuffer(GL_UNIFORM_BUFFER, 0);
+        ASSERT_EQ(values[0], first_value);
+        ASSERT_EQ(values[1], second_value);
+    }
+    reload_test_gl_extensions();
+}
@@ -0,0 +1,66 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <vector>
+
+#include <ogf/graphics/color32.hxx>
+
+TEST(color32, packs_and_unpacks_colors) {
+    std::vector<ogf::Color> colors{};
+    for(int i = 0; i < 37; ++i) {
+        colors.emplace_back(i / 36.0f, 1.0f - i / 36.0f, i * 0.1f - 1.0f, 0.5f);
+    }
+    std::vector<ogf::Color32> packed(colors.size());
+    ogf::pack_colors(colors.data(), packed.data(), colors.size());
+    std::vector<ogf::Color> unpacked(colors.size());
+    ogf::unpack_colors(packed.data(), unpacked.data(), packed.size());
+    for(std::size_t i = 0; i < colors.size(); ++i) {
+        ASSERT_EQ(packed[i], ogf::Color32{colors[i]});
+        ASSERT_FLOAT_EQ(unpacked[i].r, packed[i].to_color().r);
+        ASSERT_FLOAT_EQ(unpacked[i].g, packed[i].to_color().g);
+        ASSERT_FLOAT_EQ(unpacked[i].b, packed[i].to_color().b);
+        ASSERT_FLOAT_EQ(unpacked[i].a, packed[i].to_color().a);
+    }
+    ASSERT_EQ(ogf::Color32{ogf::Color::WHITE}, ogf::Color32::WHITE);
+    ASSERT_EQ(packed[0].b, 0);
+    ASSERT_EQ(packed[36].b, 255);
+}
+
+TEST(color32, srgb_tables_match_transfer_function) {
+    std::vector<ogf::Color32> srgb{};
+    for(int value = 0; value < 256; ++value) {
+        const auto byte = static_cast<ogf::Uint8>(value);
+        srgb.emplace_back(byte, byte, byte, byte);
+    }
+    std::vector<ogf::Color> linear(srgb.size());
+    ogf::srgb_to_linear(srgb.data(), linear.data(), srgb.size());
+    std::vector<ogf::Color32> encoded(srgb.size());
+    ogf::linear_to_srgb(linear.data(), encoded.data(), linear.size());
+    for(int value = 0; value < 256; ++value) {
+        ASSERT_FLOAT_EQ(linear[value].r, ogf::srgb_to_linear(value / 255.0f));
+        ASSERT_FLOAT_EQ(linear[value].a, value / 255.0f);
+        ASSERT_EQ(encoded[value], srgb[value]);
+    }
+
+    // Every linear value is rounded to the nearest sRGB value, also where the curve is steepest.
+    std::vector<ogf::Color> ramp{};
+    for(int i = 0; i <= 20000; ++i) {
+        const auto value = i / 20000.0f;
+        ramp.emplace_back(value, value * value, std::sqrt(value) - 0.25f, value);
+    }
+    std::vector<ogf::Color32> ramp_encoded(ramp.size());
+    ogf::linear_to_srgb(ramp.data(), ramp_encoded.data(), ramp.size());
+    const auto expected = [](const float value) {
+        const auto encoded = ogf::linear_to_srgb(std::fmax(value, 0.0f)) * 255.0;
+        return std::abs(encoded - std::floor(encoded) - 0.5) < 1e-3 ? -1 : static_cast<int>(encoded + 0.5);
+    };
+    for(std::size_t i = 0; i < ramp.size(); ++i) {
+        for(const auto& [value, encoded] : {std::make_pair(ramp[i].r, ramp_encoded[i].r),
+                std::make_pair(ramp[i].g, ramp_encoded[i].g), std::make_pair(ramp[i].b, ramp_encoded[i].b)}) {
+            const auto rounded = expected(value);
+            if(rounded >= 0) {
+                ASSERT_EQ(encoded, rounded);
+            }
+        }
+    }
+}
@@ -0,0 +1,43 @@
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include <glad/glad.h>
+
+#include <ogf/graphics/compute.hxx>
+#include <ogf/graphics/gl_extensions.hxx>
+#include <ogf/graphics/shader.hxx>
+
+#include "gl_context.hxx"
+
+TEST(compute, dispatched_invocations_write_storage_buffers) {
+    if(!make_test_gl_context_current(4, 3)) {
+        GTEST_SKIP() << "No OpenGL 4.3 context.";
+    }
+    ogf::Shader shader{};
+    shader.load_from_memory("#version 430\nlayout(local_size_x = 8) in;\n"
+            "layout(std430, binding = 0) buffer Values { uint values[]; };\n"
+            "void main() { values[gl_GlobalInvocationID.x] = gl_GlobalInvocationID.x + 1u; }\n",
+            ogf::ShaderType::COMPUTE);
+    ASSERT_EQ(shader.work_group_size()[0], 8u);
+    std::vector<unsigned int> values(32, 0);
+    GLuint buffer{};
+    glGenBuffers(1, &buffer);
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, buffer);
+    glBufferData(GL_SHADER_STORAGE_BUFFER, static_cast<GLsizeiptr>(values.size() * sizeof(unsigned int)),
+            values.data(), GL_DYNAMIC_READ);
+    ogf::bind_storage_buffer(0, buffer);
+    glUseProgram(shader.native_handle());
+    // 20 invocations round up to 3 groups of 8, the kernel doesn't skip the last 4 so they show the rounding.
+    shader.dispatch_invocations(20);
+    ogf::memory_barrier(ogf::Barrier::BUFFER_UPDATE);
+    glUseProgram(0);
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, buffer);
+    glGetBufferSubData(GL_SHADER_STORAGE_BUFFER, 0, static_cast<GLsizeiptr>(values.size() * sizeof(unsigned int)),
+            values.data());
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+    glDeleteBuffers(1, &buffer);
+    for(unsigned int i = 0; i < values.size(); ++i) {
+        ASSERT_EQ(values[i], i < 24 ? i + 1 : 0) << i;
+    }
+}
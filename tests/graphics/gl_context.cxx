@@ -0,0 +1,81 @@
+#include "gl_context.hxx"
+
+#include <cstring>
+
+#include <glad/glad.h>
+
+#include <ogf/graphics/gl_extensions.hxx>
+
+#if defined(OGF_TEST_EGL)
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+#endif
+
+namespace {
+
+    const char* hidden_function{nullptr};
+
+#if defined(OGF_TEST_EGL)
+    void* load_function(const char* name) {
+        if(hidden_function != nullptr && std::strcmp(name, hidden_function) == 0) {
+            return nullptr;
+        }
+        return reinterpret_cast<void*>(eglGetProcAddress(name));
+    }
+
+    // Surfaceless display, so no window system is needed.
+    EGLDisplay open_display() {
+        const auto extensions = eglQueryString(EGL_NO_DISPLAY, EGL_EXTENSIONS);
+        if(extensions != nullptr && std::strstr(extensions, "EGL_MESA_platform_surfaceless") != nullptr) {
+            const auto get_platform_display = reinterpret_cast<PFNEGLGETPLATFORMDISPLAYEXTPROC>(
+                    eglGetProcAddress("eglGetPlatformDisplayEXT"));
+            if(get_platform_display != nullptr) {
+                return get_platform_display(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, nullptr);
+            }
+        }
+        return eglGetDisplay(EGL_DEFAULT_DISPLAY);
+    }
+
+    bool create_context() {
+        const auto display = open_display();
+        if(display == EGL_NO_DISPLAY || !eglInitialize(display, nullptr, nullptr) || !eglBindAPI(EGL_OPENGL_API)) {
+            return false;
+        }
+        // Nothing is drawn to a surface, so the context needs no config, just EGL_KHR_no_config_context.
+        // Core profiles of a version include all later ones, so drivers give the newest they have.
+        const EGLint context_attributes[]{
+            EGL_CONTEXT_MAJOR_VERSION, 3, EGL_CONTEXT_MINOR_VERSION, 3,
+            EGL_CONTEXT_OPENGL_PROFILE_MASK, EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT, EGL_NONE
+        };
+        const auto context = eglCreateContext(display, EGL_NO_CONFIG_KHR, EGL_NO_CONTEXT, context_attributes);
+        if(context == EGL_NO_CONTEXT || !eglMakeCurrent(display, EGL_NO_SURFACE, EGL_NO_SURFACE, context)) {
+            return false;
+        }
+        if(!gladLoadGLLoader(load_function)) {
+            return false;
+        }
+        ogf::load_gl_extensions(load_function);
+        return true;
+    }
+#else
+    bool create_context() {
+        return false;
+    }
+#endif
+
+}
+
+bool make_test_gl_context_current(const int major, const int minor) {
+    static const bool created = create_context();
+    return created && ogf::has_gl_version(major, minor);
+}
+
+void reload_test_gl_extensions(const char* hidden_name) {
+#if defined(OGF_TEST_EGL)
+    hidden_function = hidden_name;
+    ogf::load_gl_extensions(load_function);
+    hidden_function = nullptr;
+#else
+    static_cast<void>(hidden_name);
+#endif
+}
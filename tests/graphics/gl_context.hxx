@@ -0,0 +1,10 @@
+#pragma once
+
+// Make a headless OpenGL core context of at least given version current on the calling thread and load glad and the
+// library's extensions for it. The context is created once and kept until the tests exit. Returns false if it can't be
+// created, e.g. on machines without EGL or a driver of that version, so tests needing it can be skipped. Mesa's
+// llvmpipe provides OpenGL 4.5 on machines without a GPU.
+bool make_test_gl_context_current(const int major, const int minor);
+
+// Load the library's extensions again, hiding entry points with given name, e.g. to test fallback paths.
+void reload_test_gl_extensions(const char* hidden_name = nullptr);
@@ -0,0 +1,236 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cstdint>
+#include <stdexcept>
+#include <tuple>
+
+#include <ogf/graphics/image.hxx>
+
+namespace {
+
+    bool same_color(const ogf::Color& left, const ogf::Color& right) {
+        const auto near = [](const float a, const float b) { return std::abs(a - b) < 0.5f / 255.0f; };
+        return near(left.r, right.r) && near(left.g, right.g) && near(left.b, right.b) && near(left.a, right.a);
+    }
+
+}
+
+TEST(image, pixel_round_trips_through_every_format) {
+    const ogf::Color color{0.25f, 0.5f, 0.75f, 0.6f};
+    for(unsigned int index = 0; index <= static_cast<unsigned int>(ogf::PixelFormat::RGBA32F); ++index) {
+        const auto format = static_cast<ogf::PixelFormat>(index);
+        ogf::Image image{};
+        image.create(3, 2, ogf::Color::BLACK, format);
+        image.set_pixel(2, 1, color);
+        const auto pixel = image.pixel(2, 1);
+        const auto channels = ogf::channel_count(format);
+        // One and two channel formats keep grey from red.
+        ASSERT_NEAR(pixel.r, color.r, 0.01f);
+        ASSERT_NEAR(pixel.g, channels >= 3 ? color.g : color.r, 0.01f);
+        ASSERT_NEAR(pixel.b, channels >= 3 ? color.b : color.r, 0.01f);
+        ASSERT_NEAR(pixel.a, channels % 2 == 0 ? color.a : 1.0f, 0.01f);
+        ASSERT_FLOAT_EQ(image.pixel(1, 1).r, 0.0f);
+    }
+}
+
+TEST(image, pixel_access_is_bounds_checked) {
+    ogf::Image image{};
+    image.create(2, 2);
+    ASSERT_THROW(image.set_pixel(2, 0, ogf::Color::WHITE), std::out_of_range);
+    ASSERT_THROW(image.pixel(0, 2), std::out_of_range);
+}
+
+TEST(image, convert_keeps_values) {
+    ogf::Image image{};
+    image.create(4, 4, ogf::Color{1.0f, 0.5f, 0.0f, 1.0f}, ogf::PixelFormat::RGB8);
+    image.convert(ogf::PixelFormat::RGBA16F);
+    ASSERT_EQ(image.format(), ogf::PixelFormat::RGBA16F);
+    const auto pixel = image.pixel(3, 3);
+    ASSERT_FLOAT_EQ(pixel.r, 1.0f);
+    ASSERT_NEAR(pixel.g, 0.5f, 0.002f);
+    ASSERT_FLOAT_EQ(pixel.a, 1.0f);
+    image.convert(ogf::PixelFormat::R8);
+    ASSERT_EQ(image.pixels()[0], 255);
+}
+
+TEST(image, files_keep_native_format) {
+    const auto directory = testing::TempDir();
+    ogf::Image image{};
+    image.create(5, 3, ogf::Color{0.3f, 0.0f, 0.0f}, ogf::PixelFormat::R8);
+    image.save_to_file(directory + "image_r8.png");
+    ogf::Image loaded{};
+    loaded.load_from_file(directory + "image_r8.png");
+    ASSERT_EQ(loaded.format(), ogf::PixelFormat::R8);
+    ASSERT_EQ(loaded.pixels()[2 * loaded.stride() + 4], image.pixels()[2 * image.stride() + 4]);
+
+    image.create(5, 3, ogf::Color{0.1234f, 0.5f, 0.9f, 0.25f}, ogf::PixelFormat::RGBA16);
+    image.save_to_file(directory + "image_rgba16.png");
+    loaded.load_from_file(directory + "image_rgba16.png");
+    ASSERT_EQ(loaded.format(), ogf::PixelFormat::RGBA16);
+    ASSERT_NEAR(loaded.pixel(4, 2).r, 0.1234f, 1.0f / 65535.0f);
+
+    image.create(5, 3, ogf::Color{4.0f, 0.5f, 0.25f}, ogf::PixelFormat::RGB32F);
+    image.save_to_file(directory + "image_rgb32f.hdr");
+    loaded.load_from_file(directory + "image_rgb32f.hdr");
+    ASSERT_EQ(loaded.format(), ogf::PixelFormat::RGB32F);
+    ASSERT_NEAR(loaded.pixel(4, 2).r, 4.0f, 0.05f);
+}
+
+TEST(image, grey_alpha_files_convert_to_rgba) {
+    const auto directory = testing::TempDir();
+    ogf::Image image{};
+    image.create(3, 2, ogf::Color{0.4f, 0.4f, 0.4f, 0.5f}, ogf::PixelFormat::RG8);
+    image.save_to_file(directory + "image_rg8.png");
+    ogf::Image loaded{};
+    loaded.load_from_file(directory + "image_rg8.png");
+    ASSERT_EQ(loaded.format(), ogf::PixelFormat::RG8);
+    loaded.convert(ogf::PixelFormat::RGBA8);
+    const auto pixel = loaded.pixels() + loaded.stride() + 2 * 4;
+    ASSERT_EQ(pixel[0], 102);
+    ASSERT_EQ(pixel[1], 102);
+    ASSERT_EQ(pixel[2], 102);
+    ASSERT_EQ(pixel[3], 128);
+}
+
+TEST(image, rows_are_aligned) {
+    for(const auto format : {ogf::PixelFormat::R8, ogf::PixelFormat::RGB8, ogf::PixelFormat::RGB16F}) {
+        ogf::Image image{};
+        image.create(37, 3, ogf::Color::BLACK, format);
+        ASSERT_EQ(reinterpret_cast<std::uintptr_t>(image.pixels()) % ogf::Image::ROW_ALIGNMENT, 0u);
+        ASSERT_EQ(image.stride() % ogf::Image::ROW_ALIGNMENT, 0u);
+        ASSERT_EQ(image.stride() % ogf::pixel_size(format), 0u);
+        ASSERT_GE(image.stride(), 37 * ogf::pixel_size(format));
+    }
+}
+
+TEST(image, fill_is_clipped) {
+    ogf::Image image{};
+    image.create(300, 200);
+    image.fill(ogf::RectU{250, 150, 100, 100}, ogf::Color::WHITE);
+    ASSERT_TRUE(same_color(image.pixel(249, 199), ogf::Color::BLACK));
+    ASSERT_TRUE(same_color(image.pixel(250, 150), ogf::Color::WHITE));
+    ASSERT_TRUE(same_color(image.pixel(299, 199), ogf::Color::WHITE));
+}
+
+TEST(image, blit_is_clipped_and_converts) {
+    ogf::Image source{};
+    source.create(4, 4, ogf::Color{1.0f, 0.0f, 0.0f, 1.0f}, ogf::PixelFormat::RGB16);
+    source.set_pixel(3, 3, ogf::Color::WHITE);
+    ogf::Image target{};
+    target.create(8, 8);
+    target.blit(source, -2, 6);
+    ASSERT_TRUE(same_color(target.pixel(0, 6), ogf::Color{1.0f, 0.0f, 0.0f, 1.0f}));
+    ASSERT_TRUE(same_color(target.pixel(1, 7), ogf::Color{1.0f, 0.0f, 0.0f, 1.0f}));
+    ASSERT_TRUE(same_color(target.pixel(2, 6), ogf::Color::BLACK));
+    ASSERT_TRUE(same_color(target.pixel(0, 5), ogf::Color::BLACK));
+    target.blit(target, 7, 7);
+    ASSERT_TRUE(same_color(target.pixel(7, 7), ogf::Color::BLACK));
+}
+
+TEST(image, views_share_pixels) {
+    ogf::Image image{};
+    image.create(8, 6);
+    image.set_pixel(5, 4, ogf::Color::WHITE);
+    const auto part = image.view(ogf::RectU{3, 2, 4, 3});
+    ASSERT_EQ(part.size(), std::make_tuple(4u, 3u));
+    ASSERT_EQ(part.stride, image.stride());
+    ASSERT_EQ(part.row(2) + 2 * 4, image.pixels() + 4 * image.stride() + 5 * 4);
+    ASSERT_THROW(image.view(ogf::RectU{3, 2, 6, 3}), std::out_of_range);
+    ASSERT_THROW(part.subview(ogf::RectU{0, 3, 1, 1}), std::out_of_range);
+    ogf::Image cropped{};
+    cropped.create(part);
+    ASSERT_EQ(cropped.size(), std::make_tuple(4u, 3u));
+    ASSERT_TRUE(same_color(cropped.pixel(2, 2), ogf::Color::WHITE));
+    ASSERT_TRUE(same_color(cropped.pixel(1, 1), ogf::Color::BLACK));
+}
+
+TEST(image, blit_from_overlapping_view) {
+    ogf::Image image{};
+    image.create(4, 1);
+    for(unsigned int x = 0; x < 4; ++x) {
+        image.set_pixel(x, 0, ogf::Color{x / 5.0f, 0.0f, 0.0f, 1.0f});
+    }
+    image.blit(image.view(ogf::RectU{0, 0, 3, 1}), 1, 0);
+    for(unsigned int x = 1; x < 4; ++x) {
+        ASSERT_TRUE(same_color(image.pixel(x, 0), ogf::Color{(x - 1) / 5.0f, 0.0f, 0.0f, 1.0f}));
+    }
+    image.create(image.view(ogf::RectU{2, 0, 2, 1}));
+    ASSERT_EQ(image.size(), std::make_tuple(2u, 1u));
+    ASSERT_TRUE(same_color(image.pixel(1, 0), ogf::Color{0.4f, 0.0f, 0.0f, 1.0f}));
+}
+
+TEST(image, swizzle_and_premultiply) {
+    ogf::Image image{};
+    image.create(67, 5, ogf::Color{1.0f, 0.0f, 0.0f, 0.0f});
+    image.set_pixel(66, 4, ogf::Color{0.0f, 1.0f, 0.0f, 1.0f});
+    image.swizzle({3, 1, 2, 0});
+    ASSERT_TRUE(same_color(image.pixel(0, 0), ogf::Color{0.0f, 0.0f, 0.0f, 1.0f}));
+    ASSERT_TRUE(same_color(image.pixel(66, 4), ogf::Color{1.0f, 1.0f, 0.0f, 0.0f}));
+    image.premultiply_alpha();
+    ASSERT_TRUE(same_color(image.pixel(0, 0), ogf::Color{0.0f, 0.0f, 0.0f, 1.0f}));
+    ASSERT_TRUE(same_color(image.pixel(66, 4), ogf::Color{0.0f, 0.0f, 0.0f, 0.0f}));
+    ASSERT_THROW(image.swizzle({0, 1, 2, 4}), std::runtime_error);
+}
+
+TEST(image, flips_mirror_pixels) {
+    for(const auto format : {ogf::PixelFormat::RGBA8, ogf::PixelFormat::RGB8, ogf::PixelFormat::RG32F}) {
+        ogf::Image image{};
+        image.create(45, 3, ogf::Color::BLACK, format);
+        image.set_pixel(1, 0, ogf::Color{1.0f, 1.0f, 0.0f, 1.0f});
+        image.flip_horizontally();
+        ASSERT_EQ(image.pixel(43, 0).r, 1.0f);
+        ASSERT_EQ(image.pixel(1, 0).r, 0.0f);
+        image.flip_vertically();
+        ASSERT_EQ(image.pixel(43, 2).r, 1.0f);
+        ASSERT_EQ(image.pixel(43, 0).r, 0.0f);
+    }
+}
+
+TEST(image, blend_over_uses_premultiplied_alpha) {
+    ogf::Image target{};
+    target.create(40, 2, ogf::Color{0.0f, 0.0f, 1.0f, 1.0f});
+    ogf::Image source{};
+    source.create(40, 2, ogf::Color{0.5f, 0.0f, 0.0f, 0.5f});
+    target.blend_over(source, 0, 0);
+    for(const auto x : {0u, 17u, 39u}) {
+        const auto pixel = target.pixel(x, 1);
+        ASSERT_NEAR(pixel.r, 0.5f, 0.01f);
+        ASSERT_NEAR(pixel.b, 0.5f, 0.01f);
+        ASSERT_FLOAT_EQ(pixel.a, 1.0f);
+    }
+}
+
+TEST(image, resize_keeps_uniform_color) {
+    for(const auto filter : {ogf::ResizeFilter::BOX, ogf::ResizeFilter::BILINEAR, ogf::ResizeFilter::MITCHELL,
+            ogf::ResizeFilter::LANCZOS3}) {
+        ogf::Image image{};
+        image.create(97, 41, ogf::Color{0.2f, 0.4f, 0.6f, 0.8f});
+        image.resize(30, 77, filter);
+        ASSERT_EQ(image.size(), std::make_tuple(30u, 77u));
+        for(const auto& [x, y] : {std::make_tuple(0u, 0u), std::make_tuple(15u, 40u), std::make_tuple(29u, 76u)}) {
+            ASSERT_TRUE(same_color(image.pixel(x, y), ogf::Color{0.2f, 0.4f, 0.6f, 0.8f}));
+        }
+    }
+}
+
+TEST(image, resize_filters_in_linear_light) {
+    ogf::Image image{};
+    image.create(2, 1, ogf::Color::BLACK, ogf::PixelFormat::RGB8);
+    image.set_pixel(1, 0, ogf::Color::WHITE);
+    image.resize(1, 1, ogf::ResizeFilter::BOX);
+    // Half of the light of white is 188 in sRGB, not 128.
+    ASSERT_EQ(image.pixels()[0], 188);
+}
+
+TEST(image, resize_ignores_color_of_transparent_pixels) {
+    ogf::Image image{};
+    image.create(2, 2, ogf::Color{1.0f, 0.0f, 0.0f, 1.0f});
+    image.set_pixel(1, 0, ogf::Color{0.0f, 1.0f, 0.0f, 0.0f});
+    image.set_pixel(1, 1, ogf::Color{0.0f, 1.0f, 0.0f, 0.0f});
+    image.resize(1, 1, ogf::ResizeFilter::BOX);
+    const auto pixel = image.pixel(0, 0);
+    ASSERT_FLOAT_EQ(pixel.r, 1.0f);
+    ASSERT_FLOAT_EQ(pixel.g, 0.0f);
+    ASSERT_NEAR(pixel.a, 0.5f, 0.01f);
+}
@@ -0,0 +1,78 @@
+#include <gtest/gtest.h>
+
+#include <map>
+#include <stdexcept>
+#include <string>
+
+#include <ogf/graphics/image.hxx>
+#include <ogf/graphics/image_batch_loader.hxx>
+
+namespace {
+
+    // Save an RGBA8 image whose width tells it apart from the others.
+    std::string save_image(const std::string& name, const unsigned int width) {
+        const auto filename = testing::TempDir() + name;
+        ogf::Image image{};
+        image.create(width, 32, ogf::Color{0.25f, 0.5f, 0.75f, 1.0f});
+        image.save_to_file(filename);
+        return filename;
+    }
+
+}
+
+TEST(image_batch_loader, defers_files_over_budget_until_collected) {
+    std::map<std::string, unsigned int> widths{};
+    for(unsigned int i = 0; i < 6; ++i) {
+        widths[save_image("image_batch_loader_" + std::to_string(i) + ".png", 16 + i)] = 16 + i;
+    }
+    // Room for a single image, so every other file waits for the previous one to be collected. A budget smaller than
+    // an image still lets one through at a time.
+    for(const std::size_t budget : {std::size_t{32 * 32 * 4}, std::size_t{1}}) {
+        ogf::ImageBatchLoader loader{budget};
+        for(const auto& [filename, width] : widths) {
+            loader.add(filename);
+        }
+        ASSERT_EQ(loader.pending(), widths.size());
+        auto remaining = widths;
+        std::string filename{};
+        ogf::Image image{};
+        while(loader.wait_next(filename, image)) {
+            const auto file = remaining.find(filename);
+            ASSERT_NE(file, remaining.end()) << filename;
+            ASSERT_EQ(image.size(), std::make_tuple(file->second, 32u));
+            remaining.erase(file);
+            ASSERT_EQ(loader.pending(), remaining.size());
+        }
+        ASSERT_TRUE(remaining.empty());
+        ASSERT_FALSE(loader.poll_next(filename, image));
+    }
+}
+
+TEST(image_batch_loader, starts_deferred_files_after_errors) {
+    const auto first = save_image("image_batch_loader_first.png", 24);
+    const auto missing = testing::TempDir() + "image_batch_loader_missing.png";
+    const auto last = save_image("image_batch_loader_last.png", 40);
+    ogf::ImageBatchLoader loader{1};
+    loader.add(first);
+    loader.add(missing);
+    loader.add(last);
+    unsigned int loaded{0}, failed{0};
+    std::string filename{};
+    ogf::Image image{};
+    while(true) {
+        try {
+            if(!loader.wait_next(filename, image)) {
+                break;
+            }
+            ASSERT_TRUE(filename == first || filename == last) << filename;
+            ++loaded;
+        } catch(const std::runtime_error&) {
+            // The failed file is collected too, so the files deferred behind it still start.
+            ASSERT_EQ(filename, missing);
+            ++failed;
+        }
+    }
+    ASSERT_EQ(loaded, 2u);
+    ASSERT_EQ(failed, 1u);
+    ASSERT_EQ(loader.pending(), 0u);
+}
@@ -0,0 +1,119 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include <vector>
+
+#include <ogf/graphics/image.hxx>
+#include <ogf/graphics/mipmaps.hxx>
+
+TEST(mipmaps, chain_goes_down_to_one_pixel) {
+    ogf::Image image{};
+    image.create(5, 3);
+    const auto mipmaps = ogf::generate_mipmaps(image);
+    ASSERT_EQ(mipmaps.size(), 2u);
+    ASSERT_EQ(mipmaps[0].size(), std::make_tuple(2u, 1u));
+    ASSERT_EQ(mipmaps[1].size(), std::make_tuple(1u, 1u));
+}
+
+TEST(mipmaps, uniform_color_is_preserved) {
+    ogf::Image image{};
+    image.create(64, 32, ogf::Color{0.2f, 0.4f, 0.6f, 0.8f});
+    for(const auto filter : {ogf::MipmapFilter::BOX, ogf::MipmapFilter::KAISER}) {
+        const auto mipmaps = ogf::generate_mipmaps(image, filter);
+        for(const auto& mipmap : mipmaps) {
+            const auto [width, height] = mipmap.size();
+            for(unsigned int y = 0; y < height; ++y) {
+                for(unsigned int i = 0; i < width * 4; ++i) {
+                    ASSERT_NEAR(mipmap.pixels()[y * mipmap.stride() + i], image.pixels()[i % 4], 1);
+                }
+            }
+        }
+    }
+}
+
+TEST(mipmaps, box_filter_is_gamma_correct) {
+    ogf::Image image{};
+    image.create(2, 1, ogf::Color::BLACK);
+    for(unsigned int i = 4; i < 7; ++i) {
+        image.pixels()[i] = 255;
+    }
+    const auto linear = ogf::generate_mipmaps(image, ogf::MipmapFilter::BOX, false);
+    ASSERT_EQ(linear[0].pixels()[0], 128);
+    // Half of the light of white is 188 in sRGB, not 128.
+    const auto srgb = ogf::generate_mipmaps(image, ogf::MipmapFilter::BOX, true);
+    ASSERT_EQ(srgb[0].pixels()[0], 188);
+    ASSERT_EQ(srgb[0].pixels()[3], 255);
+}
+
+TEST(mipmaps, transparent_pixels_do_not_bleed) {
+    // Checkerboard of transparent black and opaque white.
+    ogf::Image image{};
+    image.create(8, 8);
+    for(unsigned int y = 0; y < 8; ++y) {
+        for(unsigned int x = 0; x < 8; ++x) {
+            image.set_pixel(x, y, (x + y) % 2 == 0 ? ogf::Color{0.0f, 0.0f, 0.0f, 0.0f} : ogf::Color::WHITE);
+        }
+    }
+    for(const auto filter : {ogf::MipmapFilter::BOX, ogf::MipmapFilter::KAISER}) {
+        const auto mipmaps = ogf::generate_mipmaps(image, filter);
+        const auto [width, height] = mipmaps[0].size();
+        for(unsigned int y = 0; y < height; ++y) {
+            for(unsigned int x = 0; x < width; ++x) {
+                const auto* pixel = mipmaps[0].pixels() + y * mipmaps[0].stride() + x * 4;
+                ASSERT_GE(pixel[0], 254);
+                ASSERT_GE(pixel[1], 254);
+                ASSERT_GE(pixel[2], 254);
+                // The Kaiser filter rings a little on the checkerboard.
+                ASSERT_NEAR(pixel[3], 128, filter == ogf::MipmapFilter::BOX ? 1 : 8);
+            }
+        }
+    }
+}
+
+TEST(mipmaps, cache_round_trip) {
+    ogf::Image image{};
+    image.create(16, 8, ogf::Color{0.1f, 0.5f, 0.9f, 1.0f});
+    const auto mipmaps = ogf::generate_mipmaps(image, ogf::MipmapFilter::KAISER);
+    const auto filename = testing::TempDir() + "mipmaps.cache";
+    ogf::save_mipmaps_to_file(filename, mipmaps);
+    const auto loaded = ogf::load_mipmaps_from_file(filename);
+    ASSERT_EQ(loaded.size(), mipmaps.size());
+    for(std::size_t level = 0; level < loaded.size(); ++level) {
+        const auto [width, height] = mipmaps[level].size();
+        ASSERT_EQ(loaded[level].size(), mipmaps[level].size());
+        for(unsigned int y = 0; y < height; ++y) {
+            const auto row = mipmaps[level].pixels() + y * mipmaps[level].stride();
+            ASSERT_TRUE(std::equal(row, row + width * 4, loaded[level].pixels() + y * loaded[level].stride()));
+        }
+    }
+}
+
+TEST(mipmaps, cache_rejects_corrupted_sizes) {
+    ogf::Image image{};
+    image.create(16, 8);
+    const auto filename = testing::TempDir() + "mipmaps_corrupted.cache";
+    ogf::save_mipmaps_to_file(filename, ogf::generate_mipmaps(image));
+    std::vector<char> data{};
+    {
+        std::ifstream file{filename, std::ios::binary};
+        data.assign(std::istreambuf_iterator<char>{file}, std::istreambuf_iterator<char>{});
+    }
+    const auto check = [&](const std::size_t offset, const ogf::Uint32 value, const std::size_t size) {
+        auto corrupted = data;
+        corrupted.resize(size);
+        std::memcpy(corrupted.data() + offset, &value, sizeof(value));
+        std::ofstream{filename, std::ios::binary}.write(corrupted.data(), static_cast<std::streamsize>(size));
+        ASSERT_THROW(ogf::load_mipmaps_from_file(filename), std::runtime_error);
+    };
+    // The first level is 8x4 and follows the magic and the level count.
+    constexpr std::size_t first_level = 12;
+    check(first_level, 0x40000000, data.size());
+    check(first_level + 4, 0x40000000, data.size());
+    // The second level must be 4x2.
+    check(first_level + 12 + 8 * 4 * 4, 3, data.size());
+    check(first_level, 8, data.size() - 1);
+}
@@ -0,0 +1,43 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <limits>
+
+#include <ogf/graphics/pixel_conversion.hxx>
+
+TEST(pixel_conversion, half_float_round_trip) {
+    for(const auto value : {0.0f, -0.0f, 1.0f, -2.5f, 0.1f, 65504.0f, 6.1035156e-5f, 5.9604645e-8f}) {
+        ASSERT_NEAR(ogf::half_to_float(ogf::float_to_half(value)), value, std::abs(value) / 1024.0f);
+    }
+    ASSERT_EQ(ogf::float_to_half(1.0f), 0x3C00);
+    ASSERT_EQ(ogf::float_to_half(100000.0f), 0x7C00);
+    ASSERT_TRUE(std::isnan(ogf::half_to_float(ogf::float_to_half(std::numeric_limits<float>::quiet_NaN()))));
+}
+
+TEST(pixel_conversion, grey_fills_color_channels) {
+    const ogf::Uint8 source[]{10, 20};
+    ogf::Uint8 target[8]{};
+    ogf::convert_pixels(source, ogf::PixelFormat::R8, target, ogf::PixelFormat::RGBA8, 2);
+    const ogf::Uint8 expected[]{10, 10, 10, 255, 20, 20, 20, 255};
+    for(int i = 0; i < 8; ++i) {
+        ASSERT_EQ(target[i], expected[i]);
+    }
+    float rgba[4]{};
+    ogf::decode_pixels(source, ogf::PixelFormat::RG8, rgba, 1);
+    ASSERT_FLOAT_EQ(rgba[1], 10.0f / 255.0f);
+    ASSERT_FLOAT_EQ(rgba[3], 20.0f / 255.0f);
+    ogf::Uint8 encoded[2]{};
+    ogf::encode_pixels(rgba, encoded, ogf::PixelFormat::RG8, 1);
+    ASSERT_EQ(encoded[0], 10);
+    ASSERT_EQ(encoded[1], 20);
+}
+
+TEST(pixel_conversion, floats_are_clamped_to_normalized_range) {
+    const float source[]{-1.0f, 0.5f, 2.0f};
+    ogf::Uint8 target[3]{};
+    ogf::convert_pixels(reinterpret_cast<const ogf::Uint8*>(source), ogf::PixelFormat::RGB32F, target,
+            ogf::PixelFormat::RGB8, 1);
+    ASSERT_EQ(target[0], 0);
+    ASSERT_EQ(target[1], 128);
+    ASSERT_EQ(target[2], 255);
+}
@@ -0,0 +1,91 @@
+#include <gtest/gtest.h>
+
+#include <future>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <ogf/graphics/image.hxx>
+#include <ogf/graphics/resource_cache.hxx>
+#include <ogf/graphics/texture.hxx>
+
+#include "gl_context.hxx"
+
+namespace {
+
+    std::string save_image(const std::string& name, const ogf::Color& color) {
+        const auto filename = testing::TempDir() + name;
+        ogf::Image image{};
+        image.create(16, 8, color);
+        image.save_to_file(filename);
+        return filename;
+    }
+
+}
+
+TEST(resource_cache, shares_images_by_path_and_content) {
+    const auto filename = save_image("resource_cache_a.png", ogf::Color{0.25f, 0.5f, 0.75f, 1.0f});
+    const auto copy = save_image("resource_cache_b.png", ogf::Color{0.25f, 0.5f, 0.75f, 1.0f});
+    const auto other = save_image("resource_cache_c.png", ogf::Color{1.0f, 0.0f, 0.0f, 1.0f});
+    ogf::ResourceCache cache{};
+    std::vector<std::shared_future<std::shared_ptr<const ogf::Image>>> loads{};
+    for(int i = 0; i < 8; ++i) {
+        loads.push_back(cache.load_image_async(filename));
+    }
+    const auto image = cache.load_image(filename);
+    for(const auto& load : loads) {
+        ASSERT_EQ(load.get(), image);
+    }
+    ASSERT_EQ(cache.load_image(testing::TempDir() + "./resource_cache_a.png"), image);
+    ASSERT_EQ(cache.load_image(copy), image);
+    ASSERT_NE(cache.load_image(other), image);
+    ASSERT_EQ(image->size(), std::make_tuple(16u, 8u));
+}
+
+TEST(resource_cache, evicts_unused_images_over_budget) {
+    const auto first = save_image("resource_cache_d.png", ogf::Color{0.0f, 1.0f, 0.0f, 1.0f});
+    const auto second = save_image("resource_cache_e.png", ogf::Color{0.0f, 0.0f, 1.0f, 1.0f});
+    ogf::ResourceCache cache{1};
+    auto image = cache.load_image(first);
+    const auto used = cache.memory_usage();
+    ASSERT_GT(used, 0u);
+    cache.load_image(second);
+    ASSERT_EQ(cache.memory_usage(), 2 * used);
+    cache.trim();
+    ASSERT_EQ(cache.memory_usage(), used);
+    ASSERT_EQ(cache.load_image(first), image);
+    image.reset();
+    cache.trim();
+    ASSERT_EQ(cache.memory_usage(), 0u);
+}
+
+TEST(resource_cache, reports_load_errors) {
+    ogf::ResourceCache cache{};
+    ASSERT_THROW(cache.load_image("/some/funny/missing/file.png"), std::runtime_error);
+}
+
+TEST(resource_cache, texture_loads_leave_no_images_behind) {
+    if(!make_test_gl_context_current(3, 3)) {
+        GTEST_SKIP() << "No OpenGL 3.3 context.";
+    }
+    const auto filename = save_image("resource_cache_f.png", ogf::Color{1.0f, 1.0f, 0.0f, 1.0f});
+    ogf::Image image{};
+    image.load_from_file(filename);
+    const auto texture_bytes = image.stride() * std::get<1>(image.size()) * 4 / 3;
+    {
+        ogf::ResourceCache cache{};
+        const auto texture = cache.load_texture(filename);
+        ASSERT_NE(texture->native_handle(), 0u);
+        // Only the texture counts, the image it was made from is gone.
+        ASSERT_EQ(cache.memory_usage(), texture_bytes);
+        ASSERT_EQ(cache.load_texture(filename), texture);
+    }
+    {
+        // An image which is cached already is used for the upload and stays.
+        ogf::ResourceCache cache{};
+        const auto cached = cache.load_image(filename);
+        const auto image_bytes = cache.memory_usage();
+        cache.load_texture(filename);
+        ASSERT_EQ(cache.memory_usage(), image_bytes + texture_bytes);
+    }
+}
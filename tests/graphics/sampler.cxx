@@ -0,0 +1,39 @@
+#include <gtest/gtest.h>
+
+#include <set>
+
+#include <ogf/graphics/sampler.hxx>
+
+TEST(sampler, descriptors_pack_to_distinct_keys) {
+    std::set<ogf::Uint32> keys{};
+    std::size_t count{0};
+    for(unsigned int filter = 0; filter < 4; ++filter) {
+        for(unsigned int mode = 0; mode < 3; ++mode) {
+            for(unsigned int wrap = 0; wrap < 16; ++wrap) {
+                for(const auto anisotropy : {1u, 2u, 16u}) {
+                    ogf::SamplerDescriptor descriptor{};
+                    descriptor.min_filter = static_cast<ogf::SamplerFilter>(filter & 1);
+                    descriptor.mag_filter = static_cast<ogf::SamplerFilter>(filter >> 1);
+                    descriptor.mipmap_mode = static_cast<ogf::SamplerMipmapMode>(mode);
+                    descriptor.wrap_s = static_cast<ogf::SamplerWrap>(wrap & 3);
+                    descriptor.wrap_t = static_cast<ogf::SamplerWrap>(wrap >> 2);
+                    descriptor.max_anisotropy = anisotropy;
+                    keys.insert(descriptor.pack());
+                    ++count;
+                }
+            }
+        }
+    }
+    ASSERT_EQ(keys.size(), count);
+}
+
+TEST(sampler, anisotropy_is_clamped) {
+    ogf::SamplerDescriptor low{}, high{};
+    low.max_anisotropy = 0;
+    high.max_anisotropy = 64;
+    ASSERT_EQ(low, ogf::SamplerDescriptor{});
+    ogf::SamplerDescriptor sixteen{};
+    sixteen.max_anisotropy = 16;
+    ASSERT_EQ(high, sixteen);
+    ASSERT_NE(low, high);
+}
@@ -0,0 +1,227 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <glad/glad.h>
+
+#include <ogf/graphics/gl_extensions.hxx>
+#include <ogf/graphics/shader.hxx>
+
+#include "gl_context.hxx"
+
+TEST(shader, uniform_names_hash_at_compile_time) {
+    constexpr ogf::UniformName name{"ogf_vt_size"};
+    static_assert(name.hash == ogf::UniformName{std::string_view{"ogf_vt_size"}}.hash);
+    const std::string runtime_name{"ogf_vt_size"};
+    ASSERT_EQ(ogf::UniformName{runtime_name}.hash, name.hash);
+    ASSERT_NE(ogf::UniformName{"ogf_vt_tile"}.hash, name.hash);
+    ASSERT_NE(ogf::UniformName{""}.hash, name.hash);
+}
+
+namespace {
+
+    const char* const VERTEX_SOURCE = "#version 330 core\n"
+            "uniform vec2 offset;\n"
+            "void main() { gl_Position = vec4(vec2(gl_VertexID % 2, gl_VertexID / 2) + offset, 0.0, 1.0); }\n";
+
+    const char* const FRAGMENT_SOURCE = "#version 330 core\n"
+            "uniform vec4 tint;\n"
+            "out vec4 color;\n"
+            "void main() { color = tint; }\n";
+
+    // Files in the directory with the time they were last written.
+    std::vector<std::pair<std::string, std::filesystem::file_time_type>> list_files(const std::string& directory) {
+        std::vector<std::pair<std::string, std::filesystem::file_time_type>> files{};
+        for(const auto& entry : std::filesystem::directory_iterator{directory}) {
+            files.emplace_back(entry.path().string(), entry.last_write_time());
+        }
+        return files;
+    }
+
+}
+
+TEST(shader, binary_cache_stores_and_loads_programs) {
+    if(!make_test_gl_context_current(3, 3)) {
+        GTEST_SKIP() << "No OpenGL 3.3 context.";
+    }
+    if(!ogf::has_program_binary()) {
+        GTEST_SKIP() << "No program binary formats.";
+    }
+    const auto directory = testing::TempDir() + "shader_binary_cache";
+    std::filesystem::remove_all(directory);
+    ogf::Shader::set_binary_cache_directory(directory);
+    {
+        // A miss compiles the sources and writes the binary.
+        ogf::Shader shader{};
+        shader.load_from_memory(VERTEX_SOURCE, FRAGMENT_SOURCE);
+        ASSERT_GE(shader.uniform_location("tint"), 0);
+    }
+    auto files = list_files(directory);
+    ASSERT_EQ(files.size(), 1u);
+    const auto filename = files[0].first;
+    // Backdated, so a rewrite shows up as a newer time.
+    const auto old_time = files[0].second - std::chrono::hours{1};
+    std::filesystem::last_write_time(filename, old_time);
+    {
+        // A hit loads the program without writing anything.
+        ogf::Shader shader{};
+        shader.load_from_memory(VERTEX_SOURCE, FRAGMENT_SOURCE);
+        ASSERT_GE(shader.uniform_location("tint"), 0);
+        ASSERT_GE(shader.uniform_location("offset"), 0);
+    }
+    files = list_files(directory);
+    ASSERT_EQ(files.size(), 1u);
+    ASSERT_EQ(files[0].second, old_time);
+
+    // A binary the driver rejects is compiled again and replaced.
+    std::vector<char> data{};
+    {
+        std::ifstream file{filename, std::ios::binary};
+        data.assign(std::istreambuf_iterator<char>{file}, std::istreambuf_iterator<char>{});
+    }
+    ASSERT_GT(data.size(), 64u);
+    // The header of magic, key and format is kept, the binary after it is garbage.
+    for(std::size_t i = 28; i < data.size(); ++i) {
+        data[i] = static_cast<char>(i * 13);
+    }
+    std::ofstream{filename, std::ios::binary | std::ios::trunc}.write(data.data(),
+            static_cast<std::streamsize>(data.size()));
+    std::filesystem::last_write_time(filename, old_time);
+    {
+        ogf::Shader shader{};
+        shader.load_from_memory(VERTEX_SOURCE, FRAGMENT_SOURCE);
+        ASSERT_GE(shader.uniform_location("tint"), 0);
+    }
+    files = list_files(directory);
+    ASSERT_EQ(files.size(), 1u);
+    ASSERT_NE(files[0].second, old_time);
+    ogf::Shader::set_binary_cache_directory("");
+    std::filesystem::remove_all(directory);
+}
+
+TEST(shader, async_compile_reports_errors_on_wait) {
+    if(!make_test_gl_context_current(3, 3)) {
+        GTEST_SKIP() << "No OpenGL 3.3 context.";
+    }
+    ogf::Shader shader{};
+    shader.load_from_memory_async(VERTEX_SOURCE, "#version 330 core\nout vec4 color;\nvoid main() { color = 1; }\n");
+    try {
+        shader.wait();
+        FAIL() << "The compile error wasn't reported.";
+    } catch(const std::runtime_error& error) {
+        ASSERT_NE(std::string{error.what()}.find("fragment"), std::string::npos) << error.what();
+    }
+    ASSERT_EQ(shader.native_handle(), 0u);
+    ASSERT_TRUE(shader.is_ready());
+    // A good program can be loaded into the same shader afterwards, and is waited for when it's used.
+    shader.load_from_memory_async(VERTEX_SOURCE, FRAGMENT_SOURCE);
+    ASSERT_FALSE(shader.bind_uniform_block("missing", 0));
+    ASSERT_TRUE(shader.is_ready());
+    ASSERT_NE(shader.native_handle(), 0u);
+    ASSERT_GE(shader.uniform_location("tint"), 0);
+}
+
+TEST(shader, reflects_uniforms_and_blocks) {
+    if(!make_test_gl_context_current(3, 3)) {
+        GTEST_SKIP() << "No OpenGL 3.3 context.";
+    }
+    ogf::Shader shader{};
+    shader.load_from_memory(VERTEX_SOURCE, "#version 330 core\n"
+            "uniform float weights[3];\n"
+            "layout(std140) uniform Lights { vec4 light_colors[4]; };\n"
+            "out vec4 color;\n"
+            "void main() { color = light_colors[1] * (weights[0] + weights[2]); }\n");
+    const auto program = shader.native_handle();
+    // Arrays are named without the index and refer to their first element.
+    ASSERT_GE(shader.uniform_location("weights"), 0);
+    ASSERT_EQ(shader.uniform_location("weights"), glGetUniformLocation(program, "weights[0]"));
+    ASSERT_EQ(shader.uniform_location("offset"), glGetUniformLocation(program, "offset"));
+    // Block members have no location of their own.
+    ASSERT_EQ(shader.uniform_location("light_colors"), -1);
+    ASSERT_EQ(shader.uniform_location("missing"), -1);
+    ASSERT_EQ(shader.uniform_block_size("Lights"), 64u);
+    ASSERT_EQ(shader.uniform_block_size("missing"), 0u);
+    ASSERT_TRUE(shader.bind_uniform_block("Lights", 3));
+    ASSERT_FALSE(shader.bind_uniform_block("missing", 3));
+    GLint binding{-1};
+    glGetActiveUniformBlockiv(program, glGetUniformBlockIndex(program, "Lights"), GL_UNIFORM_BLOCK_BINDING, &binding);
+    ASSERT_EQ(binding, 3);
+}
+
+TEST(shader, setters_upload_changed_values) {
+    if(!make_test_gl_context_current(3, 3)) {
+        GTEST_SKIP() << "No OpenGL 3.3 context.";
+    }
+    ogf::Shader shader{};
+    shader.load_from_memory(VERTEX_SOURCE, "#version 330 core\n"
+            "uniform int count;\n"
+            "uniform uint mask;\n"
+            "uniform float scale;\n"
+            "uniform vec3 direction;\n"
+            "uniform vec4 tint;\n"
+            "uniform mat4 transform;\n"
+            "out vec4 color;\n"
+            "void main() {\n"
+            "    color = transform * tint * scale * float(count) * float(mask) + vec4(direction, 0.0);\n"
+            "}\n");
+    const auto program = shader.native_handle();
+    glUseProgram(program);
+    const auto location = [&](const char* name) { return glGetUniformLocation(program, name); };
+    shader.set_uniform("count", 3);
+    shader.set_uniform("mask", 7u);
+    shader.set_uniform("scale", 0.5f);
+    shader.set_uniform("offset", ogf::Vector2F{1.0f, 2.0f});
+    shader.set_uniform("direction", ogf::Vector3F{3.0f, 4.0f, 5.0f});
+    shader.set_uniform("tint", ogf::Color{0.25f, 0.5f, 0.75f, 1.0f});
+    float matrix[16]{};
+    for(int i = 0; i < 16; ++i) {
+        matrix[i] = static_cast<float>(i);
+    }
+    shader.set_uniform_matrix4("transform", matrix);
+    // Uniforms the program doesn't have are ignored.
+    shader.set_uniform("missing", 1.0f);
+
+    GLint int_value{};
+    glGetUniformiv(program, location("count"), &int_value);
+    ASSERT_EQ(int_value, 3);
+    GLuint uint_value{};
+    glGetUniformuiv(program, location("mask"), &uint_value);
+    ASSERT_EQ(uint_value, 7u);
+    float values[16]{};
+    glGetUniformfv(program, location("scale"), values);
+    ASSERT_EQ(values[0], 0.5f);
+    glGetUniformfv(program, location("offset"), values);
+    ASSERT_EQ(values[0], 1.0f);
+    ASSERT_EQ(values[1], 2.0f);
+    glGetUniformfv(program, location("direction"), values);
+    ASSERT_EQ(values[2], 5.0f);
+    glGetUniformfv(program, location("tint"), values);
+    ASSERT_EQ(values[1], 0.5f);
+    ASSERT_EQ(values[3], 1.0f);
+    glGetUniformfv(program, location("transform"), values);
+    ASSERT_TRUE(std::equal(values, values + 16, matrix));
+
+    // Values equal to the last ones set through the shader aren't uploaded again, changed ones are.
+    glUniform1f(location("scale"), 2.0f);
+    shader.set_uniform("scale", 0.5f);
+    glGetUniformfv(program, location("scale"), values);
+    ASSERT_EQ(values[0], 2.0f);
+    shader.set_uniform("scale", 0.75f);
+    glGetUniformfv(program, location("scale"), values);
+    ASSERT_EQ(values[0], 0.75f);
+    // A reloaded program starts without values, so the same one is uploaded to it.
+    shader.load_from_memory(VERTEX_SOURCE, FRAGMENT_SOURCE);
+    glUseProgram(shader.native_handle());
+    shader.set_uniform("offset", ogf::Vector2F{1.0f, 2.0f});
+    glGetUniformfv(shader.native_handle(), glGetUniformLocation(shader.native_handle(), "offset"), values);
+    ASSERT_EQ(values[1], 2.0f);
+    glUseProgram(0);
+}
@@ -0,0 +1,57 @@
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+
+#include <ogf/graphics/shader_preprocessor.hxx>
+
+namespace {
+
+    void write_file(const std::filesystem::path& path, const std::string& content) {
+        std::filesystem::create_directories(path.parent_path());
+        std::ofstream{path} << content;
+    }
+
+}
+
+TEST(shader_preprocessor, resolves_includes_once) {
+    const std::filesystem::path directory{testing::TempDir() + "shader_preprocessor"};
+    write_file(directory / "main.glsl",
+            "#version 330 core\n#include \"common.glsl\"\n#include \"common.glsl\"\nmain\n");
+    write_file(directory / "common.glsl", "  #  include <lighting.glsl>\ncommon\n");
+    write_file(directory / "library" / "lighting.glsl", "#include \"../main.glsl\"\nlighting\n");
+    ogf::ShaderPreprocessor preprocessor{};
+    preprocessor.add_include_directory((directory / "library").string());
+    const auto output = preprocessor.process_file((directory / "main.glsl").string());
+    ASSERT_EQ(output, "#version 330 core\n#line 2 0\n#line 1 1\n#line 1 2\n#line 2 2\nlighting\n#line 2 1\ncommon\n"
+            "#line 3 0\n#line 4 0\nmain\n");
+}
+
+TEST(shader_preprocessor, inserts_defines_after_version) {
+    ogf::ShaderPreprocessor preprocessor{};
+    preprocessor.add_source("noise", "float noise();\n");
+    const ogf::ShaderDefines defines{{"SHADOWS", ""}, {"LIGHT_COUNT", "4"}};
+    ASSERT_EQ(preprocessor.process("// Header.\n#version 450\n#include \"noise\"\nvoid main() {}", defines),
+            "// Header.\n#version 450\n#define SHADOWS\n#define LIGHT_COUNT 4\n#line 3 0\n#line 1 1\nfloat noise();\n"
+            "#line 4 0\nvoid main() {}\n");
+    ASSERT_EQ(preprocessor.process("void main() {}\n", defines),
+            "#define SHADOWS\n#define LIGHT_COUNT 4\n#line 1 0\nvoid main() {}\n");
+}
+
+TEST(shader_preprocessor, reports_missing_includes) {
+    ogf::ShaderPreprocessor preprocessor{};
+    ASSERT_THROW(preprocessor.process("#version 330\n#include \"missing.glsl\"\n"), std::runtime_error);
+    ASSERT_THROW(preprocessor.process("#include missing.glsl\n"), std::runtime_error);
+}
+
+TEST(shader_preprocessor, leaves_conditional_includes_to_glsl) {
+    ogf::ShaderPreprocessor preprocessor{};
+    preprocessor.add_source("shadow", "shadow\n");
+    ASSERT_EQ(preprocessor.process("#version 330\n#ifdef SHADOWS\n#include \"shadow\"\n#include \"missing\"\n#endif\n"
+            "#include \"shadow\"\n#include \"shadow\"\n"),
+            "#version 330\n#line 2 0\n#ifdef SHADOWS\n#ifndef OGF_INCLUDED_1\n#define OGF_INCLUDED_1\n"
+            "#line 1 1\nshadow\n#endif\n#line 4 0\n#error can't find included file \"missing\"\n#line 5 0\n#endif\n"
+            "#ifndef OGF_INCLUDED_1\n#define OGF_INCLUDED_1\n#line 1 1\nshadow\n#endif\n#line 7 0\n#line 8 0\n");
+}
@@ -0,0 +1,45 @@
+#include <gtest/gtest.h>
+
+#include <cstdlib>
+#include <vector>
+
+#include <ogf/graphics/skyline_packer.hxx>
+#include <ogf/math/rect.hxx>
+
+TEST(skyline_packer, places_first_rect_at_origin) {
+    ogf::SkylinePacker packer{64, 64};
+    const auto position = packer.insert(10, 20);
+    ASSERT_TRUE(position.has_value());
+    ASSERT_EQ(position->x, 0u);
+    ASSERT_EQ(position->y, 0u);
+}
+
+TEST(skyline_packer, rejects_rect_too_big) {
+    ogf::SkylinePacker packer{64, 64};
+    ASSERT_FALSE(packer.insert(65, 1).has_value());
+    ASSERT_FALSE(packer.insert(1, 65).has_value());
+    ASSERT_TRUE(packer.insert(64, 64).has_value());
+    ASSERT_FALSE(packer.insert(1, 1).has_value());
+}
+
+TEST(skyline_packer, rects_dont_overlap) {
+    ogf::SkylinePacker packer{256, 256};
+    std::srand(42);
+    std::vector<ogf::RectU> placed{};
+    for(int i = 0; i < 500; ++i) {
+        const auto width = 1 + std::rand() % 24u;
+        const auto height = 1 + std::rand() % 24u;
+        const auto position = packer.insert(width, height);
+        if(!position.has_value()) {
+            continue;
+        }
+        const ogf::RectU rect{position->x, position->y, width, height};
+        ASSERT_LE(rect.left + rect.width, 256u);
+        ASSERT_LE(rect.top + rect.height, 256u);
+        for(const auto& other : placed) {
+            ASSERT_FALSE(rect.intersects(other));
+        }
+        placed.push_back(rect);
+    }
+    ASSERT_GT(placed.size(), 100u);
+}
@@ -0,0 +1,78 @@
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <vector>
+
+#include <glad/glad.h>
+
+#include <ogf/graphics/gl_extensions.hxx>
+#include <ogf/graphics/image.hxx>
+#include <ogf/graphics/mipmaps.hxx>
+#include <ogf/graphics/texture.hxx>
+
+#include "gl_context.hxx"
+
+namespace {
+
+    // Compare a level of the bound texture with the RGB8 image.
+    void check_level(const unsigned int level, const ogf::Image& expected) {
+        const auto [width, height] = expected.size();
+        std::vector<ogf::Uint8> pixels(static_cast<std::size_t>(width) * height * 3);
+        glPixelStorei(GL_PACK_ALIGNMENT, 1);
+        glGetTexImage(GL_TEXTURE_2D, static_cast<GLint>(level), GL_RGB, GL_UNSIGNED_BYTE, pixels.data());
+        glPixelStorei(GL_PACK_ALIGNMENT, 4);
+        for(unsigned int y = 0; y < height; ++y) {
+            ASSERT_EQ(std::memcmp(pixels.data() + y * width * 3, expected.pixels() + y * expected.stride(), width * 3),
+                    0) << "level " << level << ", row " << y;
+        }
+    }
+
+}
+
+TEST(texture, uploads_images_with_and_without_direct_state_access) {
+    if(!make_test_gl_context_current(3, 3)) {
+        GTEST_SKIP() << "No OpenGL 3.3 context.";
+    }
+    // Odd-width RGB rows are neither 4-byte aligned nor as long as their stride.
+    ogf::Image image{};
+    image.create(19, 13, ogf::Color::BLACK, ogf::PixelFormat::RGB8);
+    for(unsigned int y = 0; y < 13; ++y) {
+        for(unsigned int i = 0; i < 19 * 3; ++i) {
+            image.pixels()[y * image.stride() + i] = static_cast<ogf::Uint8>(y * 17 + i * 5);
+        }
+    }
+    const auto mipmaps = ogf::generate_mipmaps(image);
+    ogf::Image patch{};
+    patch.create(5, 3, ogf::Color{1.0f, 0.0f, 1.0f}, ogf::PixelFormat::RGB8);
+    ogf::Image patched{};
+    patched.create(image);
+    patched.blit(patch, 7, 4);
+    for(const auto hidden : {static_cast<const char*>(nullptr), "glTextureStorage2D"}) {
+        reload_test_gl_extensions(hidden);
+        const auto direct_state_access = ogf::has_direct_state_access();
+        ASSERT_EQ(direct_state_access, hidden == nullptr);
+        GLuint bound{};
+        glGenTextures(1, &bound);
+        glBindTexture(GL_TEXTURE_2D, bound);
+        ogf::Texture texture{};
+        texture.load_from_image(image, mipmaps);
+        texture.update(patch, 7, 4);
+        GLint binding{};
+        glGetIntegerv(GL_TEXTURE_BINDING_2D, &binding);
+        if(direct_state_access) {
+            // The caller's texture stays bound.
+            ASSERT_EQ(static_cast<GLuint>(binding), bound);
+        }
+        glBindTexture(GL_TEXTURE_2D, texture.native_handle());
+        check_level(0, patched);
+        for(std::size_t level = 0; level < mipmaps.size(); ++level) {
+            check_level(static_cast<unsigned int>(level + 1), mipmaps[level]);
+        }
+        GLint max_level{};
+        glGetTexParameteriv(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, &max_level);
+        ASSERT_EQ(static_cast<std::size_t>(max_level), mipmaps.size());
+        glBindTexture(GL_TEXTURE_2D, 0);
+        glDeleteTextures(1, &bound);
+    }
+    reload_test_gl_extensions();
+}
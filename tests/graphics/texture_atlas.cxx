@@ -0,0 +1,132 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <vector>
+
+#include <glad/glad.h>
+
+#include <ogf/graphics/image.hxx>
+#include <ogf/graphics/mipmaps.hxx>
+#include <ogf/graphics/texture.hxx>
+#include <ogf/graphics/texture_atlas.hxx>
+
+#include "gl_context.hxx"
+
+namespace {
+
+    ogf::Image pattern_image(const unsigned int width, const unsigned int height) {
+        ogf::Image image{};
+        image.create(width, height);
+        for(unsigned int y = 0; y < height; ++y) {
+            for(unsigned int x = 0; x < width; ++x) {
+                auto* pixel = image.pixels() + y * image.stride() + x * 4;
+                pixel[0] = static_cast<ogf::Uint8>(x * 40);
+                pixel[1] = static_cast<ogf::Uint8>(y * 80);
+                pixel[2] = static_cast<ogf::Uint8>(100 + x + y);
+                pixel[3] = 255;
+            }
+        }
+        return image;
+    }
+
+    // The slot an atlas makes for the image: the image in the middle, the edge pixels repeated around it.
+    ogf::Image expected_slot(const ogf::Image& image, const unsigned int padding, const unsigned int slot_width,
+            const unsigned int slot_height) {
+        const auto [width, height] = image.size();
+        ogf::Image slot{};
+        slot.create(slot_width, slot_height);
+        for(unsigned int y = 0; y < slot_height; ++y) {
+            for(unsigned int x = 0; x < slot_width; ++x) {
+                const auto source_x = std::clamp(static_cast<int>(x) - static_cast<int>(padding), 0,
+                        static_cast<int>(width) - 1);
+                const auto source_y = std::clamp(static_cast<int>(y) - static_cast<int>(padding), 0,
+                        static_cast<int>(height) - 1);
+                std::memcpy(slot.pixels() + y * slot.stride() + x * 4,
+                        image.pixels() + static_cast<unsigned int>(source_y) * image.stride()
+                        + static_cast<unsigned int>(source_x) * 4, 4);
+            }
+        }
+        return slot;
+    }
+
+    // Compare a region of a level of the bound page texture with the image.
+    void check_region(const std::vector<ogf::Uint8>& level_pixels, const unsigned int level_size,
+            const unsigned int x, const unsigned int y, const ogf::Image& expected, const unsigned int level) {
+        const auto [width, height] = expected.size();
+        ASSERT_LE(x + width, level_size);
+        ASSERT_LE(y + height, level_size);
+        for(unsigned int row = 0; row < height; ++row) {
+            ASSERT_EQ(std::memcmp(level_pixels.data() + ((y + row) * level_size + x) * 4,
+                    expected.pixels() + row * expected.stride(), width * 4), 0) << "level " << level << ", row " << row;
+        }
+    }
+
+}
+
+TEST(texture_atlas, places_images_on_aligned_slots) {
+    ogf::TextureAtlas atlas{32, 2, 4};
+    const auto first = atlas.add(pattern_image(5, 3));
+    const auto second = atlas.add(pattern_image(2, 2));
+    ASSERT_EQ(atlas.page_count(), 1u);
+    for(const auto id : {first, second}) {
+        const auto rect = atlas.pixel_rect(id);
+        // The gutter starts on a multiple of the alignment.
+        ASSERT_EQ((rect.left - 2) % 4, 0u);
+        ASSERT_EQ((rect.top - 2) % 4, 0u);
+        const auto uv = atlas.uv_rect(id);
+        ASSERT_FLOAT_EQ(uv.left, rect.left / 32.0f);
+        ASSERT_FLOAT_EQ(uv.top, rect.top / 32.0f);
+        ASSERT_FLOAT_EQ(uv.width, rect.width / 32.0f);
+        ASSERT_FLOAT_EQ(uv.height, rect.height / 32.0f);
+    }
+    ASSERT_EQ(atlas.pixel_rect(first).width, 5u);
+    ASSERT_EQ(atlas.pixel_rect(first).height, 3u);
+    // Slots of 12x8 and 8x8 pixels, the gutters rounded up to the alignment, don't overlap.
+    const auto a = atlas.pixel_rect(first);
+    const auto b = atlas.pixel_rect(second);
+    ASSERT_FALSE((ogf::RectU{a.left - 2, a.top - 2, 12, 8}.intersects(ogf::RectU{b.left - 2, b.top - 2, 8, 8})));
+    // A slot filling a page whole starts the next page.
+    const auto third = atlas.add(pattern_image(28, 28));
+    ASSERT_EQ(atlas.page(third), 1u);
+    ASSERT_EQ(atlas.page_count(), 2u);
+    ASSERT_THROW(atlas.add(pattern_image(29, 4)), std::runtime_error);
+    ASSERT_THROW(ogf::TextureAtlas(32, 2, 3), std::runtime_error);
+}
+
+TEST(texture_atlas, uploads_slots_with_gutters_and_mipmaps) {
+    if(!make_test_gl_context_current(3, 3)) {
+        GTEST_SKIP() << "No OpenGL 3.3 context.";
+    }
+    constexpr unsigned int page_size = 32;
+    constexpr unsigned int padding = 2;
+    const ogf::Image images[]{pattern_image(5, 3), pattern_image(7, 6), pattern_image(2, 2)};
+    const unsigned int slot_sizes[][2]{{12, 8}, {12, 12}, {8, 8}};
+    ogf::TextureAtlas atlas{page_size, padding, 4};
+    for(const auto& image : images) {
+        atlas.add(image);
+    }
+    atlas.update();
+    ASSERT_EQ(atlas.page_count(), 1u);
+    glBindTexture(GL_TEXTURE_2D, atlas.texture(0).native_handle());
+    // Alignment 4 gives the page two mipmap levels, slots at multiples of 4 land on whole pixels of both.
+    for(unsigned int level = 0; level <= 2; ++level) {
+        const auto level_size = page_size >> level;
+        std::vector<ogf::Uint8> level_pixels(level_size * level_size * 4);
+        glGetTexImage(GL_TEXTURE_2D, static_cast<GLint>(level), GL_RGBA, GL_UNSIGNED_BYTE, level_pixels.data());
+        for(std::size_t id = 0; id < 3; ++id) {
+            const auto rect = atlas.pixel_rect(id);
+            const auto slot = expected_slot(images[id], padding, slot_sizes[id][0], slot_sizes[id][1]);
+            const auto x = (rect.left - padding) >> level;
+            const auto y = (rect.top - padding) >> level;
+            if(level == 0) {
+                check_region(level_pixels, level_size, x, y, slot, level);
+            } else {
+                const auto mipmaps = ogf::generate_mipmaps(slot);
+                check_region(level_pixels, level_size, x, y, mipmaps[level - 1], level);
+            }
+        }
+    }
+    glBindTexture(GL_TEXTURE_2D, 0);
+}
@@ -0,0 +1,108 @@
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <stdexcept>
+#include <vector>
+
+#include <ogf/graphics/texture_container.hxx>
+
+namespace {
+
+    template<typename T>
+    void put(std::vector<ogf::Uint8>& data, const std::size_t offset, const T value) {
+        if(data.size() < offset + sizeof(T)) {
+            data.resize(offset + sizeof(T));
+        }
+        std::memcpy(data.data() + offset, &value, sizeof(T));
+    }
+
+    // 8x8 DXT1 texture with all four levels.
+    std::vector<ogf::Uint8> make_dds() {
+        std::vector<ogf::Uint8> data(128, 0);
+        std::memcpy(data.data(), "DDS ", 4);
+        put<ogf::Uint32>(data, 4, 124);
+        put<ogf::Uint32>(data, 12, 8);
+        put<ogf::Uint32>(data, 16, 8);
+        put<ogf::Uint32>(data, 28, 4);
+        put<ogf::Uint32>(data, 76, 32);
+        put<ogf::Uint32>(data, 80, 0x4);
+        std::memcpy(data.data() + 84, "DXT1", 4);
+        data.resize(128 + 32 + 8 + 8 + 8);
+        return data;
+    }
+
+    // 4x2 RGBA8 texture with two levels, stored from the smallest one like real KTX2 files.
+    std::vector<ogf::Uint8> make_ktx2() {
+        const ogf::Uint8 magic[12]{0xAB, 'K', 'T', 'X', ' ', '2', '0', 0xBB, '\r', '\n', 0x1A, '\n'};
+        std::vector<ogf::Uint8> data(80 + 2 * 24, 0);
+        std::memcpy(data.data(), magic, sizeof(magic));
+        put<ogf::Uint32>(data, 12, 37);
+        put<ogf::Uint32>(data, 20, 4);
+        put<ogf::Uint32>(data, 24, 2);
+        put<ogf::Uint32>(data, 36, 1);
+        put<ogf::Uint32>(data, 40, 2);
+        put<ogf::Uint64>(data, 80, 136);
+        put<ogf::Uint64>(data, 88, 32);
+        put<ogf::Uint64>(data, 104, 128);
+        put<ogf::Uint64>(data, 112, 8);
+        data.resize(168);
+        return data;
+    }
+
+}
+
+TEST(texture_container, parses_dds) {
+    const auto data = make_dds();
+    const auto container = ogf::parse_texture_container(data.data(), data.size(), "test.dds");
+    ASSERT_TRUE(container.compressed);
+    ASSERT_EQ(container.levels.size(), 4u);
+    ASSERT_EQ(container.levels[0].offset, 128u);
+    ASSERT_EQ(container.levels[0].size, 32u);
+    ASSERT_EQ(container.levels[1].offset, 160u);
+    ASSERT_EQ(container.levels[1].size, 8u);
+    ASSERT_EQ(container.levels[3].width, 1u);
+    ASSERT_EQ(container.levels[3].size, 8u);
+}
+
+TEST(texture_container, parses_ktx2) {
+    const auto data = make_ktx2();
+    const auto container = ogf::parse_texture_container(data.data(), data.size(), "test.ktx2");
+    ASSERT_FALSE(container.compressed);
+    ASSERT_EQ(container.levels.size(), 2u);
+    ASSERT_EQ(container.levels[0].offset, 136u);
+    ASSERT_EQ(container.levels[0].size, 32u);
+    ASSERT_EQ(container.levels[1].offset, 128u);
+    ASSERT_EQ(container.levels[1].width, 2u);
+    ASSERT_EQ(container.levels[1].height, 1u);
+}
+
+TEST(texture_container, rejects_truncated_file) {
+    auto data = make_dds();
+    data.resize(data.size() - 1);
+    ASSERT_THROW(ogf::parse_texture_container(data.data(), data.size(), "test.dds"), std::runtime_error);
+}
+
+TEST(texture_container, rejects_unknown_file) {
+    const std::vector<ogf::Uint8> data(256, 0);
+    ASSERT_THROW(ogf::parse_texture_container(data.data(), data.size(), "test.png"), std::runtime_error);
+}
+
+TEST(texture_container, rejects_more_levels_than_size_allows) {
+    auto data = make_dds();
+    put<ogf::Uint32>(data, 28, 5);
+    ASSERT_THROW(ogf::parse_texture_container(data.data(), data.size(), "test.dds"), std::runtime_error);
+    // A count this big would otherwise allocate the levels before the file size is checked.
+    put<ogf::Uint32>(data, 28, 0xFFFFFFFF);
+    ASSERT_THROW(ogf::parse_texture_container(data.data(), data.size(), "test.dds"), std::runtime_error);
+    auto ktx2 = make_ktx2();
+    put<ogf::Uint32>(ktx2, 40, 4);
+    ktx2.resize(256);
+    ASSERT_THROW(ogf::parse_texture_container(ktx2.data(), ktx2.size(), "test.ktx2"), std::runtime_error);
+}
+
+TEST(texture_container, detects_extensions_in_any_case) {
+    ASSERT_TRUE(ogf::has_texture_container_extension("stone.dds"));
+    ASSERT_TRUE(ogf::has_texture_container_extension("stone.DDS"));
+    ASSERT_TRUE(ogf::has_texture_container_extension("stone.KTX2"));
+    ASSERT_FALSE(ogf::has_texture_container_extension("stone.png"));
+}
@@ -0,0 +1,135 @@
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include <ogf/graphics/texture_residency.hxx>
+
+namespace {
+
+    // Levels of a square RGBA8 texture, from size pixels down to 1.
+    std::vector<ogf::TextureResidency::Level> square_levels(const unsigned int size) {
+        std::vector<ogf::TextureResidency::Level> levels{};
+        for(auto level_size = size; level_size > 0; level_size /= 2) {
+            levels.push_back(ogf::TextureResidency::Level{level_size, std::size_t{level_size} * level_size * 4});
+        }
+        return levels;
+    }
+
+    std::size_t levels_bytes(const unsigned int size, const unsigned int first_level) {
+        std::size_t bytes{0};
+        for(auto level_size = size >> first_level; level_size > 0; level_size /= 2) {
+            bytes += std::size_t{level_size} * level_size * 4;
+        }
+        return bytes;
+    }
+
+}
+
+TEST(texture_residency, wants_levels_matching_screen_size) {
+    ogf::TextureResidency residency{1 << 30, 64};
+    const auto handle = residency.add(square_levels(256));
+    ASSERT_EQ(residency.resident_level(handle), 2u);
+    ASSERT_EQ(residency.usage(), levels_bytes(256, 2));
+    residency.report_usage(handle, 100.0f);
+    ASSERT_EQ(residency.wanted_level(handle), 1u);
+    // The most detailed level reported in a frame wins, the next frame starts over.
+    residency.report_usage(handle, 1000.0f);
+    residency.report_usage(handle, 10.0f);
+    ASSERT_EQ(residency.wanted_level(handle), 0u);
+    residency.next_frame();
+    residency.report_usage(handle, 10.0f);
+    ASSERT_EQ(residency.wanted_level(handle), 4u);
+    residency.report_usage(handle, 0.0f);
+    ASSERT_EQ(residency.wanted_level(handle), 4u);
+}
+
+TEST(texture_residency, requests_levels_within_budget) {
+    // Room for levels 1 and smaller of one texture, but not for level 0.
+    ogf::TextureResidency residency{levels_bytes(256, 1) + levels_bytes(256, 2), 64};
+    const auto first = residency.add(square_levels(256));
+    const auto second = residency.add(square_levels(256));
+    residency.report_usage(first, 256.0f);
+    residency.report_usage(second, 256.0f);
+    const auto requests = residency.request();
+    ASSERT_EQ(requests.size(), 1u);
+    ASSERT_EQ(requests[0].handle, first);
+    ASSERT_EQ(requests[0].first_level, 1u);
+    ASSERT_EQ(requests[0].resident_level, 2u);
+    // Loading textures aren't requested again.
+    ASSERT_TRUE(residency.request().empty());
+    ASSERT_EQ(residency.usage(), 2 * levels_bytes(256, 2));
+    residency.loaded(first, 1);
+    ASSERT_EQ(residency.resident_level(first), 1u);
+    ASSERT_EQ(residency.usage(), levels_bytes(256, 1) + levels_bytes(256, 2));
+    ASSERT_TRUE(residency.evict().empty());
+}
+
+TEST(texture_residency, evicts_unwanted_then_least_recently_used) {
+    // Everything starts resident, 3 full textures in a budget for 2.
+    ogf::TextureResidency residency{2 * levels_bytes(64, 0), 64};
+    const auto old = residency.add(square_levels(64));
+    residency.next_frame();
+    const auto recent = residency.add(square_levels(64));
+    const auto used = residency.add(square_levels(64));
+    residency.next_frame();
+    residency.report_usage(used, 64.0f);
+    residency.report_usage(recent, 64.0f);
+    residency.next_frame();
+    residency.report_usage(used, 16.0f);
+    // The used texture drops the levels it doesn't want anymore, the rest comes from the oldest one.
+    const auto evictions = residency.evict();
+    ASSERT_EQ(evictions.size(), 3u);
+    ASSERT_EQ(evictions[0].handle, used);
+    ASSERT_EQ(evictions[0].level, 0u);
+    ASSERT_EQ(evictions[1].handle, used);
+    ASSERT_EQ(evictions[1].level, 1u);
+    ASSERT_EQ(evictions[2].handle, old);
+    ASSERT_EQ(evictions[2].level, 0u);
+    ASSERT_EQ(residency.resident_level(used), 2u);
+    ASSERT_EQ(residency.resident_level(recent), 0u);
+    ASSERT_EQ(residency.resident_level(old), 1u);
+    ASSERT_LE(residency.usage(), 2 * levels_bytes(64, 0));
+}
+
+TEST(texture_residency, keeps_textures_used_this_frame) {
+    ogf::TextureResidency residency{1, 64};
+    const auto handle = residency.add(square_levels(64));
+    residency.report_usage(handle, 64.0f);
+    ASSERT_TRUE(residency.evict().empty());
+    residency.next_frame();
+    // Unused textures go down to their last level, but never lose it.
+    const auto evictions = residency.evict();
+    ASSERT_EQ(evictions.size(), 6u);
+    ASSERT_EQ(residency.resident_level(handle), 6u);
+    ASSERT_EQ(residency.usage(), 4u);
+}
+
+TEST(texture_residency, requests_only_textures_used_this_frame) {
+    ogf::TextureResidency residency{levels_bytes(128, 0) + levels_bytes(64, 1), 16};
+    const auto big = residency.add(square_levels(128));
+    residency.report_usage(big, 128.0f);
+    auto requests = residency.request();
+    ASSERT_EQ(requests.size(), 1u);
+    residency.loaded(big, requests[0].first_level);
+    residency.next_frame();
+    // Seen up close once, getting as many levels as fit.
+    const auto seen = residency.add(square_levels(64));
+    residency.report_usage(seen, 64.0f);
+    requests = residency.request();
+    ASSERT_EQ(requests.size(), 1u);
+    ASSERT_EQ(requests[0].first_level, 1u);
+    residency.loaded(seen, 1);
+    residency.next_frame();
+    // Then off screen. Adding a texture evicts the level 0 of the oldest one, which leaves room for the level 0 of the
+    // texture seen before, but it isn't read for a texture nobody looks at anymore.
+    residency.add(square_levels(1));
+    const auto evictions = residency.evict();
+    ASSERT_EQ(evictions.size(), 1u);
+    ASSERT_EQ(evictions[0].handle, big);
+    ASSERT_TRUE(residency.request().empty());
+    residency.report_usage(seen, 64.0f);
+    requests = residency.request();
+    ASSERT_EQ(requests.size(), 1u);
+    ASSERT_EQ(requests[0].handle, seen);
+    ASSERT_EQ(requests[0].first_level, 0u);
+}
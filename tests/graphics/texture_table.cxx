@@ -0,0 +1,68 @@
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+#include <glad/glad.h>
+
+#include <ogf/graphics/image.hxx>
+#include <ogf/graphics/sampler.hxx>
+#include <ogf/graphics/shader.hxx>
+#include <ogf/graphics/texture_table.hxx>
+
+#include "gl_context.hxx"
+
+TEST(texture_table, draws_textures_by_index) {
+    if(!make_test_gl_context_current(3, 3)) {
+        GTEST_SKIP() << "No OpenGL 3.3 context.";
+    }
+    constexpr unsigned int size = 8;
+    const ogf::Color colors[]{{1.0f, 0.0f, 0.0f, 1.0f}, {0.0f, 0.0f, 1.0f, 1.0f}};
+    ogf::TextureTable table{size, size, 2};
+    ogf::Image image{};
+    for(const auto& color : colors) {
+        image.create(size, size, color);
+        table.add(image);
+    }
+    ASSERT_EQ(table.size(), 2u);
+    // The table doesn't keep the shared sampler, which is deleted here.
+    ogf::Sampler::clear_cache();
+
+    const std::string vertex_source{"#version 330 core\n"
+            "void main() { gl_Position = vec4(vec2(gl_VertexID % 2, gl_VertexID / 2) * 4.0 - 1.0, 0.0, 1.0); }\n"};
+    const auto fragment_source = std::string{"#version 330 core\n"} + table.glsl_source()
+            + "uniform uint index;\nout vec4 color;\n"
+            "void main() { color = ogf_texture_table_sample(index, gl_FragCoord.xy / 8.0); }\n";
+    ogf::Shader shader{};
+    shader.load_from_memory(vertex_source, fragment_source);
+    GLuint vertex_array{}, target{}, framebuffer{};
+    glGenVertexArrays(1, &vertex_array);
+    glBindVertexArray(vertex_array);
+    glGenTextures(1, &target);
+    glBindTexture(GL_TEXTURE_2D, target);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, size, size, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+    glGenFramebuffers(1, &framebuffer);
+    glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, target, 0);
+    glViewport(0, 0, size, size);
+    glUseProgram(shader.native_handle());
+    std::vector<ogf::Uint8> drawn(size * size * 4);
+    for(unsigned int index = 0; index < 2; ++index) {
+        table.bind(shader, 2);
+        shader.set_uniform("index", index);
+        glDrawArrays(GL_TRIANGLES, 0, 3);
+        glReadPixels(0, 0, size, size, GL_RGBA, GL_UNSIGNED_BYTE, drawn.data());
+        for(std::size_t i = 0; i < drawn.size(); i += 4) {
+            ASSERT_EQ(drawn[i], static_cast<ogf::Uint8>(colors[index].r * 255.0f)) << "pixel " << i / 4;
+            ASSERT_EQ(drawn[i + 1], 0);
+            ASSERT_EQ(drawn[i + 2], static_cast<ogf::Uint8>(colors[index].b * 255.0f)) << "pixel " << i / 4;
+        }
+    }
+    glUseProgram(0);
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    glDeleteFramebuffers(1, &framebuffer);
+    glDeleteTextures(1, &target);
+    glBindVertexArray(0);
+    glDeleteVertexArrays(1, &vertex_array);
+    ogf::Sampler::clear_cache();
+}
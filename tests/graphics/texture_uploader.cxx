@@ -0,0 +1,58 @@
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <vector>
+
+#include <glad/glad.h>
+
+#include <ogf/graphics/image.hxx>
+#include <ogf/graphics/mipmaps.hxx>
+#include <ogf/graphics/texture.hxx>
+#include <ogf/graphics/texture_uploader.hxx>
+
+#include "gl_context.hxx"
+
+TEST(texture_uploader, uploads_through_small_ring) {
+    if(!make_test_gl_context_current(3, 3)) {
+        GTEST_SKIP() << "No OpenGL 3.3 context.";
+    }
+    // Rows of 37 RGB pixels aren't 4-byte aligned, and a few of them fill the ring, so bands wrap around.
+    ogf::Image image{};
+    image.create(37, 29, ogf::Color::BLACK, ogf::PixelFormat::RGB8);
+    for(unsigned int y = 0; y < 29; ++y) {
+        for(unsigned int i = 0; i < 37 * 3; ++i) {
+            image.pixels()[y * image.stride() + i] = static_cast<ogf::Uint8>(y * 31 + i * 7);
+        }
+    }
+    const auto mipmaps = ogf::generate_mipmaps(image);
+    // Persistent mapping and DSA, then each of them hidden.
+    for(const auto hidden : {static_cast<const char*>(nullptr), "glBufferStorage", "glTextureSubImage2D"}) {
+        reload_test_gl_extensions(hidden);
+        ogf::Texture texture{};
+        {
+            ogf::TextureUploader uploader{1024, 300};
+            uploader.upload(texture, image, mipmaps);
+            for(int frame = 0; frame < 1000 && uploader.pending_bytes() > 0; ++frame) {
+                uploader.update();
+                glFinish();
+            }
+            ASSERT_EQ(uploader.pending_bytes(), 0u) << (hidden != nullptr ? hidden : "all functions");
+        }
+        glBindTexture(GL_TEXTURE_2D, texture.native_handle());
+        glPixelStorei(GL_PACK_ALIGNMENT, 1);
+        for(std::size_t level = 0; level <= mipmaps.size(); ++level) {
+            const auto& expected = level == 0 ? image : mipmaps[level - 1];
+            const auto [width, height] = expected.size();
+            std::vector<ogf::Uint8> pixels(static_cast<std::size_t>(width) * height * 3);
+            glGetTexImage(GL_TEXTURE_2D, static_cast<GLint>(level), GL_RGB, GL_UNSIGNED_BYTE, pixels.data());
+            for(unsigned int y = 0; y < height; ++y) {
+                ASSERT_EQ(std::memcmp(pixels.data() + y * width * 3, expected.pixels() + y * expected.stride(),
+                        width * 3), 0) << (hidden != nullptr ? hidden : "all functions") << ", level " << level
+                        << ", row " << y;
+            }
+        }
+        glPixelStorei(GL_PACK_ALIGNMENT, 4);
+        glBindTexture(GL_TEXTURE_2D, 0);
+    }
+    reload_test_gl_extensions();
+}
@@ -0,0 +1,96 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+
+#include <ogf/graphics/image.hxx>
+#include <ogf/graphics/tiled_image.hxx>
+
+namespace {
+
+    ogf::Image make_gradient(const unsigned int width, const unsigned int height, const ogf::PixelFormat format) {
+        ogf::Image image{};
+        image.create(width, height, ogf::Color::BLACK, format);
+        for(unsigned int y = 0; y < height; ++y) {
+            for(unsigned int x = 0; x < width; ++x) {
+                image.set_pixel(x, y, ogf::Color{static_cast<float>(x) / width, static_cast<float>(y) / height,
+                        static_cast<float>((x * 7 + y * 3) % 256) / 255.0f, static_cast<float>(x % 2)});
+            }
+        }
+        return image;
+    }
+
+    bool same_pixel(const ogf::Color& left, const ogf::Color& right) {
+        return left.r == right.r && left.g == right.g && left.b == right.b && left.a == right.a;
+    }
+
+    float max_difference(const ogf::Image& left, const ogf::Image& right) {
+        const auto [width, height] = left.size();
+        float difference{0.0f};
+        for(unsigned int y = 0; y < height; ++y) {
+            for(unsigned int x = 0; x < width; ++x) {
+                const auto a = left.pixel(x, y);
+                const auto b = right.pixel(x, y);
+                difference = std::max({difference, std::abs(a.r - b.r), std::abs(a.g - b.g), std::abs(a.b - b.b),
+                        std::abs(a.a - b.a)});
+            }
+        }
+        return difference;
+    }
+
+}
+
+TEST(tiled_image, png_tiles_match_image) {
+    for(const auto format : {ogf::PixelFormat::RGBA8, ogf::PixelFormat::RGB16, ogf::PixelFormat::R8}) {
+        const auto image_filename = testing::TempDir() + "tiled_image.png";
+        const auto cache_filename = testing::TempDir() + "tiled_image.ogfti";
+        const auto image = make_gradient(300, 130, format);
+        image.save_to_file(image_filename);
+        ogf::TiledImage::build_tile_cache(image_filename, cache_filename, 64);
+
+        const std::size_t budget{64 * 64 * 8 * 3};
+        ogf::TiledImage tiled{budget};
+        tiled.open(cache_filename);
+        ASSERT_EQ(tiled.size(), std::make_tuple(300u, 130u));
+        ASSERT_EQ(tiled.tile_count(), std::make_tuple(5u, 3u));
+        ASSERT_EQ(tiled.format(), format);
+        ASSERT_EQ(tiled.tile(4, 2)->size(), std::make_tuple(44u, 2u));
+        ASSERT_EQ(max_difference(tiled.read(ogf::RectU{0, 0, 300, 130}), image), 0.0f);
+        const ogf::RectU area{50, 60, 100, 70};
+        ogf::Image expected{};
+        expected.create(image.view(area));
+        ASSERT_EQ(max_difference(tiled.read(area), expected), 0.0f);
+        ASSERT_TRUE(same_pixel(tiled.pixel(299, 129), image.pixel(299, 129)));
+        ASSERT_LE(tiled.memory_usage(), budget);
+        ASSERT_THROW(tiled.read(ogf::RectU{250, 0, 51, 1}), std::out_of_range);
+        ASSERT_THROW(tiled.tile(5, 0), std::out_of_range);
+    }
+}
+
+TEST(tiled_image, jpeg_tiles_match_image) {
+    const auto image_filename = testing::TempDir() + "tiled_image.jpg";
+    const auto cache_filename = testing::TempDir() + "tiled_image_jpeg.ogfti";
+    make_gradient(200, 100, ogf::PixelFormat::RGB8).save_to_file(image_filename);
+    ogf::Image image{};
+    image.load_from_file(image_filename);
+    ogf::TiledImage::build_tile_cache(image_filename, cache_filename, 32);
+    ogf::TiledImage tiled{};
+    tiled.open(cache_filename);
+    ASSERT_EQ(tiled.format(), ogf::PixelFormat::RGB8);
+    // Decoders may differ slightly in chroma upsampling.
+    ASSERT_LT(max_difference(tiled.read(ogf::RectU{0, 0, 200, 100}), image), 0.1f);
+}
+
+TEST(tiled_image, rejects_unsupported_files) {
+    const auto image_filename = testing::TempDir() + "tiled_image.bmp";
+    ogf::Image image{};
+    image.create(4, 4);
+    image.save_to_file(image_filename);
+    ASSERT_THROW(ogf::TiledImage::build_tile_cache(image_filename, testing::TempDir() + "tiled_image_bmp.ogfti"),
+            std::runtime_error);
+    ogf::TiledImage tiled{};
+    ASSERT_THROW(tiled.open(image_filename), std::runtime_error);
+}
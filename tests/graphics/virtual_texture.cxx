@@ -0,0 +1,217 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <glad/glad.h>
+
+#include <ogf/graphics/image.hxx>
+#include <ogf/graphics/shader.hxx>
+#include <ogf/graphics/tiled_image.hxx>
+#include <ogf/graphics/virtual_texture.hxx>
+#include <ogf/utils/mapped_file.hxx>
+
+#include "gl_context.hxx"
+
+namespace {
+
+    constexpr std::size_t HEADER_SIZE = 36;
+
+    ogf::Uint32 read_u32(const ogf::Uint8* data) {
+        ogf::Uint32 value{};
+        std::memcpy(&value, data, sizeof(value));
+        return value;
+    }
+
+}
+
+TEST(virtual_texture, tile_store_pads_to_power_of_two_tiles) {
+    const auto filename = testing::TempDir() + "virtual_texture.ogfvt";
+    ogf::Image image{};
+    image.create(300, 100);
+    ogf::VirtualTexture::build_tile_store(image, filename, 64, 2);
+
+    ogf::MappedFile file{};
+    file.open(filename);
+    ASSERT_GE(file.size(), HEADER_SIZE);
+    ASSERT_EQ(std::memcmp(file.data(), "OGFVT001", 8), 0);
+    ASSERT_EQ(read_u32(file.data() + 8), 300u);
+    ASSERT_EQ(read_u32(file.data() + 12), 100u);
+    ASSERT_EQ(read_u32(file.data() + 16), 64u);
+    ASSERT_EQ(read_u32(file.data() + 20), 2u);
+    // 8x2 tiles on level 0 and 4x1 on level 1, the last one covering the shorter side with a single tile.
+    ASSERT_EQ(read_u32(file.data() + 24), 2u);
+    ASSERT_EQ(read_u32(file.data() + 28), 8u);
+    ASSERT_EQ(read_u32(file.data() + 32), 2u);
+    ASSERT_EQ(file.size(), HEADER_SIZE + (16 + 4) * 68 * 68 * 4);
+}
+
+TEST(virtual_texture, tile_borders_repeat_edge_pixels) {
+    const auto filename = testing::TempDir() + "virtual_texture_border.ogfvt";
+    ogf::Image image{};
+    image.create(16, 16);
+    auto* pixels = image.pixels();
+    for(unsigned int i = 0; i < 16 * 16; ++i) {
+        pixels[i * 4] = static_cast<ogf::Uint8>(i % 16 * 16);
+        pixels[i * 4 + 1] = static_cast<ogf::Uint8>(i / 16 * 16);
+    }
+    ogf::VirtualTexture::build_tile_store(image, filename, 8, 1);
+
+    ogf::MappedFile file{};
+    file.open(filename);
+    const auto* tiles = file.data() + HEADER_SIZE;
+    constexpr unsigned int padded = 10;
+    // The corner of the first tile clamps to the first pixel.
+    ASSERT_EQ(tiles[0], 0);
+    ASSERT_EQ(tiles[1], 0);
+    // The right border of the first tile comes from its neighbour.
+    const auto* right = tiles + (1 * padded + 9) * 4;
+    ASSERT_EQ(right[0], 8 * 16);
+    ASSERT_EQ(right[1], 0);
+    // The left border of the second tile comes from the first one.
+    const auto* left = tiles + padded * padded * 4 + (1 * padded + 0) * 4;
+    ASSERT_EQ(left[0], 7 * 16);
+}
+
+TEST(virtual_texture, coarser_levels_average_without_bleeding) {
+    const auto filename = testing::TempDir() + "virtual_texture_levels.ogfvt";
+    // Columns alternate between transparent red and opaque green.
+    ogf::Image image{};
+    image.create(16, 16);
+    for(unsigned int y = 0; y < 16; ++y) {
+        for(unsigned int x = 0; x < 16; ++x) {
+            image.set_pixel(x, y, x % 2 == 0 ? ogf::Color{1.0f, 0.0f, 0.0f, 0.0f} : ogf::Color{0.0f, 1.0f, 0.0f});
+        }
+    }
+    ogf::VirtualTexture::build_tile_store(image, filename, 8, 0);
+
+    ogf::MappedFile file{};
+    file.open(filename);
+    ASSERT_EQ(read_u32(file.data() + 24), 2u);
+    // Level 1 is a single tile after the four of level 0.
+    const auto* level = file.data() + HEADER_SIZE + 4 * 8 * 8 * 4;
+    for(unsigned int i = 0; i < 8 * 8; ++i) {
+        ASSERT_EQ(level[i * 4], 0);
+        ASSERT_EQ(level[i * 4 + 1], 255);
+        ASSERT_EQ(level[i * 4 + 2], 0);
+        ASSERT_EQ(level[i * 4 + 3], 128);
+    }
+}
+
+TEST(virtual_texture, tiled_image_builds_same_store) {
+    const auto image_filename = testing::TempDir() + "virtual_texture_source.png";
+    const auto cache_filename = testing::TempDir() + "virtual_texture_source.ogfti";
+    ogf::Image image{};
+    image.create(200, 90);
+    for(unsigned int y = 0; y < 90; ++y) {
+        for(unsigned int x = 0; x < 200; ++x) {
+            image.set_pixel(x, y, ogf::Color{x / 200.0f, y / 90.0f, static_cast<float>((x * 7 + y * 3) % 256) / 255.0f,
+                    static_cast<float>(x % 3) / 2.0f});
+        }
+    }
+    image.save_to_file(image_filename);
+    ogf::TiledImage::build_tile_cache(image_filename, cache_filename, 48);
+    ogf::TiledImage tiled{};
+    tiled.open(cache_filename);
+
+    const auto from_image = testing::TempDir() + "virtual_texture_image.ogfvt";
+    const auto from_tiled = testing::TempDir() + "virtual_texture_tiled.ogfvt";
+    ogf::VirtualTexture::build_tile_store(image, from_image, 32, 2);
+    ogf::VirtualTexture::build_tile_store(tiled, from_tiled, 32, 2);
+    ogf::MappedFile expected{}, actual{};
+    expected.open(from_image);
+    actual.open(from_tiled);
+    ASSERT_EQ(actual.size(), expected.size());
+    ASSERT_EQ(std::memcmp(actual.data(), expected.data(), expected.size()), 0);
+}
+
+TEST(virtual_texture, build_rejects_empty_image) {
+    ogf::Image image{};
+    ASSERT_THROW(ogf::VirtualTexture::build_tile_store(image, testing::TempDir() + "empty.ogfvt"),
+            std::runtime_error);
+}
+
+TEST(virtual_texture, constructs_closed) {
+    // Nothing is created before open(), so this needs no GL context.
+    ogf::VirtualTexture texture{};
+    texture.close();
+}
+
+TEST(virtual_texture, draws_visible_tiles) {
+    if(!make_test_gl_context_current(3, 3)) {
+        GTEST_SKIP() << "No OpenGL 3.3 context.";
+    }
+    constexpr unsigned int size = 256;
+    const auto filename = testing::TempDir() + "virtual_texture_draw.ogfvt";
+    ogf::Image image{};
+    image.create(size, size);
+    auto* pixels = image.pixels();
+    for(unsigned int y = 0; y < size; ++y) {
+        for(unsigned int x = 0; x < size; ++x) {
+            auto* pixel = pixels + y * image.stride() + x * 4;
+            pixel[0] = static_cast<ogf::Uint8>(x);
+            pixel[1] = static_cast<ogf::Uint8>(y);
+            pixel[2] = static_cast<ogf::Uint8>(x ^ y);
+            pixel[3] = 255;
+        }
+    }
+    ogf::VirtualTexture::build_tile_store(image, filename, 64, 4);
+
+    // One pixel of the screen covers one texel, so level 0 is needed and sampled at texel centers.
+    const std::string vertex_source{"#version 330 core\n"
+            "void main() { gl_Position = vec4(vec2(gl_VertexID % 2, gl_VertexID / 2) * 4.0 - 1.0, 0.0, 1.0); }\n"};
+    const auto fragment_source = [](const std::string& output) {
+        return std::string{"#version 330 core\n"} + ogf::VirtualTexture::GLSL_SOURCE
+                + "out vec4 color;\nvoid main() { color = " + output + "(gl_FragCoord.xy / 256.0); }\n";
+    };
+    ogf::Shader feedback_shader{}, draw_shader{};
+    feedback_shader.load_from_memory(vertex_source, fragment_source("ogf_vt_feedback"));
+    draw_shader.load_from_memory(vertex_source, fragment_source("ogf_vt_sample"));
+    GLuint vertex_array{};
+    glGenVertexArrays(1, &vertex_array);
+    glBindVertexArray(vertex_array);
+    {
+        ogf::VirtualTexture texture{};
+        texture.open(filename, 8);
+        ogf::VirtualTextureFeedback feedback{size, size};
+        // Readbacks and tile reads finish a few frames later.
+        for(int frame = 0; frame < 40; ++frame) {
+            feedback.begin();
+            glUseProgram(feedback_shader.native_handle());
+            texture.bind(feedback_shader, 0, 1);
+            glDrawArrays(GL_TRIANGLES, 0, 3);
+            feedback.end();
+            glFinish();
+            std::this_thread::sleep_for(std::chrono::milliseconds{5});
+            texture.update(feedback);
+        }
+
+        GLuint target{}, framebuffer{};
+        glGenTextures(1, &target);
+        glBindTexture(GL_TEXTURE_2D, target);
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, size, size, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+        glGenFramebuffers(1, &framebuffer);
+        glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, target, 0);
+        glViewport(0, 0, size, size);
+        glUseProgram(draw_shader.native_handle());
+        texture.bind(draw_shader, 0, 1);
+        glDrawArrays(GL_TRIANGLES, 0, 3);
+        std::vector<ogf::Uint8> drawn(size * size * 4);
+        glReadPixels(0, 0, size, size, GL_RGBA, GL_UNSIGNED_BYTE, drawn.data());
+        glBindFramebuffer(GL_FRAMEBUFFER, 0);
+        glDeleteFramebuffers(1, &framebuffer);
+        glDeleteTextures(1, &target);
+        glUseProgram(0);
+        for(unsigned int y = 0; y < size; ++y) {
+            ASSERT_EQ(std::memcmp(drawn.data() + y * size * 4, pixels + y * image.stride(), size * 4), 0)
+                    << "row " << y;
+        }
+    }
+    glBindVertexArray(0);
+    glDeleteVertexArrays(1, &vertex_array);
+}
@@ -0,0 +1,30 @@
+#include <gtest/gtest.h>
+
+#include <set>
+#include <string>
+#include <vector>
+
+#include <ogf/utils/hash.hxx>
+
+TEST(hash, depends_on_content_seed_and_size) {
+    const std::string text{"The quick brown fox jumps over the lazy dog, then naps in the sun."};
+    const auto hash = ogf::hash_bytes(text.data(), text.size());
+    ASSERT_EQ(hash, ogf::hash_bytes(std::string{text}.data(), text.size()));
+    ASSERT_NE(hash, ogf::hash_bytes(text.data(), text.size(), 1));
+    ASSERT_NE(hash, ogf::hash_bytes(text.data(), text.size() - 1));
+    auto changed = text;
+    changed[40] ^= 1;
+    ASSERT_NE(hash, ogf::hash_bytes(changed.data(), changed.size()));
+}
+
+TEST(hash, single_bit_flips_give_distinct_hashes) {
+    std::vector<unsigned char> data(100, 0);
+    std::set<ogf::Uint64> hashes{};
+    hashes.insert(ogf::hash_bytes(data.data(), data.size()));
+    for(std::size_t bit = 0; bit < data.size() * 8; ++bit) {
+        data[bit / 8] ^= static_cast<unsigned char>(1 << bit % 8);
+        hashes.insert(ogf::hash_bytes(data.data(), data.size()));
+        data[bit / 8] ^= static_cast<unsigned char>(1 << bit % 8);
+    }
+    ASSERT_EQ(hashes.size(), data.size() * 8 + 1);
+}
@@ -7,3 +7,11 @@ TEST(io_utils, get_file_extension) {
     const auto result = ogf::get_file_extension(input);
     ASSERT_EQ(result, "ext");
 }
+
+TEST(io_utils, has_file_extension_ignores_case) {
+    ASSERT_TRUE(ogf::has_file_extension("textures/stone.DDS", "dds"));
+    ASSERT_TRUE(ogf::has_file_extension("stone.Ktx2", "ktx2"));
+    ASSERT_FALSE(ogf::has_file_extension("stone.dds.png", "dds"));
+    ASSERT_FALSE(ogf::has_file_extension("dds", "dds"));
+    ASSERT_FALSE(ogf::has_file_extension("stone.ktx", "ktx2"));
+}
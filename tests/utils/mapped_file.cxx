@@ -0,0 +1,24 @@
+#include <gtest/gtest.h>
+
+#include <fstream>
+#include <stdexcept>
+#include <string>
+
+#include <ogf/utils/mapped_file.hxx>
+
+TEST(mapped_file, maps_file_contents) {
+    const auto filename = testing::TempDir() + "mapped_file.txt";
+    const std::string content{"some funny content"};
+    std::ofstream{filename, std::ios::binary} << content;
+    ogf::MappedFile file{};
+    file.open(filename);
+    ASSERT_EQ(file.size(), content.size());
+    ASSERT_EQ(std::string(reinterpret_cast<const char*>(file.data()), file.size()), content);
+    file.close();
+    ASSERT_EQ(file.data(), nullptr);
+}
+
+TEST(mapped_file, throws_on_missing_file) {
+    ogf::MappedFile file{};
+    ASSERT_THROW(file.open("/some/funny/missing/file"), std::runtime_error);
+}
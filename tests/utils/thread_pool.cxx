@@ -0,0 +1,49 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+
+#include <ogf/utils/thread_pool.hxx>
+
+TEST(thread_pool, runs_all_tasks) {
+    ogf::ThreadPool pool{4};
+    std::atomic<int> counter{0};
+    std::vector<std::future<void>> futures{};
+    for(int i = 0; i < 100; ++i) {
+        futures.push_back(pool.submit([&counter]() { ++counter; }));
+    }
+    for(auto& future : futures) {
+        future.get();
+    }
+    ASSERT_EQ(counter.load(), 100);
+}
+
+TEST(thread_pool, returns_task_result) {
+    ogf::ThreadPool pool{2};
+    auto future = pool.submit([]() { return 42; });
+    ASSERT_EQ(future.get(), 42);
+}
+
+TEST(thread_pool, propagates_exceptions) {
+    ogf::ThreadPool pool{1};
+    auto future = pool.submit([]() -> int { throw std::runtime_error{"failure"}; });
+    ASSERT_THROW(future.get(), std::runtime_error);
+}
+
+TEST(thread_pool, parallel_for_visits_every_index) {
+    std::vector<int> visits(1000, 0);
+    ogf::parallel_for(visits.size(), [&visits](const std::size_t index) { ++visits[index]; });
+    for(const auto visit : visits) {
+        ASSERT_EQ(visit, 1);
+    }
+}
+
+TEST(thread_pool, parallel_for_nested_in_pool_task) {
+    std::atomic<int> counter{0};
+    auto future = ogf::default_thread_pool().submit([&counter]() {
+        ogf::parallel_for(64, [&counter](const std::size_t) { ++counter; });
+    });
+    future.get();
+    ASSERT_EQ(counter.load(), 64);
+}